@@ -0,0 +1,163 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/dom/NodeVisitor.h>
+#include <mxml/dom/Score.h>
+#include <mxml/geometry/PageScoreGeometry.h>
+#include <mxml/geometry/ScrollScoreGeometry.h>
+#include <mxml/parsing/ParserContext.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mxml;
+
+namespace {
+
+/// Node dispatch the way the layout loops did it before node kinds
+std::size_t dispatchWithRTTI(const dom::Measure& measure) {
+    std::size_t count = 0;
+    for (auto& node : measure.nodes()) {
+        if (dynamic_cast<const dom::Attributes*>(node.get()))
+            count += 1;
+        else if (dynamic_cast<const dom::Barline*>(node.get()))
+            count += 2;
+        else if (dynamic_cast<const dom::Direction*>(node.get()))
+            count += 3;
+        else if (auto timedNode = dynamic_cast<const dom::TimedNode*>(node.get())) {
+            if (dynamic_cast<const dom::Chord*>(timedNode))
+                count += 4;
+            else if (dynamic_cast<const dom::Note*>(timedNode))
+                count += 5;
+            else if (dynamic_cast<const dom::Forward*>(timedNode) || dynamic_cast<const dom::Backup*>(timedNode))
+                count += 6;
+        }
+    }
+    return count;
+}
+
+struct CountingVisitor {
+    std::size_t count;
+
+    void operator()(const dom::Attributes&) { count += 1; }
+    void operator()(const dom::Barline&) { count += 2; }
+    void operator()(const dom::Direction&) { count += 3; }
+    void operator()(const dom::Chord&) { count += 4; }
+    void operator()(const dom::Note&) { count += 5; }
+    void operator()(const dom::Forward&) { count += 6; }
+    void operator()(const dom::Backup&) { count += 6; }
+    void operator()(const dom::Node&) {}
+};
+
+std::size_t dispatchWithKind(const dom::Measure& measure) {
+    CountingVisitor visitor{0};
+    for (auto& node : measure.nodes())
+        dom::visit(*node, visitor);
+    return visitor.count;
+}
+
+template <typename F>
+std::size_t dispatchAll(const std::vector<std::unique_ptr<dom::Score>>& scores, F f) {
+    std::size_t count = 0;
+    for (auto& score : scores) {
+        for (auto& part : score->parts()) {
+            for (auto& measure : part->measures())
+                count += f(*measure);
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+/**
+ Measures full layout time of large scores, along with the cost of node dispatch by RTTI compared to node kinds.
+
+ Usage: mxml_layout_benchmark [-n repeats] file.xml...
+ */
+int main(int argc, char** argv) {
+    std::size_t repeats = 10;
+    std::vector<std::string> fileNames;
+    for (int i = 1; i < argc; i += 1) {
+        if (std::string(argv[i]) == "-n" && i + 1 < argc) {
+            repeats = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            fileNames.push_back(argv[i]);
+        }
+    }
+    if (fileNames.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [-n repeats] file.xml..." << std::endl;
+        return 1;
+    }
+
+    // Parse up front so that only layout is measured
+    parsing::ParserContext context;
+    std::vector<std::unique_ptr<dom::Score>> scores;
+    for (auto& fileName : fileNames) {
+        try {
+            scores.push_back(context.parseFile(fileName));
+        } catch (const std::exception& e) {
+            std::cerr << "Could not parse " << fileName << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    std::size_t checksum = 0;
+
+    auto start = Clock::now();
+    for (std::size_t r = 0; r < repeats; r += 1) {
+        for (auto& score : scores) {
+            ScrollScoreGeometry geometry(*score);
+            checksum += geometry.partGeometries().size();
+        }
+    }
+    const std::chrono::duration<double> scrollTime = Clock::now() - start;
+
+    start = Clock::now();
+    for (std::size_t r = 0; r < repeats; r += 1) {
+        for (auto& score : scores) {
+            ScrollScoreGeometry geometry(*score, true, 1);
+            checksum += geometry.partGeometries().size();
+        }
+    }
+    const std::chrono::duration<double> serialScrollTime = Clock::now() - start;
+
+    start = Clock::now();
+    for (std::size_t r = 0; r < repeats; r += 1) {
+        for (auto& score : scores) {
+            PageScoreGeometry geometry(*score, 1024);
+            checksum += geometry.systemGeometries().size();
+        }
+    }
+    const std::chrono::duration<double> pageTime = Clock::now() - start;
+
+    // Node dispatch on its own is too quick to time once per layout, so walk the scores many more times
+    const std::size_t dispatchRepeats = repeats * 1000;
+    start = Clock::now();
+    for (std::size_t r = 0; r < dispatchRepeats; r += 1)
+        checksum += dispatchAll(scores, dispatchWithRTTI);
+    const std::chrono::duration<double> rttiTime = Clock::now() - start;
+
+    start = Clock::now();
+    for (std::size_t r = 0; r < dispatchRepeats; r += 1)
+        checksum += dispatchAll(scores, dispatchWithKind);
+    const std::chrono::duration<double> kindTime = Clock::now() - start;
+
+    const auto layouts = static_cast<double>(scores.size() * repeats);
+    std::cout << "scores:        " << scores.size() << " x " << repeats << " (" << checksum << ")" << std::endl;
+    std::cout << "scroll layout: " << 1000 * scrollTime.count() / layouts << " ms/score" << std::endl;
+    std::cout << "  one thread:  " << 1000 * serialScrollTime.count() / layouts << " ms/score" << std::endl;
+    std::cout << "page layout:   " << 1000 * pageTime.count() / layouts << " ms/score" << std::endl;
+    std::cout << "rtti dispatch: " << 1000 * rttiTime.count() / dispatchRepeats << " ms/pass" << std::endl;
+    std::cout << "kind dispatch: " << 1000 * kindTime.count() / dispatchRepeats << " ms/pass" << std::endl;
+    std::cout << "speedup:       " << rttiTime.count() / kindTime.count() << "x" << std::endl;
+    return 0;
+}
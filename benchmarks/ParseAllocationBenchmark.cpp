@@ -0,0 +1,144 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <lxml/lxml.h>
+#include <mxml/dom/Score.h>
+#include <mxml/parsing/ParserContext.h>
+#include <mxml/parsing/ScoreHandler.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace mxml;
+using namespace mxml::parsing;
+
+namespace {
+
+std::atomic<std::size_t> allocationCount(0);
+std::atomic<std::size_t> deallocationCount(0);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocationCount += 1;
+    if (auto pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer)
+        deallocationCount += 1;
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    if (pointer)
+        deallocationCount += 1;
+    std::free(pointer);
+}
+
+namespace {
+
+struct Counts {
+    std::size_t allocations = 0;
+    std::size_t retained = 0;
+};
+
+/// Count the allocations made while parsing a document and how many of them are still owned by the returned score
+template <typename Function>
+void count(Counts& counts, Function function) {
+    const auto allocations = allocationCount.load();
+    const auto deallocations = deallocationCount.load();
+    std::unique_ptr<dom::Score> score = function();
+    const auto allocated = allocationCount.load() - allocations;
+    counts.allocations += allocated;
+    counts.retained += allocated - (deallocationCount.load() - deallocations);
+}
+
+template <typename Function>
+void report(const char* name, std::size_t documentCount, Function function) {
+    Counts counts;
+    const auto start = std::chrono::steady_clock::now();
+    function(counts);
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << ": " << static_cast<double>(counts.allocations) / documentCount << " allocations/document, "
+        << static_cast<double>(counts.retained) / documentCount << " owned by the score, "
+        << documentCount / time.count() << " documents/sec" << std::endl;
+}
+
+} // namespace
+
+/**
+ Parses a corpus several times and reports heap allocations per document, for a new `ScoreHandler` per document and for
+ a reused `ParserContext`. Allocations that are still alive when the parse returns belong to the score, the rest are
+ temporary buffers of the parser and the handlers.
+
+ Usage: mxml_parse_benchmark [-n repeats] tests/resources/*.xml
+ */
+int main(int argc, char** argv) {
+    std::size_t repeats = 10;
+    std::vector<std::string> fileNames;
+    for (int i = 1; i < argc; i += 1) {
+        if (std::string(argv[i]) == "-n" && i + 1 < argc) {
+            repeats = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            fileNames.push_back(argv[i]);
+        }
+    }
+    if (fileNames.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [-n repeats] file.xml..." << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> documents;
+    for (auto& fileName : fileNames) {
+        std::ifstream is(fileName);
+        if (!is) {
+            std::cerr << "Could not open " << fileName << std::endl;
+            return 1;
+        }
+        documents.emplace_back(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+    const auto documentCount = documents.size() * repeats;
+
+    report("new handler", documentCount, [&](Counts& counts) {
+        for (std::size_t r = 0; r < repeats; r += 1) {
+            for (std::size_t i = 0; i < documents.size(); i += 1) {
+                count(counts, [&]() {
+                    std::istringstream is(documents[i]);
+                    ScoreHandler handler;
+                    lxml::parse(is, fileNames[i], handler);
+                    return handler.result();
+                });
+            }
+        }
+    });
+
+    ParserContext context;
+    report("reused context", documentCount, [&](Counts& counts) {
+        for (std::size_t r = 0; r < repeats; r += 1) {
+            for (std::size_t i = 0; i < documents.size(); i += 1) {
+                count(counts, [&]() {
+                    context.reset();
+                    return context.parse(StringView(documents[i]), fileNames[i]);
+                });
+            }
+        }
+    });
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <lxml/lxml.h>
+#include <mxml/parsing/ScoreHandler.h>
+#include <mxml/parsing/ScoreProbe.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace mxml;
+using namespace mxml::parsing;
+
+/**
+ Measures corpus throughput of `ScoreProbe` against a full parse.
+
+ Usage: mxml_probe_benchmark [-n repeats] file.xml...
+ */
+int main(int argc, char** argv) {
+    std::size_t repeats = 10;
+    std::vector<std::string> fileNames;
+    for (int i = 1; i < argc; i += 1) {
+        if (std::string(argv[i]) == "-n" && i + 1 < argc) {
+            repeats = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            fileNames.push_back(argv[i]);
+        }
+    }
+    if (fileNames.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [-n repeats] file.xml..." << std::endl;
+        return 1;
+    }
+
+    // Load the corpus up front so that only parsing is measured
+    std::vector<std::string> documents;
+    for (auto& fileName : fileNames) {
+        std::ifstream is(fileName);
+        if (!is) {
+            std::cerr << "Could not open " << fileName << std::endl;
+            return 1;
+        }
+        documents.emplace_back(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto fileCount = documents.size() * repeats;
+    std::size_t measureCount = 0;
+
+    auto start = Clock::now();
+    for (std::size_t r = 0; r < repeats; r += 1) {
+        for (auto& document : documents)
+            measureCount += ScoreProbe::probe(StringView(document)).measureCount;
+    }
+    const std::chrono::duration<double> probeTime = Clock::now() - start;
+
+    start = Clock::now();
+    for (std::size_t r = 0; r < repeats; r += 1) {
+        for (std::size_t i = 0; i < documents.size(); i += 1) {
+            std::istringstream is(documents[i]);
+            ScoreHandler handler;
+            lxml::parse(is, fileNames[i], handler);
+            measureCount += handler.result()->parts().empty() ? 0 : 1;
+        }
+    }
+    const std::chrono::duration<double> parseTime = Clock::now() - start;
+
+    std::cout << "files:      " << fileCount << " (" << measureCount << ")" << std::endl;
+    std::cout << "probe:      " << fileCount / probeTime.count() << " files/sec" << std::endl;
+    std::cout << "full parse: " << fileCount / parseTime.count() << " files/sec" << std::endl;
+    std::cout << "speedup:    " << parseTime.count() / probeTime.count() << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BatchParser.h"
+#include "Parallel.h"
+
+#include <mxml/dom/InvalidDataError.h>
+#include <mxml/parsing/ParserContext.h>
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+
+namespace mxml {
+
+BatchParser::BatchParser() : BatchParser(Options()) {}
+
+BatchParser::BatchParser(const Options& options) : _options(options), _inputs(), _peakMemory(0) {}
+
+void BatchParser::addFile(const std::string& path) {
+    _inputs.push_back(Input{path, true, parsing::StringView()});
+}
+
+void BatchParser::addBuffer(const std::string& name, parsing::StringView buffer) {
+    _inputs.push_back(Input{name, false, buffer});
+}
+
+std::size_t BatchParser::inputSize(const Input& input) const {
+    if (!input.file)
+        return input.buffer.size();
+
+    std::ifstream file(input.name, std::ios::binary | std::ios::ate);
+    if (!file)
+        return 0;
+    return static_cast<std::size_t>(file.tellg());
+}
+
+void BatchParser::run(const Callback& callback) {
+    struct Pending {
+        Result result;
+        std::size_t cost;
+    };
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Pending> completed;
+    std::size_t next = 0;
+    std::size_t memory = 0;
+    bool cancelled = false;
+
+    const auto count = _inputs.size();
+    const auto threads = _options.threads == 0 ? workerCount(count) : std::max<std::size_t>(1, std::min(count, _options.threads));
+    const auto maxPending = _options.maxPendingResults == 0 ? threads : _options.maxPendingResults;
+    _peakMemory = 0;
+
+    auto worker = [&]() {
+        parsing::ParserContext context(_options.profile);
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (cancelled || next >= count)
+                return;
+            const auto index = next++;
+            lock.unlock();
+
+            auto& input = _inputs[index];
+            const auto cost = inputSize(input) * _options.expansionFactor;
+
+            // A document that exceeds the budget on its own is parsed once nothing else is in flight
+            lock.lock();
+            condition.wait(lock, [&]() {
+                if (cancelled)
+                    return true;
+                if (completed.size() >= maxPending)
+                    return false;
+                return _options.memoryBudget == 0 || memory == 0 || memory + cost <= _options.memoryBudget;
+            });
+            if (cancelled)
+                return;
+            memory += cost;
+            _peakMemory = std::max(_peakMemory, memory);
+            lock.unlock();
+
+            Pending pending{Result{index, input.name, nullptr, nullptr, nullptr}, cost};
+            try {
+                context.reset();
+                if (input.file)
+                    pending.result.score = context.parseFile(input.name);
+                else
+                    pending.result.score = context.parse(input.buffer, input.name);
+                if (!pending.result.score)
+                    throw dom::InvalidDataError("Not a MusicXML score: " + input.name);
+                pending.result.properties.reset(new ScoreProperties(*pending.result.score, _options.layoutType));
+            } catch (...) {
+                pending.result.score.reset();
+                pending.result.properties.reset();
+                pending.result.error = std::current_exception();
+            }
+
+            lock.lock();
+            completed.push_back(std::move(pending));
+            condition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; i += 1)
+        workers.emplace_back(worker);
+
+    std::exception_ptr exception;
+    for (std::size_t delivered = 0; delivered < count; delivered += 1) {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return !completed.empty(); });
+        auto pending = std::move(completed.front());
+        completed.pop_front();
+        lock.unlock();
+
+        try {
+            callback(pending.result);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        // Free the result before releasing its memory
+        pending.result.properties.reset();
+        pending.result.score.reset();
+
+        lock.lock();
+        memory -= pending.cost;
+        if (exception)
+            cancelled = true;
+        condition.notify_all();
+        if (cancelled)
+            break;
+    }
+
+    for (auto& thread : workers)
+        thread.join();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+} // namespace mxml
@@ -0,0 +1,116 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "ScoreProperties.h"
+
+#include <mxml/dom/Score.h>
+#include <mxml/parsing/ParseProfile.h>
+#include <mxml/parsing/StringView.h>
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Parses a batch of MusicXML documents concurrently into `dom::Score`s and their `ScoreProperties`.
+
+ Documents are parsed on a fixed number of worker threads, each with its own `parsing::ParserContext`. Results are
+ handed to a callback on the thread that called `run()`, in the order in which they complete, so the callback itself
+ does not need to be thread safe. Workers stop taking new documents while too many results are waiting for the
+ callback, and while the estimated memory of the documents in flight would exceed the memory budget.
+
+ Thread safety in mxml: a `dom::Score`, and the `ScoreProperties` built from it, are not modified after construction
+ and may be read from any number of threads. Handlers, `parsing::ParserContext`, `EventFactory` and the geometry
+ factories keep state while working and must be used from one thread at a time; create one per thread instead.
+ */
+class BatchParser {
+public:
+    struct Options {
+        /// The number of worker threads, 0 means one per hardware thread
+        std::size_t threads = 0;
+
+        /// The number of parsed documents that may wait for the callback, 0 means the same as the number of threads
+        std::size_t maxPendingResults = 0;
+
+        /// The estimated memory that documents being parsed or waiting for the callback may use, 0 means unlimited
+        std::size_t memoryBudget = 0;
+
+        /// Estimated bytes of memory used per byte of input while a document is parsed and held
+        std::size_t expansionFactor = 16;
+
+        ScoreProperties::LayoutType layoutType = ScoreProperties::LayoutType::Scroll;
+        parsing::ParseProfile profile;
+    };
+
+    struct Result {
+        /// The index of the document in the order it was added
+        std::size_t index;
+        std::string name;
+
+        std::unique_ptr<dom::Score> score;
+        std::unique_ptr<ScoreProperties> properties;
+
+        /// Set if the document could not be read or parsed, in which case `score` and `properties` are null
+        std::exception_ptr error;
+    };
+
+    using Callback = std::function<void(Result& result)>;
+
+public:
+    BatchParser();
+    explicit BatchParser(const Options& options);
+
+    const Options& options() const {
+        return _options;
+    }
+
+    void addFile(const std::string& path);
+
+    /**
+     Add an in-memory document. The buffer is not copied and has to remain valid until `run()` returns.
+     */
+    void addBuffer(const std::string& name, parsing::StringView buffer);
+
+    std::size_t size() const {
+        return _inputs.size();
+    }
+
+    /**
+     Parse every document and invoke `callback` once for each, then return. The memory budget counts a result until
+     the callback returns; results moved out by the callback are no longer counted. If the callback throws, workers
+     finish their current document and the exception is rethrown.
+     */
+    void run(const Callback& callback);
+
+    /**
+     The largest estimated memory that was in flight during the last `run()`.
+     */
+    std::size_t peakMemory() const {
+        return _peakMemory;
+    }
+
+private:
+    struct Input {
+        std::string name;
+        bool file;
+        parsing::StringView buffer;
+    };
+
+    std::size_t inputSize(const Input& input) const;
+
+private:
+    Options _options;
+    std::vector<Input> _inputs;
+    std::size_t _peakMemory;
+};
+
+} // namespace mxml
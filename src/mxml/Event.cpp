@@ -6,14 +6,19 @@
 
 #include "Event.h"
 
+#include <algorithm>
+
 namespace mxml {
 
+const std::size_t NoteSpan::kNoEvent;
+
 Event::Event(const dom::Score& score)
 : _score(&score),
   _measureIndex(),
   _measureTime(),
   _absoluteTime(),
-  _beatMark()
+  _beatMark(),
+  _maxDuration()
 {}
 
 Event::Event(const dom::Score& score, std::size_t measureIndex, dom::time_t measureTime, dom::time_t absoluteTime)
@@ -21,16 +26,32 @@ Event::Event(const dom::Score& score, std::size_t measureIndex, dom::time_t meas
   _measureIndex(measureIndex),
   _measureTime(measureTime),
   _absoluteTime(absoluteTime),
-  _beatMark()
+  _beatMark(),
+  _maxDuration()
 {}
 
-dom::time_t Event::maxDuration() const {
-    auto it = std::max_element(_onNotes.begin(), _onNotes.end(), [](const dom::Note* n1, const dom::Note* n2) {
-        return n1->duration() < n2->duration();
-    });
-    if (it == _onNotes.end())
-        return 0;
-    return (*it)->duration();
+void Event::addOnNote(const dom::Note& note) {
+    addOnNote(note, NoteSpan{note.duration(), NoteSpan::kNoEvent});
+}
+
+void Event::addOnNote(const dom::Note& note, const NoteSpan& span) {
+    _onNotes.push_back(&note);
+    _onNoteSpans.push_back(span);
+    _maxDuration = std::max(_maxDuration, span.duration);
+}
+
+void Event::setOnNoteSpan(std::size_t index, const NoteSpan& span) {
+    _onNoteSpans.at(index) = span;
+
+    _maxDuration = 0;
+    for (auto& onNoteSpan : _onNoteSpans)
+        _maxDuration = std::max(_maxDuration, onNoteSpan.duration);
+}
+
+void Event::addNotes(const Event& event) {
+    for (std::size_t index = 0; index < event._onNotes.size(); index += 1)
+        addOnNote(*event._onNotes[index], event._onNoteSpans[index]);
+    _offNotes.insert(_offNotes.end(), event._offNotes.begin(), event._offNotes.end());
 }
 
 } // namespace mxml
@@ -25,6 +25,20 @@ struct MeasureLocation {
     }
 };
 
+/**
+ The sounding extent of an on-note, including the notes tied to it.
+ */
+struct NoteSpan {
+    /// Value of `offEventIndex` when the tie chain doesn't end within the event sequence
+    static const std::size_t kNoEvent = static_cast<std::size_t>(-1);
+
+    /// The duration of the whole tie chain, in divisions
+    dom::time_t duration;
+
+    /// The index in the event sequence of the event with the off-note that ends the tie chain
+    std::size_t offEventIndex;
+};
+
 class Event {
 public:
     Event() = default;
@@ -88,14 +102,25 @@ public:
         _wallTimeDuration = duration;
     }
 
-    dom::time_t maxDuration() const;
+    /**
+     Get the longest sounding duration of the notes starting at this event, tied notes included.
+     */
+    dom::time_t maxDuration() const {
+        return _maxDuration;
+    }
 
     const std::vector<const dom::Note*>& onNotes() const {
         return _onNotes;
     }
-    std::vector<const dom::Note*>& onNotes() {
-        return _onNotes;
+
+    /**
+     Get the sounding span of every on-note, in the same order as `onNotes()`.
+     */
+    const std::vector<NoteSpan>& onNoteSpans() const {
+        return _onNoteSpans;
     }
+    void setOnNoteSpan(std::size_t index, const NoteSpan& span);
+
     const std::vector<const dom::Note*>& offNotes() const {
         return _offNotes;
     }
@@ -103,29 +128,35 @@ public:
         return _offNotes;
     }
     
-    void addOnNote(const dom::Note& note) {
-        _onNotes.push_back(&note);
-    }
+    void addOnNote(const dom::Note& note);
+    void addOnNote(const dom::Note& note, const NoteSpan& span);
     void addOffNote(const dom::Note& note) {
         _offNotes.push_back(&note);
     }
+
+    /**
+     Append the on-notes and off-notes of another event at the same time.
+     */
+    void addNotes(const Event& event);
     
     bool operator<(const Event& rhs) const {
         return _absoluteTime < rhs._absoluteTime;
     }
     
 private:
-    const dom::Score* _score;
+    const dom::Score* _score = nullptr;
 
-    std::size_t _measureIndex;
-    dom::time_t _measureTime;
-    dom::time_t _absoluteTime;
-    bool _beatMark;
+    std::size_t _measureIndex = 0;
+    dom::time_t _measureTime = 0;
+    dom::time_t _absoluteTime = 0;
+    bool _beatMark = false;
 
-    double _wallTime;
-    double _wallTimeDuration;
+    double _wallTime = 0;
+    double _wallTimeDuration = 0;
+    dom::time_t _maxDuration = 0;
     
     std::vector<const dom::Note*> _onNotes;
+    std::vector<NoteSpan> _onNoteSpans;
     std::vector<const dom::Note*> _offNotes;
 };
 
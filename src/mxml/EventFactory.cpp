@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "EventFactory.h"
+#include "Parallel.h"
 
 #include <mxml/dom/Backup.h>
 #include <mxml/dom/Barline.h>
@@ -15,6 +16,9 @@
 #include <mxml/dom/TimedNode.h>
 #include <mxml/dom/Types.h>
 
+#include <functional>
+#include <queue>
+
 namespace mxml {
 
 using namespace dom;
@@ -23,7 +27,9 @@ EventFactory::EventFactory(const dom::Score& score, const ScoreProperties& score
 : _score(score),
   _scoreProperties(scoreProperties),
   _startTime(),
-  _time(0)
+  _time(0),
+  _prepared(false),
+  _concurrent(false)
 {}
 
 std::unique_ptr<EventSequence> EventFactory::build() {
@@ -31,30 +37,212 @@ std::unique_ptr<EventSequence> EventFactory::build() {
 }
 
 std::unique_ptr<EventSequence> EventFactory::build(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex) {
-    _startTime = startTime;
+    if (_concurrent) {
+        auto partSequences = buildPartSequences(startTime, startMeasureIndex, endMeasureIndex);
+
+        std::vector<const EventSequence*> sequences;
+        for (auto& sequence : partSequences)
+            sequences.push_back(sequence.get());
+        return merge(sequences);
+    }
+
+    reset(startTime, startMeasureIndex, endMeasureIndex);
+    process();
+    _prepared = startMeasureIndex == 0 && endMeasureIndex == _score.parts().at(0)->measures().size();
+
+    _playbackOrder = _scoreProperties.playbackOrder(startMeasureIndex, endMeasureIndex);
+    auto eventSequence = unroll();
+    eventSequence->setTempoMap(buildTempoMap());
+    fillWallTimes(*eventSequence);
+
+    return eventSequence;
+}
+
+std::unique_ptr<EventSequence> EventFactory::slice(std::size_t startMeasureIndex, std::size_t endMeasureIndex) {
+    if (!_prepared) {
+        reset(0, 0, _score.parts().at(0)->measures().size());
+        process();
+        _prepared = true;
+    }
+
+    // The events and measure extents don't depend on the range, only the measures that are laid out do
+    _startTime = 0;
     _startMeasureIndex = startMeasureIndex;
     _endMeasureIndex = endMeasureIndex;
+    _playbackOrder = _scoreProperties.playbackOrder(startMeasureIndex, endMeasureIndex);
+
+    auto eventSequence = unroll();
+    eventSequence->setTempoMap(buildTempoMap());
+    fillWallTimes(*eventSequence);
+
+    return eventSequence;
+}
+
+std::vector<std::unique_ptr<EventSequence>> EventFactory::buildParts() {
+    return buildParts(0, 0, _score.parts().at(0)->measures().size());
+}
+
+std::vector<std::unique_ptr<EventSequence>> EventFactory::buildParts(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex) {
+    auto partSequences = buildPartSequences(startTime, startMeasureIndex, endMeasureIndex);
+    parallelFor(partSequences.size(), [&](std::size_t partIndex) {
+        fillWallTimes(*partSequences[partIndex]);
+    });
+    return partSequences;
+}
+
+std::vector<std::unique_ptr<EventSequence>> EventFactory::buildPartSequences(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex) {
+    reset(startTime, startMeasureIndex, endMeasureIndex);
+    _playbackOrder = _scoreProperties.playbackOrder(startMeasureIndex, endMeasureIndex);
+
+    const auto partCount = _score.parts().size();
+    std::vector<std::unique_ptr<EventFactory>> factories;
+    for (std::size_t partIndex = 0; partIndex < partCount; partIndex += 1) {
+        factories.emplace_back(new EventFactory(_score, _scoreProperties));
+        factories.back()->reset(startTime, startMeasureIndex, endMeasureIndex);
+    }
 
-    for (auto& part : _score.parts()) {
-        _part = part.get();
-        _measureStartTime = 0;
-        _time = _startTime;
-        for (std::size_t measureIndex = _startMeasureIndex; measureIndex < _endMeasureIndex; measureIndex += 1) {
-            const Measure& measure = *part->measures().at(measureIndex);
-            processMeasure(measure);
+    parallelFor(partCount, [&](std::size_t partIndex) {
+        auto& factory = *factories[partIndex];
+        factory.processPart(*_score.parts()[partIndex]);
+        factory.computeMeasureExtents();
+    });
+
+    // Measure extents depend on all parts, combine them before placing beat marks and unrolling
+    _measureExtents.assign(_endMeasureIndex + 1, MeasureExtent{0, 0});
+    for (auto& factory : factories) {
+        for (std::size_t measureIndex = 0; measureIndex < _measureExtents.size(); measureIndex += 1) {
+            auto& extent = _measureExtents[measureIndex];
+            auto& partExtent = factory->_measureExtents[measureIndex];
+            extent.lastTime = std::max(extent.lastTime, partExtent.lastTime);
+            extent.length = std::max(extent.length, partExtent.length);
         }
     }
 
-    setBeatMarks();
-    auto eventSequence = unroll();
-    fillWallTimes(*eventSequence);
+    // All parts share the same timeline
+    std::shared_ptr<const TempoMap> tempoMap = buildTempoMap();
+
+    std::vector<std::unique_ptr<EventSequence>> sequences(partCount);
+    parallelFor(partCount, [&](std::size_t partIndex) {
+        auto& factory = *factories[partIndex];
+        factory._measureExtents = _measureExtents;
+        factory._playbackOrder = _playbackOrder;
+        factory.setBeatMarks();
+        sequences[partIndex] = factory.unroll();
+        sequences[partIndex]->setTempoMap(tempoMap);
+    });
+
+    return sequences;
+}
+
+std::unique_ptr<EventSequence> EventFactory::merge(const std::vector<const EventSequence*>& sequences) {
+    auto eventSequence = std::unique_ptr<EventSequence>(new EventSequence(_scoreProperties));
 
+    std::size_t eventCount = 0;
+    for (auto sequence : sequences)
+        eventCount += sequence->events().size();
+    eventSequence->_events.reserve(eventCount);
+
+    // K-way merge on absolute time, ties are broken by sequence index to keep the part order stable
+    using Cursor = std::pair<dom::time_t, std::size_t>;
+    std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
+    std::vector<EventSequence::ConstIterator> positions;
+    for (std::size_t index = 0; index < sequences.size(); index += 1) {
+        positions.push_back(sequences[index]->begin());
+        if (positions[index] != sequences[index]->end())
+            heap.push(std::make_pair(positions[index]->absoluteTime(), index));
+    }
+
+    // Off event indices refer to the source sequences, remember where every event and on-note ends up to remap them
+    struct MergedNote {
+        std::size_t eventIndex;
+        std::size_t noteIndex;
+        std::size_t sequenceIndex;
+    };
+    std::vector<MergedNote> mergedNotes;
+    std::vector<std::vector<std::size_t>> mergedIndices(sequences.size());
+    for (std::size_t index = 0; index < sequences.size(); index += 1)
+        mergedIndices[index].reserve(sequences[index]->events().size());
+
+    auto& events = eventSequence->_events;
+    while (!heap.empty()) {
+        const auto index = heap.top().second;
+        heap.pop();
+
+        auto& event = *positions[index];
+        std::size_t noteOffset = 0;
+        if (!events.empty() && events.back().absoluteTime() == event.absoluteTime()) {
+            auto& existing = events.back();
+
+            // The same instant can be the end of a measure and the start of the next, prefer the later location
+            if (event.measureTime() < existing.measureTime()) {
+                existing.setMeasureIndex(event.measureIndex());
+                existing.setMeasureTime(event.measureTime());
+            }
+            existing.setBeatMark(existing.isBeatMark() || event.isBeatMark());
+            noteOffset = existing.onNotes().size();
+            existing.addNotes(event);
+        } else {
+            events.push_back(event);
+        }
+        mergedIndices[index].push_back(events.size() - 1);
+        for (std::size_t noteIndex = 0; noteIndex < event.onNotes().size(); noteIndex += 1)
+            mergedNotes.push_back(MergedNote{events.size() - 1, noteOffset + noteIndex, index});
+
+        ++positions[index];
+        if (positions[index] != sequences[index]->end())
+            heap.push(std::make_pair(positions[index]->absoluteTime(), index));
+    }
+
+    for (auto& mergedNote : mergedNotes) {
+        auto& event = events[mergedNote.eventIndex];
+        auto span = event.onNoteSpans()[mergedNote.noteIndex];
+        if (span.offEventIndex == NoteSpan::kNoEvent)
+            continue;
+
+        span.offEventIndex = mergedIndices[mergedNote.sequenceIndex][span.offEventIndex];
+        event.setOnNoteSpan(mergedNote.noteIndex, span);
+    }
+
+    if (!sequences.empty() && sequences.front()->_tempoMap)
+        eventSequence->setTempoMap(sequences.front()->_tempoMap);
+    else
+        eventSequence->setTempoMap(buildTempoMap());
+    fillWallTimes(*eventSequence);
     return eventSequence;
 }
 
+void EventFactory::reset(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex) {
+    _startTime = startTime;
+    _startMeasureIndex = startMeasureIndex;
+    _endMeasureIndex = endMeasureIndex;
+    _events.clear();
+    _measureExtents.clear();
+    _playbackOrder.clear();
+    _openTies.clear();
+    _tieChains.clear();
+    _prepared = false;
+}
+
+void EventFactory::process() {
+    for (auto& part : _score.parts())
+        processPart(*part);
+    computeMeasureExtents();
+    setBeatMarks();
+}
+
+void EventFactory::processPart(const dom::Part& part) {
+    _part = &part;
+    _measureStartTime = 0;
+    _time = _startTime;
+    for (std::size_t measureIndex = _startMeasureIndex; measureIndex < _endMeasureIndex; measureIndex += 1) {
+        const Measure& measure = *part.measures().at(measureIndex);
+        processMeasure(measure);
+    }
+}
+
 void EventFactory::processMeasure(const dom::Measure& measure) {
     for (auto& node : measure.nodes()) {
-        if (const TimedNode* timedNode = dynamic_cast<const TimedNode*>(node.get())) {
+        if (const TimedNode* timedNode = nodeCast<TimedNode>(node.get())) {
             processTimedNode(*timedNode);
         }
     }
@@ -66,16 +254,27 @@ void EventFactory::processMeasure(const dom::Measure& measure) {
 }
 
 void EventFactory::processTimedNode(const TimedNode& node) {
-    if (auto chord = dynamic_cast<const Chord*>(&node)) {
-        processChord(*chord);
-        _time += node.duration();
-    } else if (auto note = dynamic_cast<const Note*>(&node)) {
-        addNote(*note);
-        _time += node.duration();
-    } else if (dynamic_cast<const Forward*>(&node)) {
-        _time += node.duration();
-    } else if (dynamic_cast<const Backup*>(&node)) {
-        _time -= node.duration();
+    switch (node.kind()) {
+        case Node::Kind::Chord:
+            processChord(static_cast<const Chord&>(node));
+            _time += node.duration();
+            break;
+
+        case Node::Kind::Note:
+            addNote(static_cast<const Note&>(node));
+            _time += node.duration();
+            break;
+
+        case Node::Kind::Forward:
+            _time += node.duration();
+            break;
+
+        case Node::Kind::Backup:
+            _time -= node.duration();
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -87,15 +286,42 @@ void EventFactory::processChord(const Chord& chord) {
 void EventFactory::addNote(const Note& note) {
     auto measureIndex = note.measure()->index();
 
+    const bool tieStart = isTieStart(note);
+    const bool tieStop = isTieStop(note);
+    if (tieStart || tieStop)
+        addTiedNote(note, tieStart, tieStop);
+
     auto& onEvent = event(measureIndex, note.start(), _time);
-    if (!isTieStop(note))
+    if (!tieStop)
         onEvent.addOnNote(note);
 
     auto& offEvent = event(measureIndex, note.start() + note.duration(), _time + note.duration());
-    if (!isTieStart(note))
+    if (!tieStart)
         offEvent.addOffNote(note);
 }
 
+void EventFactory::addTiedNote(const dom::Note& note, bool tieStart, bool tieStop) {
+    if (!note.pitch)
+        return;
+
+    const auto key = std::make_tuple(_part, note.staff(), note.midiNumber());
+    if (!tieStop) {
+        _tieChains[&note] = TieChain{&note, note.duration()};
+        _openTies[key] = &note;
+        return;
+    }
+
+    auto it = _openTies.find(key);
+    if (it == _openTies.end())
+        return;
+
+    auto& chain = _tieChains[it->second];
+    chain.end = &note;
+    chain.duration += note.duration();
+    if (!tieStart)
+        _openTies.erase(it);
+}
+
 Event& EventFactory::event(std::size_t measureIndex, dom::time_t measureTime, dom::time_t absoluteTime) {
     auto it = _events.find(std::make_pair(measureIndex, measureTime));
     if (it != _events.end())
@@ -109,21 +335,33 @@ Event& EventFactory::event(std::size_t measureIndex, dom::time_t measureTime, do
     return it->second;
 }
 
+void EventFactory::computeMeasureExtents() {
+    _measureExtents.assign(_endMeasureIndex + 1, MeasureExtent{0, 0});
+
+    std::size_t measureIndex = _measureExtents.size();
+    dom::time_t measureDuration = 0;
+    for (auto& pair : _events) {
+        if (pair.first.first >= _measureExtents.size())
+            break;
+        if (pair.first.first != measureIndex) {
+            measureIndex = pair.first.first;
+            measureDuration = _scoreProperties.divisionsPerMeasure(measureIndex);
+        }
+
+        auto time = pair.first.second;
+        auto& extent = _measureExtents[measureIndex];
+        if (time > extent.lastTime)
+            extent.lastTime = time;
+        if (time <= measureDuration && time > extent.length)
+            extent.length = time;
+    }
+}
+
 void EventFactory::setBeatMarks() {
     dom::time_t absoluteTime = 0;
     for (std::size_t measureIndex = _startMeasureIndex; measureIndex < _endMeasureIndex; measureIndex += 1) {
         auto divisionsPerBeat = _scoreProperties.divisionsPerBeat(measureIndex);
-
-        dom::time_t lastTime = 0;
-        auto begin = _events.lower_bound({measureIndex, 0});
-        for (auto it = begin; it != _events.end(); ++it) {
-            auto index = it->first.first;
-            auto time = it->first.second;
-            if (index != measureIndex)
-                break;
-            if (time > lastTime)
-                lastTime = time;
-        }
+        auto lastTime = _measureExtents[measureIndex].lastTime;
 
         for (dom::time_t time = 0; time < lastTime; time += divisionsPerBeat) {
             auto& e = event(measureIndex, time, absoluteTime);
@@ -136,112 +374,106 @@ void EventFactory::setBeatMarks() {
 std::unique_ptr<EventSequence> EventFactory::unroll() {
     auto eventSequence = std::unique_ptr<EventSequence>(new EventSequence(_scoreProperties));
 
-    std::size_t measureIndex = _startMeasureIndex;
     dom::time_t measureStartTime = 0;
-    dom::time_t time = 0;
-
-    std::map<Loop, std::size_t> loopCounts;
-    
-    enum JumpState { kUnencountered, kFlagged, kActive, kPerformed };
-    std::map<Jump, JumpState> jumpStates;
-
-    // Iterate until we equal the measure count for loops
-    // that 'end' past the last measure
-    while (measureIndex <= _endMeasureIndex) {
-        bool skipped = false;
+    for (auto measureIndex : _playbackOrder) {
+        // Loops and jumps can lead out of the range, those measures are not played
+        if (!inRange(measureIndex))
+            continue;
+
+        auto measureDuration = _scoreProperties.divisionsPerMeasure(measureIndex);
+        auto first = _events.lower_bound(std::make_pair(measureIndex, 0));
+        auto second = _events.upper_bound(std::make_pair(measureIndex, measureDuration));
+        for (auto it = first; it != second; ++it) {
+            auto event = it->second;
+            event.setAbsoluteTime(measureStartTime + event.measureTime());
+            eventSequence->addEvent(event);
+        }
 
-        auto prevLoop = _scoreProperties.loop(measureIndex - 1);
-        if (prevLoop && prevLoop->end() == measureIndex) {
-            auto& loopInteration = loopCounts[*prevLoop];
+        measureStartTime += _measureExtents[measureIndex].length;
+    }
 
-            if (loopInteration < prevLoop->count()) {
-                measureIndex = prevLoop->begin();
-                skipped = true;
-            }
+    fillNoteSpans(*eventSequence, measureStartTime);
+    return eventSequence;
+}
 
-            loopInteration += 1;
+void EventFactory::fillNoteSpans(EventSequence& eventSequence, dom::time_t endTime) const {
+    // On-notes waiting for their off event, keyed by the note that ends the chain
+    struct Pending {
+        std::size_t eventIndex;
+        std::size_t noteIndex;
+    };
+    std::multimap<const dom::Note*, Pending> pending;
+
+    auto& events = eventSequence._events;
+    for (std::size_t eventIndex = 0; eventIndex < events.size(); eventIndex += 1) {
+        auto& event = events[eventIndex];
+
+        // Resolve off-notes first, the end of a repeated measure can be the start of the same notes
+        for (auto note : event.offNotes()) {
+            auto it = pending.find(note);
+            if (it == pending.end())
+                continue;
+
+            auto& onEvent = events[it->second.eventIndex];
+            const auto duration = event.absoluteTime() - onEvent.absoluteTime();
+            onEvent.setOnNoteSpan(it->second.noteIndex, NoteSpan{duration, eventIndex});
+            pending.erase(it);
         }
 
-        auto loop = _scoreProperties.loop(measureIndex);
-        if (!skipped && loop) {
-            auto& loopInteration = loopCounts[*loop];
+        for (std::size_t noteIndex = 0; noteIndex < event.onNotes().size(); noteIndex += 1) {
+            auto note = event.onNotes()[noteIndex];
+            NoteSpan span{note->duration(), NoteSpan::kNoEvent};
+            const dom::Note* end = note;
 
-            if (loop->isSkipped(loopInteration, measureIndex)) {
-                measureIndex += 1;
-                skipped = true;
+            auto chain = _tieChains.find(note);
+            if (chain != _tieChains.end()) {
+                end = chain->second.end;
+                span.duration = chain->second.duration;
             }
-        }
 
-        auto jumps = _scoreProperties.jumps(measureIndex);
-        for (auto& jump : jumps) {
-            auto& state = jumpStates[jump];
-            if (jump.forward()) {
-                if (state == kActive) {
-                    measureIndex = jump.to;
-                    skipped = true;
-                    state = kPerformed;
-                } else {
-                    state = kFlagged;
-                }
-            } else if (!jump.forward()) {
-                if (state == kUnencountered) {
-                    measureIndex = jump.to;
-                    skipped = true;
-                    for (auto& pair : jumpStates) {
-                        if (pair.second == kFlagged)
-                            pair.second = kActive;
-                    }
-                }
-                state = kPerformed;
+            if (span.duration == 0) {
+                span.offEventIndex = eventIndex;
+            } else {
+                pending.insert(std::make_pair(end, Pending{eventIndex, noteIndex}));
             }
+            event.setOnNoteSpan(noteIndex, span);
         }
+    }
 
-        if (!skipped) {
-            auto measureDuration = _scoreProperties.divisionsPerMeasure(measureIndex);
-            auto first = _events.lower_bound(std::make_pair(measureIndex, 0));
-            auto second = _events.upper_bound(std::make_pair(measureIndex, measureDuration));
-            for (auto it = first; it != second; ++it) {
-                auto event = it->second;
-                time = measureStartTime + event.measureTime();
-                event.setAbsoluteTime(time);
-                eventSequence->addEvent(event);
-            }
-            
-            measureIndex += 1;
-            if (time > measureStartTime + measureDuration)
-                time = measureStartTime + measureDuration;
-            measureStartTime = time;
+    // Tie chains that continue past the last measure stop sounding at the end of the sequence
+    for (auto& pair : pending) {
+        auto& event = events[pair.second.eventIndex];
+        auto span = event.onNoteSpans()[pair.second.noteIndex];
+        if (event.absoluteTime() + span.duration > endTime) {
+            span.duration = std::max(endTime - event.absoluteTime(), dom::time_t(0));
+            event.setOnNoteSpan(pair.second.noteIndex, span);
         }
     }
+}
 
-    return eventSequence;
+std::unique_ptr<TempoMap> EventFactory::buildTempoMap() const {
+    std::vector<dom::time_t> measureDurations(_measureExtents.size());
+    for (std::size_t measureIndex = 0; measureIndex < _measureExtents.size(); measureIndex += 1) {
+        if (inRange(measureIndex))
+            measureDurations[measureIndex] = _measureExtents[measureIndex].length;
+    }
+    return std::unique_ptr<TempoMap>(new TempoMap(_scoreProperties, _playbackOrder, measureDurations));
 }
 
 void EventFactory::fillWallTimes(EventSequence& eventSequence) {
-    double tempo = 60.0;
-    int divisions = 1;
-    dom::time_t time = _startTime;
-    double wallTime = 0.0;
+    auto& tempoMap = *eventSequence.tempoMap();
+    const auto startWallTime = tempoMap.wallTime(_startTime);
 
     for (auto& event : eventSequence.events()) {
-        divisions = _scoreProperties.divisions(event.measureIndex());
-        tempo = _scoreProperties.tempo(event.measureIndex(), event.measureTime());
-
-        const auto divisionsPerBeat = _scoreProperties.divisionsPerBeat(event.measureIndex());
-        const auto divisionDuration = 60.0 / (divisionsPerBeat * tempo); // In seconds
-
-        wallTime += divisionDuration * static_cast<double>(event.absoluteTime() - time);
-        time = event.absoluteTime();
-
-        event.setWallTime(wallTime);
-        event.setWallTimeDuration(event.maxDuration() * divisionDuration);
+        const auto wallTime = tempoMap.wallTime(event.absoluteTime());
+        event.setWallTime(wallTime - startWallTime);
+        event.setWallTimeDuration(tempoMap.wallTime(event.absoluteTime() + event.maxDuration()) - wallTime);
     }
-
 }
 
 bool EventFactory::isTieStart(const mxml::dom::Note& note) {
     if (note.notations) {
-        const auto& notations = note.notations;
+        auto notations = note.notations.get();
         for (auto& tie : notations->ties) {
             if (tie->type() == mxml::dom::kStart || tie->type() == mxml::dom::kContinue)
                 return true;
@@ -253,7 +485,7 @@ bool EventFactory::isTieStart(const mxml::dom::Note& note) {
 
 bool EventFactory::isTieStop(const mxml::dom::Note& note) {
     if (note.notations) {
-        const auto& notations = note.notations;
+        auto notations = note.notations.get();
         for (auto& tie : notations->ties) {
             if (tie->type() == mxml::dom::kStop || tie->type() == mxml::dom::kContinue)
                 return true;
@@ -7,9 +7,11 @@
 #pragma once
 #include "EventSequence.h"
 #include "ScoreProperties.h"
+#include "TempoMap.h"
 
 #include <map>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 
@@ -27,37 +29,125 @@ class EventFactory {
 public:
     explicit EventFactory(const dom::Score& score, const ScoreProperties& scoreProperties);
 
+    /**
+     Whether to build events one part at a time on separate threads. When enabled `build()` builds a sequence per part
+     concurrently and merges them into the combined sequence. Disabled by default.
+     */
+    bool concurrent() const {
+        return _concurrent;
+    }
+    void setConcurrent(bool concurrent) {
+        _concurrent = concurrent;
+    }
+
     std::unique_ptr<EventSequence> build();
     std::unique_ptr<EventSequence> build(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex);
-    
+
+    /**
+     Build one event sequence per part, indexed by part index. Parts are processed concurrently. Every sequence has the
+     beat marks and the absolute and wall times of the combined sequence, so they can be played back independently or
+     merged with `merge()`.
+     */
+    std::vector<std::unique_ptr<EventSequence>> buildParts();
+    std::vector<std::unique_ptr<EventSequence>> buildParts(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex);
+
+    /**
+     Build the event sequence for a range of measures, as `build(0, startMeasureIndex, endMeasureIndex)` would, from the
+     events of the whole score. The score is processed once, by the first call or by a previous serial `build()` of the
+     whole score, and every later range only lays out the measures in the range in playback order, so changing the range
+     doesn't depend on the size of the score.
+     */
+    std::unique_ptr<EventSequence> slice(std::size_t startMeasureIndex, std::size_t endMeasureIndex);
+
+    /**
+     Merge event sequences produced by `buildParts()`, for instance to mute some parts. Events at the same absolute time
+     are combined, notes are ordered by sequence.
+     */
+    std::unique_ptr<EventSequence> merge(const std::vector<const EventSequence*>& sequences);
+
+private:
+    struct MeasureExtent {
+        /// The time of the last event in the measure
+        dom::time_t lastTime;
+
+        /// The time of the last event in the measure that is within the measure duration
+        dom::time_t length;
+    };
+
+    /**
+     A sequence of tied notes, keyed by the note that starts it.
+     */
+    struct TieChain {
+        const dom::Note* end;
+        dom::time_t duration;
+    };
+
 private:
+    void reset(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex);
+
+    /**
+     Process all parts of the range and place the beat marks, before unrolling.
+     */
+    void process();
+    void processPart(const dom::Part& part);
     void processMeasure(const dom::Measure& measure);
     void processBarline(const dom::Barline& node);
     void processTimedNode(const dom::TimedNode& node);
     void processChord(const dom::Chord& chord);
     void addNote(const dom::Note& note);
 
+    /**
+     Link a note with a tie start or stop to the tie chain it belongs to.
+     */
+    void addTiedNote(const dom::Note& note, bool tieStart, bool tieStop);
+
     /**
      Return the event in the current measure for the given measure time and absolute time, creates a new event if
      necessary.
      */
     Event& event(std::size_t measureIndex, dom::time_t measureTime, dom::time_t absoluteTime);
 
+    /**
+     Compute the extent of every measure from the current events.
+     */
+    void computeMeasureExtents();
+
+    /**
+     Build the events of every part on its own factory and combine the measure extents of all parts.
+     */
+    std::vector<std::unique_ptr<EventSequence>> buildPartSequences(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex);
+
     /**
      Fill in beat mark events for every measure according to the time signature.
      */
     void setBeatMarks();
 
     /**
-     Unroll all loops and jumps to create a linear event sequence.
+     Lay out the events of every measure in playback order to create a linear event sequence.
      */
     std::unique_ptr<EventSequence> unroll();
 
     /**
-     Fill the event wall times in seconds from the tempo values.
+     Set the span of every on-note in the unrolled sequence from the tie chains.
+
+     @param endTime The end of the last unrolled measure, in absolute time
+     */
+    void fillNoteSpans(EventSequence& eventSequence, dom::time_t endTime) const;
+
+    /**
+     Build the tempo map for the unrolled measures.
+     */
+    std::unique_ptr<TempoMap> buildTempoMap() const;
+
+    /**
+     Fill the event wall times in seconds from the sequence's tempo map.
      */
     void fillWallTimes(EventSequence& eventSequence);
 
+    bool inRange(std::size_t measureIndex) const {
+        return measureIndex >= _startMeasureIndex && measureIndex < _endMeasureIndex;
+    }
+
     bool isTieStart(const mxml::dom::Note& note);
     bool isTieStop(const mxml::dom::Note& note);
 
@@ -75,6 +165,17 @@ private:
 
     using MapKeyType = std::pair<std::size_t, dom::time_t>;
     std::map<MapKeyType, Event> _events;
+    std::vector<MeasureExtent> _measureExtents;
+    std::vector<std::size_t> _playbackOrder;
+
+    using TieKeyType = std::tuple<const dom::Part*, int, unsigned int>;
+    std::map<TieKeyType, const dom::Note*> _openTies;
+    std::map<const dom::Note*, TieChain> _tieChains;
+
+    /// Whether the events of every measure of the score are available for slicing
+    bool _prepared;
+
+    bool _concurrent;
 };
 
 } // namespace mxml
@@ -24,8 +24,7 @@ Event& EventSequence::addEvent(const Event& event) {
         oldEvent.setMeasureIndex(event.measureIndex());
         oldEvent.setMeasureTime(event.measureTime());
         oldEvent.setBeatMark(oldEvent.isBeatMark() || event.isBeatMark());
-        oldEvent.onNotes().insert(oldEvent.onNotes().end(), event.onNotes().begin(), event.onNotes().end());
-        oldEvent.offNotes().insert(oldEvent.offNotes().end(), event.offNotes().begin(), event.offNotes().end());
+        oldEvent.addNotes(event);
 
         return oldEvent;
     } else {
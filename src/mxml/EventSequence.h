@@ -6,9 +6,11 @@
 
 #pragma once
 #include "Event.h"
+#include "TempoMap.h"
 #include <mxml/dom/Sound.h>
 #include <mxml/ScoreProperties.h>
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -29,6 +31,17 @@ public:
         return _scoreProperties;
     }
 
+    /**
+     Get the tempo map used to compute the event wall times, for conversions between wall time, absolute time and
+     measure locations. May be null if the sequence was not built by an `EventFactory`.
+     */
+    const TempoMap* tempoMap() const {
+        return _tempoMap.get();
+    }
+    void setTempoMap(std::shared_ptr<const TempoMap> tempoMap) {
+        _tempoMap = std::move(tempoMap);
+    }
+
     /**
      Get the start time of the event sequence, in abosulte time.
      */
@@ -89,6 +102,7 @@ public:
 private:
     const ScoreProperties& _scoreProperties;
     std::vector<Event> _events;
+    std::shared_ptr<const TempoMap> _tempoMap;
 
     friend class EventFactory;
 };
@@ -19,7 +19,7 @@ std::vector<Jump> JumpFactory::build() {
         std::size_t measureIndex = 0;
         for (auto& measure : part->measures()) {
             for (auto& node : measure->nodes()) {
-                if (auto direction = dynamic_cast<const dom::Direction*>(node.get())) {
+                if (auto direction = dom::nodeCast<dom::Direction>(node.get())) {
                     process(measureIndex, *direction);
                 }
             }
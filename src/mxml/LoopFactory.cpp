@@ -25,7 +25,7 @@ std::vector<Loop> LoopFactory::build() {
         for (auto& measure : part->measures()) {
             assert(measure->index() == measureIndex);
             for (auto& node : measure->nodes()) {
-                if (const dom::Barline* barline = dynamic_cast<const dom::Barline*>(node.get()))
+                if (const dom::Barline* barline = dom::nodeCast<dom::Barline>(node.get()))
                     process(measureIndex, *barline);
             }
             measureIndex += 1;
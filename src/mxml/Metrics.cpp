@@ -16,35 +16,8 @@ const std::size_t Metrics::kStaffLineCount = 5;
 Metrics::Metrics(const dom::Score& score, const ScoreProperties& scoreProperties, std::size_t partIndex)
 : _score(score),
   _scoreProperties(scoreProperties),
-  _prints(),
-  _systemCount(0),
-  _pageCount(0),
   _partIndex(partIndex)
 {
-    auto& part = score.parts().at(partIndex);
-    for (auto& measure : part->measures())
-        process(*measure);
-}
-
-void Metrics::process(const dom::Measure& measure) {
-    auto measureIndex = measure.index();
-    for (auto& node : measure.nodes()) {
-        if (auto print = dynamic_cast<const dom::Print*>(node.get()))
-            process(measureIndex, *print);
-    }
-}
-
-void Metrics::process(std::size_t measureIndex, const dom::Print& print) {
-    if (print.newSystem && measureIndex != 0)
-        _systemCount += 1;
-    if (print.newPage && measureIndex != 0)
-        _pageCount += 1;
-
-    PrintRef ref;
-    ref.systemIndex = _systemCount;
-    ref.measureIndex = measureIndex;
-    ref.print = &print;
-    _prints.insert(ref);
 }
 
 std::size_t Metrics::staves() const {
@@ -84,42 +84,9 @@ public:
     static dom::tenths_t staffYInCClef(dom::Pitch::Step step, int octave);
     static dom::tenths_t staffYInFClef(dom::Pitch::Step step, int octave);
 
-protected:
-    struct PrintRef {
-        std::size_t systemIndex;
-        std::size_t measureIndex;
-        const dom::Print* print;
-
-        bool operator==(const PrintRef& rhs) const {
-            return systemIndex == rhs.systemIndex && measureIndex == rhs.measureIndex && print == rhs.print;
-        }
-        bool operator<(const PrintRef& rhs) const {
-            if (systemIndex < rhs.systemIndex)
-                return true;
-            if (systemIndex > rhs.systemIndex)
-                return false;
-
-            if (measureIndex < rhs.measureIndex)
-                return true;
-            if (measureIndex > rhs.measureIndex)
-                return false;
-
-            return print < rhs.print;
-        }
-    };
-
-protected:
-    void process(const dom::Measure& measure);
-    void process(std::size_t measureIndex, const dom::Print& print);
-
 protected:
     const dom::Score& _score;
     const ScoreProperties& _scoreProperties;
-
-    std::set<PrintRef> _prints;
-    std::size_t _systemCount;
-    std::size_t _pageCount;
-
     std::size_t _partIndex;
 };
 
@@ -0,0 +1,73 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "NoteIndex.h"
+
+#include <mxml/dom/Chord.h>
+#include <mxml/dom/Score.h>
+
+
+namespace mxml {
+
+const std::uint32_t NoteIndex::kNoChord;
+
+NoteIndex::NoteIndex(const dom::Score& score) {
+    for (auto& part : score.parts()) {
+        for (auto& measure : part->measures())
+            addMeasure(part->index(), *measure);
+    }
+}
+
+void NoteIndex::addMeasure(std::size_t partIndex, const dom::Measure& measure) {
+    for (auto& node : measure.nodes()) {
+        if (auto chord = dom::nodeCast<dom::Chord>(node.get()))
+            addChord(partIndex, measure.index(), *chord);
+        else if (auto note = dom::nodeCast<dom::Note>(node.get()))
+            addNote(partIndex, measure.index(), *note);
+    }
+}
+
+void NoteIndex::addChord(std::size_t partIndex, std::size_t measureIndex, const dom::Chord& chord) {
+    const auto chordIndex = static_cast<std::uint32_t>(_chords.size());
+    _chords.push_back(&chord);
+    _chordFirstNotes.push_back(static_cast<std::uint32_t>(_notes.size()));
+    _chordNoteCounts.push_back(static_cast<std::uint32_t>(chord.notes().size()));
+
+    for (auto& note : chord.notes())
+        add(partIndex, measureIndex, *note, chordIndex);
+}
+
+void NoteIndex::addNote(std::size_t partIndex, std::size_t measureIndex, const dom::Note& note) {
+    add(partIndex, measureIndex, note, kNoChord);
+}
+
+void NoteIndex::add(std::size_t partIndex, std::size_t measureIndex, const dom::Note& note, std::uint32_t chordIndex) {
+    _notes.push_back(&note);
+    _chordIndices.push_back(chordIndex);
+    _partIndices.push_back(static_cast<std::uint32_t>(partIndex));
+    _measureIndices.push_back(static_cast<std::uint32_t>(measureIndex));
+    _staves.push_back(note.staff());
+    _voices.push_back(&note.voice());
+    _starts.push_back(note.start());
+    _durations.push_back(note.duration().isPresent() ? note.duration().value() : 0);
+}
+
+void NoteIndex::clear() {
+    _notes.clear();
+    _chordIndices.clear();
+    _partIndices.clear();
+    _measureIndices.clear();
+    _staves.clear();
+    _voices.clear();
+    _starts.clear();
+    _durations.clear();
+
+    _chords.clear();
+    _chordFirstNotes.clear();
+    _chordNoteCounts.clear();
+}
+
+} // namespace mxml
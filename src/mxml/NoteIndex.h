@@ -0,0 +1,123 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/dom/Types.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace mxml {
+
+namespace dom {
+    class Chord;
+    class Measure;
+    class Note;
+    class Score;
+}
+
+/**
+ A flat index of every note and chord in a score, in score order: by part, then measure, then document order within
+ the measure. Notes that belong to a chord are contiguous. The per-note properties are kept in parallel arrays so that
+ passes over all notes do not need to walk the DOM.
+ */
+class NoteIndex {
+public:
+    static const std::uint32_t kNoChord = static_cast<std::uint32_t>(-1);
+
+public:
+    NoteIndex() = default;
+
+    /**
+     Build the index for a whole score.
+     */
+    explicit NoteIndex(const dom::Score& score);
+
+    /**
+     Append the notes and chords in a measure. Measures have to be added in score order.
+     */
+    void addMeasure(std::size_t partIndex, const dom::Measure& measure);
+    void addChord(std::size_t partIndex, std::size_t measureIndex, const dom::Chord& chord);
+    void addNote(std::size_t partIndex, std::size_t measureIndex, const dom::Note& note);
+
+    void clear();
+
+    /// The number of notes, including notes in chords and rests
+    std::size_t size() const {
+        return _notes.size();
+    }
+
+    const std::vector<const dom::Note*>& notes() const {
+        return _notes;
+    }
+
+    /// For each note, the index of its chord in `chords()` or `kNoChord`
+    const std::vector<std::uint32_t>& chordIndices() const {
+        return _chordIndices;
+    }
+    const std::vector<std::uint32_t>& partIndices() const {
+        return _partIndices;
+    }
+    const std::vector<std::uint32_t>& measureIndices() const {
+        return _measureIndices;
+    }
+    const std::vector<int>& staves() const {
+        return _staves;
+    }
+
+    /// Voice names, notes of a parsed score that are in the same voice have the same pointer
+    const std::vector<const std::string*>& voices() const {
+        return _voices;
+    }
+
+    /// Note start times, in divisions from the start of the measure
+    const std::vector<dom::time_t>& starts() const {
+        return _starts;
+    }
+
+    /// Note durations in divisions, 0 for notes without a duration such as grace notes
+    const std::vector<dom::time_t>& durations() const {
+        return _durations;
+    }
+
+    /// The number of chords
+    std::size_t chordCount() const {
+        return _chords.size();
+    }
+
+    const std::vector<const dom::Chord*>& chords() const {
+        return _chords;
+    }
+
+    /// For each chord, the index of its first note. The chord's notes are `chordNoteCounts()[i]` consecutive entries.
+    const std::vector<std::uint32_t>& chordFirstNotes() const {
+        return _chordFirstNotes;
+    }
+    const std::vector<std::uint32_t>& chordNoteCounts() const {
+        return _chordNoteCounts;
+    }
+
+private:
+    void add(std::size_t partIndex, std::size_t measureIndex, const dom::Note& note, std::uint32_t chordIndex);
+
+private:
+    std::vector<const dom::Note*> _notes;
+    std::vector<std::uint32_t> _chordIndices;
+    std::vector<std::uint32_t> _partIndices;
+    std::vector<std::uint32_t> _measureIndices;
+    std::vector<int> _staves;
+    std::vector<const std::string*> _voices;
+    std::vector<dom::time_t> _starts;
+    std::vector<dom::time_t> _durations;
+
+    std::vector<const dom::Chord*> _chords;
+    std::vector<std::uint32_t> _chordFirstNotes;
+    std::vector<std::uint32_t> _chordNoteCounts;
+};
+
+} // namespace mxml
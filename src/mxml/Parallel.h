@@ -0,0 +1,79 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Get the number of worker threads to use for `count` independent tasks. Never returns more threads than there are
+ tasks or hardware threads, and never returns zero.
+ */
+inline std::size_t workerCount(std::size_t count) {
+    std::size_t hardware = std::thread::hardware_concurrency();
+    if (hardware == 0)
+        hardware = 1;
+    return std::max<std::size_t>(1, std::min(count, hardware));
+}
+
+/**
+ Invoke `f(i)` for every index `i` in `[0, count)` using a bounded number of threads. Indices are handed out in
+ increasing order, but there is no guarantee on the order in which invocations complete. The call returns after every
+ invocation has finished. If any invocation throws, the first exception is rethrown on the calling thread.
+
+ @param count   The number of indices
+ @param f       The function to invoke, it must be safe to call concurrently with different indices
+ @param threads The maximum number of threads to use, 0 means one per hardware thread
+ */
+template <typename F>
+void parallelFor(std::size_t count, F f, std::size_t threads = 0) {
+    const auto n = threads == 0 ? workerCount(count) : std::max<std::size_t>(1, std::min(count, threads));
+    if (n <= 1) {
+        for (std::size_t i = 0; i < count; i += 1)
+            f(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    auto worker = [&]() {
+        while (true) {
+            const auto i = next.fetch_add(1);
+            if (i >= count)
+                return;
+
+            try {
+                f(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(n - 1);
+    for (std::size_t i = 1; i < n; i += 1)
+        workers.emplace_back(worker);
+    worker();
+    for (auto& thread : workers)
+        thread.join();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+} // namespace mxml
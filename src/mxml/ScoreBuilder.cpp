@@ -98,6 +98,56 @@ dom::Pitch* ScoreBuilder::setPitch(dom::Note* note, dom::Pitch::Step step, int o
     note->pitch = std::move(pitch);
     return note->pitch.get();
 }
+
+dom::Tied* ScoreBuilder::addTie(dom::Note* note, dom::StartStopContinue type) {
+    auto tie = std::unique_ptr<dom::Tied>(new dom::Tied());
+    tie->setType(type);
+
+    if (!note->notations)
+        note->notations = std::unique_ptr<dom::Notations>(new dom::Notations());
+
+    note->notations->ties.push_back(std::move(tie));
+    return note->notations->ties.back().get();
+}
+
+dom::Slur* ScoreBuilder::addSlur(dom::Note* note, dom::StartStopContinue type, int number) {
+    auto slur = std::unique_ptr<dom::Slur>(new dom::Slur());
+    slur->setType(type);
+    slur->setNumber(number);
+
+    if (!note->notations)
+        note->notations = std::unique_ptr<dom::Notations>(new dom::Notations());
+
+    note->notations->slurs.push_back(std::move(slur));
+    return note->notations->slurs.back().get();
+}
+
+dom::Lyric* ScoreBuilder::addLyric(dom::Note* note, const std::string& text, dom::Syllabic::Type syllabic, int number) {
+    auto lyric = std::unique_ptr<dom::Lyric>(new dom::Lyric());
+    lyric->setText(text);
+    lyric->setNumber(number);
+
+    auto syllabicNode = std::unique_ptr<dom::Syllabic>(new dom::Syllabic());
+    syllabicNode->setType(syllabic);
+    lyric->setSyllabic(std::move(syllabicNode));
+
+    note->addLyric(std::move(lyric));
+    return note->lyrics().back().get();
+}
+
+dom::Direction* ScoreBuilder::addDynamics(dom::Measure* measure, const std::string& string, dom::time_t start) {
+    auto dynamics = std::unique_ptr<dom::Dynamics>(new dom::Dynamics());
+    dynamics->setString(string);
+
+    auto direction = std::unique_ptr<dom::Direction>(new dom::Direction());
+    direction->setStart(start);
+    direction->setType(std::move(dynamics));
+
+    auto raw = direction.get();
+    direction->setParent(measure);
+    measure->addNode(std::move(direction));
+    return raw;
+}
     
 dom::Ornaments* ScoreBuilder::addTrill(dom::Note* note, dom::Placement placement) {
     auto ornament = std::unique_ptr<dom::Ornaments>(new dom::Ornaments());
@@ -106,7 +156,7 @@ dom::Ornaments* ScoreBuilder::addTrill(dom::Note* note, dom::Placement placement
     ornament->setTrillMark(std::move(emptyPlacement));
     
     if (!note->notations)
-        note->notations.reset(new dom::Notations());
+        note->notations = std::unique_ptr<dom::Notations>(new dom::Notations());
     
     note->notations->ornaments.push_back(std::move(ornament));
     return note->notations->ornaments.back().get();
@@ -119,7 +169,7 @@ dom::Ornaments* ScoreBuilder::addInvertedMordent(dom::Note* note, bool isLong) {
     ornament->setInvertedMordent(std::move(mordent));
     
     if (!note->notations)
-        note->notations.reset(new dom::Notations());
+        note->notations = std::unique_ptr<dom::Notations>(new dom::Notations());
     
     note->notations->ornaments.push_back(std::move(ornament));
     return note->notations->ornaments.back().get();
@@ -132,7 +182,7 @@ dom::Ornaments* ScoreBuilder::addMordent(dom::Note* note, bool isLong) {
     ornament->setMordent(std::move(mordent));
     
     if (!note->notations)
-        note->notations.reset(new dom::Notations());
+        note->notations = std::unique_ptr<dom::Notations>(new dom::Notations());
     
     note->notations->ornaments.push_back(std::move(ornament));
     return note->notations->ornaments.back().get();
@@ -145,7 +195,7 @@ dom::Ornaments* ScoreBuilder::addInvertedTurn(dom::Note* note, bool slash) {
     ornament->setInvertedTurn(std::move(turn));
     
     if (!note->notations)
-        note->notations.reset(new dom::Notations());
+        note->notations = std::unique_ptr<dom::Notations>(new dom::Notations());
     
     note->notations->ornaments.push_back(std::move(ornament));
     return note->notations->ornaments.back().get();
@@ -158,7 +208,7 @@ dom::Ornaments* ScoreBuilder::addTurn(dom::Note* note, bool slash) {
     ornament->setTurn(std::move(turn));
     
     if (!note->notations)
-        note->notations.reset(new dom::Notations());
+        note->notations = std::unique_ptr<dom::Notations>(new dom::Notations());
     
     note->notations->ornaments.push_back(std::move(ornament));
     return note->notations->ornaments.back().get();
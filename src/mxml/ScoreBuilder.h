@@ -7,6 +7,7 @@
 #pragma once
 #include <mxml/dom/Attributes.h>
 #include <mxml/dom/Chord.h>
+#include <mxml/dom/Direction.h>
 #include <mxml/dom/Score.h>
 #include <mxml/dom/Note.h>
 #include <mxml/dom/Ornaments.h>
@@ -33,6 +34,10 @@ public:
     dom::Note* addNote(dom::Chord* chord, dom::Note::Type type = dom::Note::Type::Eighth, dom::time_t start = 0, dom::time_t duration = 1);
     dom::Note* addNote(dom::Measure* measure, dom::Note::Type type = dom::Note::Type::Eighth, dom::time_t start = 0, dom::time_t duration = 1);
     dom::Pitch* setPitch(dom::Note* note, dom::Pitch::Step step, int octave, int alter = 0);
+    dom::Tied* addTie(dom::Note* note, dom::StartStopContinue type);
+    dom::Slur* addSlur(dom::Note* note, dom::StartStopContinue type, int number = 1);
+    dom::Lyric* addLyric(dom::Note* note, const std::string& text, dom::Syllabic::Type syllabic = dom::Syllabic::Type::Single, int number = 1);
+    dom::Direction* addDynamics(dom::Measure* measure, const std::string& string, dom::time_t start = 0);
     
     dom::Ornaments* addTrill(dom::Note* note, dom::Placement placement);
     dom::Ornaments* addInvertedMordent(dom::Note* note, bool isLong);
@@ -0,0 +1,212 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ScoreFollower.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+
+namespace mxml {
+
+constexpr double ScoreFollower::kNoPitch;
+
+namespace {
+
+/// Probability of skipping a state, for missed or very short notes
+const double kSkipProbability = 0.01;
+
+/// Largest probability of leaving a state after a single frame
+const double kMaxAdvanceProbability = 0.9;
+
+/// Observation probabilities when the pitch doesn't help
+const double kSilenceOnNoteProbability = 0.3;
+const double kPitchOnRestProbability = 0.05;
+const double kObservationFloor = 0.01;
+
+/// Relative probability of an octave error in the pitch detector
+const double kOctaveErrorWeight = 0.3;
+
+/// Weight of notes that keep sounding from earlier states
+const double kHeldNoteWeight = 0.5;
+
+}
+
+ScoreFollower::ScoreFollower(const EventSequence& events, double frameDuration, std::size_t bandWidth)
+: _events(events),
+  _frameDuration(frameDuration),
+  _bandWidth(bandWidth),
+  _pitchDeviation(0.5),
+  _offset(0),
+  _position(0),
+  _confidence(0)
+{
+    buildStates();
+
+    const auto bandSize = std::min(2 * _bandWidth + 1, std::max<std::size_t>(_states.size(), 1));
+    _band.resize(bandSize);
+    _scratch.resize(bandSize);
+    reset();
+}
+
+void ScoreFollower::buildStates() {
+    std::map<const dom::Note*, unsigned int> sounding;
+
+    const auto& events = _events.events();
+    for (std::size_t eventIndex = 0; eventIndex < events.size(); eventIndex += 1) {
+        auto& event = events[eventIndex];
+        for (auto note : event.offNotes())
+            sounding.erase(note);
+        if (event.onNotes().empty())
+            continue;
+
+        State state;
+        state.eventIndex = eventIndex;
+        state.pitchBegin = _pitches.size();
+        for (auto note : event.onNotes()) {
+            if (!note->pitch)
+                continue;
+            _pitches.push_back(Pitch{static_cast<double>(note->midiNumber()), 1.0});
+        }
+        for (auto& pair : sounding)
+            _pitches.push_back(Pitch{static_cast<double>(pair.second), kHeldNoteWeight});
+        state.pitchEnd = _pitches.size();
+        state.advance = kMaxAdvanceProbability;
+        _states.push_back(state);
+
+        for (auto note : event.onNotes()) {
+            if (note->pitch)
+                sounding[note] = note->midiNumber();
+        }
+    }
+
+    // Expected number of frames in each state from the wall time to the next state
+    for (std::size_t index = 0; index < _states.size(); index += 1) {
+        auto& event = events[_states[index].eventIndex];
+        double duration = event.wallTimeDuration();
+        if (index + 1 < _states.size())
+            duration = events[_states[index + 1].eventIndex].wallTime() - event.wallTime();
+
+        const auto frames = duration / _frameDuration;
+        if (frames > 1)
+            _states[index].advance = std::min(kMaxAdvanceProbability, 1 / frames);
+    }
+}
+
+void ScoreFollower::reset(std::size_t state) {
+    std::fill(_band.begin(), _band.end(), 0.0);
+    if (_states.empty())
+        return;
+
+    _position = std::min(state, _states.size() - 1);
+    _offset = 0;
+    recenter(_position);
+    _band[_position - _offset] = 1;
+    _confidence = 1;
+}
+
+std::size_t ScoreFollower::update(double pitch) {
+    if (_states.empty())
+        return 0;
+
+    const auto size = _band.size();
+    const auto skip = kSkipProbability;
+
+    double sum = 0;
+    for (std::size_t j = 0; j < size; j += 1) {
+        const auto& state = _states[_offset + j];
+
+        double p = _band[j] * (1 - state.advance - skip);
+        if (j >= 1)
+            p += _band[j - 1] * _states[_offset + j - 1].advance;
+        if (j >= 2)
+            p += _band[j - 2] * skip;
+
+        p *= observation(state, pitch);
+        _scratch[j] = p;
+        sum += p;
+    }
+
+    if (sum <= 0) {
+        // Lost track, keep the previous distribution
+        return _position;
+    }
+
+    std::size_t best = 0;
+    for (std::size_t j = 0; j < size; j += 1) {
+        _band[j] = _scratch[j] / sum;
+        if (_band[j] > _band[best])
+            best = j;
+    }
+
+    _position = _offset + best;
+    _confidence = _band[best];
+    recenter(_position);
+    return _position;
+}
+
+void ScoreFollower::recenter(std::size_t center) {
+    const auto size = _band.size();
+    std::size_t offset = center > _bandWidth ? center - _bandWidth : 0;
+    offset = std::min(offset, _states.size() - size);
+    if (offset == _offset)
+        return;
+
+    // Shift the band in place, states entering the band start with no probability
+    if (offset > _offset) {
+        const auto shift = std::min(offset - _offset, size);
+        std::copy(_band.begin() + shift, _band.end(), _band.begin());
+        std::fill(_band.end() - shift, _band.end(), 0.0);
+    } else {
+        const auto shift = std::min(_offset - offset, size);
+        std::copy_backward(_band.begin(), _band.end() - shift, _band.end());
+        std::fill(_band.begin(), _band.begin() + shift, 0.0);
+    }
+    _offset = offset;
+}
+
+double ScoreFollower::observation(const State& state, double pitch) const {
+    const bool rest = state.pitchBegin == state.pitchEnd;
+    if (pitch < 0)
+        return rest ? 1.0 : kSilenceOnNoteProbability;
+    if (rest)
+        return kPitchOnRestProbability;
+
+    const auto variance = 2 * _pitchDeviation * _pitchDeviation;
+    double best = 0;
+    for (auto index = state.pitchBegin; index < state.pitchEnd; index += 1) {
+        const auto& statePitch = _pitches[index];
+        const auto distance = pitch - statePitch.midiNumber;
+        const auto octaveDistance = distance - 12 * std::round(distance / 12);
+
+        const auto exact = std::exp(-distance * distance / variance);
+        const auto octave = kOctaveErrorWeight * std::exp(-octaveDistance * octaveDistance / variance);
+        best = std::max(best, statePitch.weight * std::max(exact, octave));
+    }
+    return kObservationFloor + best;
+}
+
+std::size_t ScoreFollower::stateForEvent(std::size_t eventIndex) const {
+    auto it = std::upper_bound(_states.begin(), _states.end(), eventIndex, [](std::size_t index, const State& state) {
+        return index < state.eventIndex;
+    });
+    if (it == _states.begin())
+        return 0;
+    return std::distance(_states.begin(), it) - 1;
+}
+
+double ScoreFollower::topPitch(std::size_t state) const {
+    double top = kNoPitch;
+    auto& event = this->event(state);
+    for (auto note : event.onNotes()) {
+        if (note->pitch)
+            top = std::max(top, static_cast<double>(note->midiNumber()));
+    }
+    return top;
+}
+
+} // namespace mxml
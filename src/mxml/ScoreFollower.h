@@ -0,0 +1,133 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "EventSequence.h"
+
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Online alignment of a detected pitch stream against an event sequence. Every event with pitched or rest on-notes is a
+ state of a left-to-right hidden Markov model. Each frame runs one forward step restricted to a band of states around
+ the current position, so the cost per frame is constant and no memory is allocated after construction.
+ */
+class ScoreFollower {
+public:
+    /**
+     Value to pass to `update()` for frames without a detected pitch.
+     */
+    static constexpr double kNoPitch = -1;
+
+public:
+    /**
+     @param events        The event sequence to follow, it has to outlive the follower
+     @param frameDuration The time between frames in seconds
+     @param bandWidth     The number of states considered on each side of the current position
+     */
+    ScoreFollower(const EventSequence& events, double frameDuration, std::size_t bandWidth = 16);
+
+    /**
+     Restart following from the given state.
+     */
+    void reset(std::size_t state = 0);
+
+    /**
+     Process one frame.
+
+     @param pitch The detected pitch as a fractional MIDI note number, or `kNoPitch`
+     @return The most likely state after the frame
+     */
+    std::size_t update(double pitch);
+
+    /**
+     Get the number of states, one per followed event.
+     */
+    std::size_t stateCount() const {
+        return _states.size();
+    }
+
+    /**
+     Get the most likely state.
+     */
+    std::size_t position() const {
+        return _position;
+    }
+
+    /**
+     Get the posterior probability of the most likely state.
+     */
+    double confidence() const {
+        return _confidence;
+    }
+
+    /**
+     Get the event for the given state.
+     */
+    const Event& event(std::size_t state) const {
+        return _events.events()[_states[state].eventIndex];
+    }
+
+    /**
+     Get the state for the event at the given index of the sequence. Events without on-notes map to the previous state.
+     */
+    std::size_t stateForEvent(std::size_t eventIndex) const;
+
+    /**
+     Get the MIDI number of the highest pitch starting at the given state, or `kNoPitch` for rests.
+     */
+    double topPitch(std::size_t state) const;
+
+    /**
+     The standard deviation of detected pitches, in semitones. Defaults to 0.5.
+     */
+    void setPitchDeviation(double deviation) {
+        _pitchDeviation = deviation;
+    }
+
+protected:
+    struct Pitch {
+        double midiNumber;
+
+        /// Lower for notes that started at an earlier state and are still sounding
+        double weight;
+    };
+
+    struct State {
+        std::size_t eventIndex;
+        std::size_t pitchBegin;
+        std::size_t pitchEnd;
+
+        /// The probability of leaving the state after a frame
+        double advance;
+    };
+
+protected:
+    void buildStates();
+    double observation(const State& state, double pitch) const;
+    void recenter(std::size_t center);
+
+private:
+    const EventSequence& _events;
+    const double _frameDuration;
+    const std::size_t _bandWidth;
+    double _pitchDeviation;
+
+    std::vector<State> _states;
+    std::vector<Pitch> _pitches;
+
+    /// Probabilities of the states in [_offset, _offset + _band.size())
+    std::vector<double> _band;
+    std::vector<double> _scratch;
+    std::size_t _offset;
+
+    std::size_t _position;
+    double _confidence;
+};
+
+} // namespace mxml
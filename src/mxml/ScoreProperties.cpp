@@ -9,8 +9,10 @@
 #include "JumpFactory.h"
 
 #include <mxml/dom/Chord.h>
+#include <mxml/dom/NodeVisitor.h>
 #include <mxml/dom/OctaveShift.h>
 
+#include <limits>
 #include <numeric>
 
 
@@ -40,6 +42,14 @@ ScoreProperties::ScoreProperties(const dom::Score& score, LayoutType layoutType)
         if (measureCount > _measureCount)
             _measureCount = measureCount;
     }
+    _tieIndex.finish();
+
+    // Alters come from chord notes, rests and other loose notes don't change them
+    auto& notes = _noteIndex.notes();
+    for (std::size_t i = 0; i < notes.size(); i += 1) {
+        if (_noteIndex.chordIndices()[i] != NoteIndex::kNoChord)
+            _alterSequence.addFromNote(_noteIndex.partIndices()[i], _noteIndex.measureIndices()[i], *notes[i]);
+    }
 
     _clefSequence.sort();
     _keySequence.sort();
@@ -53,24 +63,68 @@ ScoreProperties::ScoreProperties(const dom::Score& score, LayoutType layoutType)
     JumpFactory jumpFactory(score);
     _jumps = jumpFactory.build();
 
+    for (auto& ref : _sounds) {
+        if (ref.sound->tempo.isPresent())
+            _tempos.push_back(TempoRef{ref.measureIndex, ref.time, ref.sound->tempo.value()});
+    }
+
     _systemBegins.insert(_systemBegins.end(), _systemBeginsSet.begin(), _systemBeginsSet.end());
     _pageBegins.insert(_pageBegins.end(), _pageBeginsSet.begin(), _pageBeginsSet.end());
+
+    buildSystemLayouts(score);
 }
 
-void ScoreProperties::process(std::size_t partIndex, const dom::Measure& measure) {
-    auto measureIndex = measure.index();
-    for (auto& node : measure.nodes()) {
-        if (auto attributes = dynamic_cast<const dom::Attributes*>(node.get()))
-            process(partIndex, measureIndex, *attributes);
-        else if (auto chord = dynamic_cast<const dom::Chord*>(node.get()))
-            process(partIndex, measureIndex, *chord);
-        else if (auto direction = dynamic_cast<const dom::Direction*>(node.get()))
-            process(partIndex, measureIndex, *direction);
-        else if (auto print = dynamic_cast<const dom::Print*>(node.get()))
-            process(partIndex, measureIndex, *print);
+void ScoreProperties::buildSystemLayouts(const dom::Score& score) {
+    _defaultSystemDistance = 80;
+    _defaultStaffDistance = 65;
+
+    auto& defaults = score.defaults();
+    if (defaults) {
+        if (defaults->systemLayout) {
+            auto& systemLayout = defaults->systemLayout.value();
+            if (systemLayout.systemDistance)
+                _defaultSystemDistance = systemLayout.systemDistance;
+        }
+        if (defaults->staffDistance())
+            _defaultStaffDistance = defaults->staffDistance();
+    }
+
+    const auto partCount = _staves.size();
+    _systemLayouts.assign(systemCount() * partCount, SystemLayoutRef{_defaultSystemDistance, _defaultStaffDistance});
+
+    // Prints were collected in measure order for each part, so the last print in a system wins
+    for (auto& ref : _prints) {
+        auto& layout = _systemLayouts[systemIndex(ref.measureIndex) * partCount + ref.partIndex];
+        auto& print = *ref.print;
+        if (print.systemLayout) {
+            auto& systemLayout = print.systemLayout.value();
+            if (systemLayout.systemDistance)
+                layout.systemDistance = systemLayout.systemDistance;
+        }
+        if (print.staffDistance())
+            layout.staffDistance = print.staffDistance();
     }
 }
 
+void ScoreProperties::process(std::size_t partIndex, const dom::Measure& measure) {
+    struct Visitor {
+        ScoreProperties& properties;
+        std::size_t partIndex;
+        std::size_t measureIndex;
+
+        void operator()(const dom::Attributes& attributes) { properties.process(partIndex, measureIndex, attributes); }
+        void operator()(const dom::Chord& chord) { properties.process(partIndex, measureIndex, chord); }
+        void operator()(const dom::Note& note) { properties.process(partIndex, measureIndex, note); }
+        void operator()(const dom::Direction& direction) { properties.process(partIndex, measureIndex, direction); }
+        void operator()(const dom::Print& print) { properties.process(partIndex, measureIndex, print); }
+        void operator()(const dom::Node&) {}
+    };
+
+    Visitor visitor{*this, partIndex, measure.index()};
+    for (auto& node : measure.nodes())
+        dom::visit(*node, visitor);
+}
+
 void ScoreProperties::process(std::size_t partIndex, std::size_t measureIndex, const dom::Attributes& attributes) {
     if (attributes.staves().isPresent()) {
         assert(_staves[partIndex] == 0); // We don't support changing the number of staves mid-song
@@ -106,6 +160,8 @@ void ScoreProperties::process(std::size_t partIndex, std::size_t measureIndex, c
 }
 
 void ScoreProperties::process(std::size_t partIndex, std::size_t measureIndex, const dom::Print& print) {
+    _prints.push_back(PrintRef{partIndex, measureIndex, &print});
+
     if (print.newSystem || print.newPage)
         _systemBeginsSet.insert(measureIndex);
     if (print.newPage)
@@ -113,9 +169,12 @@ void ScoreProperties::process(std::size_t partIndex, std::size_t measureIndex, c
 }
 
 void ScoreProperties::process(std::size_t partIndex, std::size_t measureIndex, const dom::Chord& chord) {
-    for (auto& note : chord.notes()) {
-        _alterSequence.addFromNote(partIndex, measureIndex, *note);
-    }
+    _noteIndex.addChord(partIndex, measureIndex, chord);
+    _tieIndex.addChord(partIndex, measureIndex, chord);
+}
+
+void ScoreProperties::process(std::size_t partIndex, std::size_t measureIndex, const dom::Note& note) {
+    _noteIndex.addNote(partIndex, measureIndex, note);
 }
 
 dom::time_t ScoreProperties::divisionsPerBeat(std::size_t measureIndex) const {
@@ -163,14 +222,20 @@ int ScoreProperties::alter(const dom::Note& note) const {
 }
 
 float ScoreProperties::tempo(std::size_t measureIndex, dom::time_t time) const {
-    float current = 60.0;
-    for (auto& ref : _sounds) {
-        if (ref.measureIndex > measureIndex || (ref.measureIndex == measureIndex && ref.time > time))
-            return current;
-        if (ref.sound->tempo.isPresent())
-            current = ref.sound->tempo.value();
+    auto it = std::upper_bound(_tempos.begin(), _tempos.end(), TempoRef{measureIndex, time, 0});
+    if (it == _tempos.begin())
+        return 60.0;
+    return std::prev(it)->tempo;
+}
+
+std::vector<dom::time_t> ScoreProperties::tempoChanges(std::size_t measureIndex) const {
+    std::vector<dom::time_t> times;
+    auto it = std::lower_bound(_tempos.begin(), _tempos.end(), TempoRef{measureIndex, std::numeric_limits<dom::time_t>::min(), 0});
+    for (; it != _tempos.end() && it->measureIndex == measureIndex; ++it) {
+        if (times.empty() || times.back() != it->time)
+            times.push_back(it->time);
     }
-    return current;
+    return times;
 }
 
 float ScoreProperties::dynamics(const dom::Note& note) const {
@@ -215,6 +280,75 @@ std::vector<Jump> ScoreProperties::jumps(std::size_t measureIndex) const {
     return jumps;
 }
 
+std::vector<std::size_t> ScoreProperties::playbackOrder(std::size_t startMeasureIndex, std::size_t endMeasureIndex) const {
+    std::vector<std::size_t> order;
+
+    std::size_t measureIndex = startMeasureIndex;
+    std::map<Loop, std::size_t> loopCounts;
+
+    enum JumpState { kUnencountered, kFlagged, kActive, kPerformed };
+    std::map<Jump, JumpState> jumpStates;
+
+    // Iterate until we equal the measure count for loops
+    // that 'end' past the last measure
+    while (measureIndex <= endMeasureIndex) {
+        bool skipped = false;
+
+        auto prevLoop = loop(measureIndex - 1);
+        if (prevLoop && prevLoop->end() == measureIndex) {
+            auto& loopInteration = loopCounts[*prevLoop];
+
+            if (loopInteration < prevLoop->count()) {
+                measureIndex = prevLoop->begin();
+                skipped = true;
+            }
+
+            loopInteration += 1;
+        }
+
+        auto currentLoop = loop(measureIndex);
+        if (!skipped && currentLoop) {
+            auto& loopInteration = loopCounts[*currentLoop];
+
+            if (currentLoop->isSkipped(loopInteration, measureIndex)) {
+                measureIndex += 1;
+                skipped = true;
+            }
+        }
+
+        for (auto& jump : jumps(measureIndex)) {
+            auto& state = jumpStates[jump];
+            if (jump.forward()) {
+                if (state == kActive) {
+                    measureIndex = jump.to;
+                    skipped = true;
+                    state = kPerformed;
+                } else {
+                    state = kFlagged;
+                }
+            } else if (!jump.forward()) {
+                if (state == kUnencountered) {
+                    measureIndex = jump.to;
+                    skipped = true;
+                    for (auto& pair : jumpStates) {
+                        if (pair.second == kFlagged)
+                            pair.second = kActive;
+                    }
+                }
+                state = kPerformed;
+            }
+        }
+
+        if (!skipped) {
+            if (measureIndex < endMeasureIndex)
+                order.push_back(measureIndex);
+            measureIndex += 1;
+        }
+    }
+
+    return order;
+}
+
 int ScoreProperties::octaveShift(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const {
     int current = 0;
     for (auto& ref : _directions) {
@@ -226,7 +360,7 @@ int ScoreProperties::octaveShift(std::size_t partIndex, std::size_t measureIndex
         if (ref.partIndex != partIndex)
             continue;
 
-        auto octaveShift = dynamic_cast<const dom::OctaveShift*>(ref.direction->type());
+        auto octaveShift = dom::nodeCast<dom::OctaveShift>(ref.direction->type());
         if (!octaveShift)
             continue;
 
@@ -252,6 +386,20 @@ std::size_t ScoreProperties::pageIndex(std::size_t measureIndex) const {
     return std::distance(_pageBegins.begin(), it) - 1;
 }
 
+dom::tenths_t ScoreProperties::systemDistance(std::size_t systemIndex, std::size_t partIndex) const {
+    const auto index = systemIndex * _staves.size() + partIndex;
+    if (index >= _systemLayouts.size())
+        return _defaultSystemDistance;
+    return _systemLayouts[index].systemDistance;
+}
+
+dom::tenths_t ScoreProperties::staffDistance(std::size_t systemIndex, std::size_t partIndex) const {
+    const auto index = systemIndex * _staves.size() + partIndex;
+    if (index >= _systemLayouts.size())
+        return _defaultStaffDistance;
+    return _systemLayouts[index].staffDistance;
+}
+
 std::pair<std::size_t, std::size_t> ScoreProperties::measureRange(std::size_t index) const {
     std::pair<std::size_t, std::size_t> range;
     range.first = _systemBegins[index];
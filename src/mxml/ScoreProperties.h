@@ -12,6 +12,8 @@
 #include "attributes/TimeSequence.h"
 #include "Jump.h"
 #include "Loop.h"
+#include "NoteIndex.h"
+#include "TieIndex.h"
 
 #include <mxml/dom/Attributes.h>
 #include <mxml/dom/Direction.h>
@@ -118,6 +120,11 @@ public:
      */
     float tempo(std::size_t measureIndex, dom::time_t time) const;
 
+    /**
+     Get the times within the given measure at which a sound sets the tempo, in increasing order.
+     */
+    std::vector<dom::time_t> tempoChanges(std::size_t measureIndex) const;
+
     /**
      Get the dynamics for the given note.
      */
@@ -136,6 +143,12 @@ public:
      */
     std::vector<Jump> jumps(std::size_t measureIndex) const;
 
+    /**
+     Get the indices of the measures in the range [startMeasureIndex, endMeasureIndex) in the order in which they are
+     played, after unrolling all loops and jumps.
+     */
+    std::vector<std::size_t> playbackOrder(std::size_t startMeasureIndex, std::size_t endMeasureIndex) const;
+
     /**
      Get the size of the octave shift for the given part, measure, staff and time.
      */
@@ -164,6 +177,25 @@ public:
         return _pageBegins.size();
     }
 
+    /**
+     Get the vertical distance between a system and the previous system for a part. This comes from the last `print`
+     element of the part in that system that sets it, or from the score defaults.
+     */
+    dom::tenths_t systemDistance(std::size_t systemIndex, std::size_t partIndex) const;
+
+    /**
+     Get the distance between the first and second staves of a part in a system. This comes from the last `print`
+     element of the part in that system that sets it, or from the score defaults.
+     */
+    dom::tenths_t staffDistance(std::size_t systemIndex, std::size_t partIndex) const;
+
+    /**
+     Get the staff distance from the score defaults.
+     */
+    dom::tenths_t defaultStaffDistance() const {
+        return _defaultStaffDistance;
+    }
+
     /**
      Get the layout type for the score.
      */
@@ -171,6 +203,21 @@ public:
         return _layoutType;
     }
 
+    /**
+     Get the flat index of all notes and chords in the score. It is built along with the properties, so passes that
+     need to visit every note can share it instead of walking the DOM again.
+     */
+    const NoteIndex& noteIndex() const {
+        return _noteIndex;
+    }
+
+    /**
+     Get the paired ties and slurs of the score. Both scroll and page layouts build their tie geometries from it.
+     */
+    const TieIndex& tieIndex() const {
+        return _tieIndex;
+    }
+
     
 private:
     /**
@@ -210,6 +257,27 @@ protected:
 
     };
 
+    struct TempoRef {
+        std::size_t measureIndex;
+        dom::time_t time;
+        float tempo;
+
+        bool operator<(const TempoRef& rhs) const {
+            return measureIndex < rhs.measureIndex || (measureIndex == rhs.measureIndex && time < rhs.time);
+        }
+    };
+
+    struct PrintRef {
+        std::size_t partIndex;
+        std::size_t measureIndex;
+        const dom::Print* print;
+    };
+
+    struct SystemLayoutRef {
+        dom::tenths_t systemDistance;
+        dom::tenths_t staffDistance;
+    };
+
     struct DirectionRef {
         std::size_t partIndex;
         std::size_t measureIndex;
@@ -252,16 +320,21 @@ protected:
     void process(std::size_t partIndex, std::size_t measureIndex, const dom::Direction& direction);
     void process(std::size_t partIndex, std::size_t measureIndex, const dom::Print& print);
     void process(std::size_t partIndex, std::size_t measureIndex, const dom::Chord& chord);
+    void process(std::size_t partIndex, std::size_t measureIndex, const dom::Note& note);
+    void buildSystemLayouts(const dom::Score& score);
 
 private:
     std::set<DirectionRef> _directions;
     std::set<SoundRef> _sounds;
+    std::vector<TempoRef> _tempos;
 
     ClefSequence _clefSequence;
     KeySequence _keySequence;
     TimeSequence _timeSequence;
     DivisionsSequence _divisionsSequence;
     AlterSequence _alterSequence;
+    NoteIndex _noteIndex;
+    TieIndex _tieIndex;
 
     std::vector<Loop> _loops;
     std::vector<Jump> _jumps;
@@ -273,6 +346,13 @@ private:
     std::set<std::size_t> _pageBeginsSet;
     std::vector<std::size_t> _pageBegins;
 
+    std::vector<PrintRef> _prints;
+    dom::tenths_t _defaultSystemDistance;
+    dom::tenths_t _defaultStaffDistance;
+
+    /// Resolved layout values for each system and part, indexed by `systemIndex * partCount + partIndex`
+    std::vector<SystemLayoutRef> _systemLayouts;
+
     const LayoutType _layoutType;
 };
     
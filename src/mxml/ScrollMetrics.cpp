@@ -14,19 +14,9 @@ ScrollMetrics::ScrollMetrics(const dom::Score& score, const ScoreProperties& sco
 }
 
 dom::tenths_t ScrollMetrics::staffDistance() const {
-    dom::tenths_t distance = 65;
-
-    // Get default staff distance from the `defaults` element
-    auto& defaults = _score.defaults();
-    if (defaults) {
-        if (defaults->staffDistance())
-            distance = defaults->staffDistance();
-    }
-
     // We should consider finding the maximal distance from all the `print` elements, but this will sometimes make the
     // space between the staves too large
-
-    return distance;
+    return _scoreProperties.defaultStaffDistance();
 }
 
 }
@@ -80,10 +80,10 @@ void SpanFactory::build(const dom::Measure* measure, bool buildMeasureAttributes
         // Compute next note time
         _nextTime = -1;
         for (auto it2 = std::next(it); it2 != nodes.end(); ++it2) {
-            if (auto chord = dynamic_cast<const dom::Chord*>(it2->get())) {
+            if (auto chord = dom::nodeCast<dom::Chord>(it2->get())) {
                 _nextTime = chord->start();
                 break;
-            } else if (auto note = dynamic_cast<const dom::Note*>(it2->get())) {
+            } else if (auto note = dom::nodeCast<dom::Note>(it2->get())) {
                 _nextTime = note->start();
                 break;
             }
@@ -91,13 +91,13 @@ void SpanFactory::build(const dom::Measure* measure, bool buildMeasureAttributes
         if (_nextTime == -1)
             _nextTime = _scoreProperties.divisionsPerMeasure(measure->index());
 
-        if (const dom::Barline* barline = dynamic_cast<const dom::Barline*>(node.get())) {
+        if (const dom::Barline* barline = dom::nodeCast<dom::Barline>(node.get())) {
             build(barline);
-        } else if (const dom::Attributes* attributes = dynamic_cast<const dom::Attributes*>(node.get())) {
+        } else if (const dom::Attributes* attributes = dom::nodeCast<dom::Attributes>(node.get())) {
             build(attributes);
-        } else if (const dom::Direction* direction = dynamic_cast<const dom::Direction*>(node.get())) {
+        } else if (const dom::Direction* direction = dom::nodeCast<dom::Direction>(node.get())) {
             build(direction);
-        } else if (const dom::TimedNode* timedNode = dynamic_cast<const dom::TimedNode*>(node.get())) {
+        } else if (const dom::TimedNode* timedNode = dom::nodeCast<dom::TimedNode>(node.get())) {
             build(timedNode);
         }
     }
@@ -186,9 +186,9 @@ void SpanFactory::build(const dom::Direction* direction) {
 void SpanFactory::build(const dom::TimedNode* node) {
     _currentTime = node->start();
     
-    if (auto chord = dynamic_cast<const dom::Chord*>(node)) {
+    if (auto chord = dom::nodeCast<dom::Chord>(node)) {
         build(chord);
-    } else if (auto note = dynamic_cast<const dom::Note*>(node)) {
+    } else if (auto note = dom::nodeCast<dom::Note>(node)) {
         build(note);
     }
 }
@@ -212,7 +212,7 @@ void SpanFactory::build(const dom::Chord* chord) {
     coord_t headWidth = 0;
     coord_t stemWidth = 0;
     coord_t naturalWidth = -1;
-    coord_t lyricsWidth = 0;
+    std::vector<const dom::Lyric*> lyrics;
     for (auto& note : chord->notes()) {
         headWidth = std::max(headWidth, NoteGeometry::Size(*note).width);
 
@@ -229,9 +229,14 @@ void SpanFactory::build(const dom::Chord* chord) {
         else
             naturalWidth = std::min(naturalWidth, naturalWidthForNote(*note));
 
-        for (auto& lyric : note->lyrics()) {
-            lyricsWidth = std::max(lyricsWidth, LyricGeometry::width(*lyric));
-        }
+        for (auto& lyric : note->lyrics())
+            lyrics.push_back(lyric.get());
+    }
+
+    coord_t lyricsWidth = 0;
+    if (!lyrics.empty()) {
+        const auto widths = LyricGeometry::widths(lyrics);
+        lyricsWidth = *std::max_element(widths.begin(), widths.end());
     }
     
     coord_t width = headWidth;
@@ -351,7 +356,7 @@ SpanCollection::iterator SpanFactory::graceNoteSpan(const dom::Chord* chord) {
     auto count = std::count_if(range.first, range.second, [staff](const Span& s) {
         const std::set<const dom::Node*>& nodes = s.nodes();
         auto it = std::find_if(nodes.begin(), nodes.end(), [staff](const dom::Node* n) {
-            const dom::Chord* chord = dynamic_cast<const dom::Chord*>(n);
+            const dom::Chord* chord = dom::nodeCast<dom::Chord>(n);
             if (!chord)
                 return false;
 
@@ -365,7 +370,7 @@ SpanCollection::iterator SpanFactory::graceNoteSpan(const dom::Chord* chord) {
     std::size_t n = 0;
     for (auto it = range.first; it != range.second; ++it) {
         for (auto& node : it->nodes()) {
-            const dom::Chord* chord = dynamic_cast<const dom::Chord*>(node);
+            const dom::Chord* chord = dom::nodeCast<dom::Chord>(node);
             if (!chord)
                 continue;
 
@@ -419,7 +424,7 @@ bool SpanFactory::isAttributeOnlySpan(const Span& span) {
         return false;
 
     for (auto& node : span.nodes()) {
-        if (!dynamic_cast<const dom::Clef*>(node) && !dynamic_cast<const dom::Time*>(node) && !dynamic_cast<const dom::Key*>(node)) {
+        if (!dom::nodeCast<dom::Clef>(node) && !dom::nodeCast<dom::Time>(node) && !dom::nodeCast<dom::Key>(node)) {
             return false;
         }
     }
@@ -38,7 +38,7 @@ namespace mxml {
         } else if ((*s & 0xF8) == 0xF0) {                       // 11110xxx => 4 bytes
             if (n < 4)
                 return static_cast<std::size_t>(-2);
-            *pc32 = ((s[0] & 0x7) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[4] & 0x3F);
+            *pc32 = ((s[0] & 0x7) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
             return 4;
         }
         
@@ -0,0 +1,292 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SvgWriter.h"
+
+#include <mxml/geometry/PageScoreGeometry.h>
+#include <mxml/geometry/ScrollScoreGeometry.h>
+#include <mxml/geometry/SystemGeometry.h>
+#include <mxml/geometry/factories/DisplayListFactory.h>
+
+#include <cmath>
+#include <cstdio>
+
+
+namespace mxml {
+
+const char* const SvgWriter::kMusicFontFamily = "Bravura";
+const char* const SvgWriter::kTextFontFamily = "serif";
+const coord_t SvgWriter::kMusicFontSize = 40;
+const coord_t SvgWriter::kWordsFontSize = 23;
+const coord_t SvgWriter::kDynamicsFontSize = 30;
+const coord_t SvgWriter::kInactiveOpacity = 0.4;
+
+namespace {
+
+/// SMuFL time signature digits start at this code point
+const std::uint32_t kTimeSigDigitZero = 0xE080;
+
+} // namespace
+
+SvgWriter::SvgWriter(std::ostream& stream) : _stream(stream) {
+}
+
+void SvgWriter::writePage(const PageScoreGeometry& geometry, std::size_t pageIndex) {
+    DisplayListFactory factory;
+    writePage(geometry, factory.build(geometry), pageIndex);
+}
+
+void SvgWriter::writePage(const PageScoreGeometry& geometry, const DisplayList& displayList, std::size_t pageIndex) {
+    auto& scoreProperties = geometry.scoreProperties();
+
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < displayList.chunks().size(); i += 1) {
+        if (scoreProperties.pageIndex(displayList.chunks()[i].measureIndex) == pageIndex)
+            chunks.push_back(i);
+    }
+
+    // The page is as wide as the score and as tall as its systems
+    const Rect bounds = geometry.bounds();
+    Rect viewBox;
+    bool first = true;
+    for (auto systemGeometry : geometry.systemGeometries()) {
+        const auto measureIndex = scoreProperties.measureRange(systemGeometry->systemIndex()).first;
+        if (scoreProperties.pageIndex(measureIndex) != pageIndex)
+            continue;
+
+        const Rect frame = systemGeometry->frame();
+        viewBox = first ? frame : join(viewBox, frame);
+        first = false;
+    }
+    viewBox.origin.x = bounds.origin.x;
+    viewBox.size.width = bounds.size.width;
+
+    writeChunks(displayList, chunks, viewBox);
+}
+
+void SvgWriter::writeRange(const ScrollScoreGeometry& geometry, coord_t startX, coord_t endX) {
+    DisplayListFactory factory;
+    writeRange(geometry, factory.build(geometry), startX, endX);
+}
+
+void SvgWriter::writeRange(const ScrollScoreGeometry& geometry, const DisplayList& displayList, coord_t startX, coord_t endX) {
+    const Rect bounds = geometry.bounds();
+    const Rect viewBox({startX, bounds.origin.y}, Size(std::max(endX - startX, coord_t(0)), bounds.size.height));
+    writeChunks(displayList, displayList.visibleChunks(viewBox), viewBox);
+}
+
+void SvgWriter::writeChunks(const DisplayList& displayList, const std::vector<std::size_t>& chunks, const Rect& viewBox) {
+    _stream << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"";
+    writeNumber(viewBox.size.width);
+    _stream << "\" height=\"";
+    writeNumber(viewBox.size.height);
+    _stream << "\" viewBox=\"";
+    writeNumber(viewBox.origin.x);
+    _stream << ' ';
+    writeNumber(viewBox.origin.y);
+    _stream << ' ';
+    writeNumber(viewBox.size.width);
+    _stream << ' ';
+    writeNumber(viewBox.size.height);
+    _stream << "\">\n";
+
+    _stream << "<g fill=\"#000\" stroke=\"#000\" stroke-width=\"0\" font-family=\"" << kMusicFontFamily << "\" font-size=\"";
+    writeNumber(kMusicFontSize);
+    _stream << "\">\n";
+
+    auto& commands = displayList.commands();
+    for (auto chunkIndex : chunks) {
+        auto& chunk = displayList.chunks()[chunkIndex];
+        _stream << "<g id=\"m";
+        writeInteger(chunk.measureIndex);
+        _stream << "\">\n";
+        for (std::size_t i = chunk.begin; i < chunk.end; i += 1)
+            writeCommand(displayList, commands[i]);
+        _stream << "</g>\n";
+    }
+
+    _stream << "</g>\n</svg>\n";
+}
+
+void SvgWriter::writeCommand(const DisplayList& displayList, const DisplayCommand& command) {
+    switch (command.type) {
+        case DisplayCommand::Type::Glyph:
+            writeGlyph(command);
+            break;
+
+        case DisplayCommand::Type::Line:
+            writeLine(command);
+            break;
+
+        case DisplayCommand::Type::Curve:
+            writeCurve(command);
+            break;
+
+        case DisplayCommand::Type::Text:
+            writeText(command, displayList.text(command));
+            break;
+    }
+}
+
+void SvgWriter::writeGlyph(const DisplayCommand& command) {
+    // SMuFL glyphs have their origin on the left edge, at the anchor's height
+    const Point origin{command.frame.origin.x, command.points[0].y};
+
+    _stream << "<text";
+    if (command.scale != 1) {
+        _stream << " transform=\"translate(";
+        writeNumber(origin.x);
+        _stream << ' ';
+        writeNumber(origin.y);
+        _stream << ") scale(";
+        writeNumber(command.scale);
+        _stream << ")\"";
+    } else {
+        _stream << " x=\"";
+        writeNumber(origin.x);
+        _stream << "\" y=\"";
+        writeNumber(origin.y);
+        _stream << '"';
+    }
+    writeOpacity(command);
+    _stream << '>';
+    writeCodepoint(glyphCodepoint(command.glyph));
+    _stream << "</text>\n";
+}
+
+void SvgWriter::writeLine(const DisplayCommand& command) {
+    _stream << "<line x1=\"";
+    writeNumber(command.points[0].x);
+    _stream << "\" y1=\"";
+    writeNumber(command.points[0].y);
+    _stream << "\" x2=\"";
+    writeNumber(command.points[1].x);
+    _stream << "\" y2=\"";
+    writeNumber(command.points[1].y);
+    _stream << "\" stroke-width=\"";
+    writeNumber(command.lineWidth);
+    _stream << '"';
+    writeOpacity(command);
+    _stream << "/>\n";
+}
+
+void SvgWriter::writeCurve(const DisplayCommand& command) {
+    _stream << "<path d=\"M";
+    writeNumber(command.points[0].x);
+    _stream << ' ';
+    writeNumber(command.points[0].y);
+    _stream << 'C';
+    for (int i = 1; i < 4; i += 1) {
+        if (i > 1)
+            _stream << ' ';
+        writeNumber(command.points[i].x);
+        _stream << ' ';
+        writeNumber(command.points[i].y);
+    }
+    _stream << "\" fill=\"none\" stroke-width=\"";
+    writeNumber(command.lineWidth);
+    _stream << '"';
+    writeOpacity(command);
+    _stream << "/>\n";
+}
+
+void SvgWriter::writeText(const DisplayCommand& command, const std::string& text) {
+    const Point center = command.frame.center();
+    _stream << "<text x=\"";
+    writeNumber(center.x);
+    _stream << "\" y=\"";
+    writeNumber(center.y);
+    _stream << "\" text-anchor=\"middle\" dominant-baseline=\"central\"";
+
+    switch (command.font) {
+        case DisplayCommand::Font::Music:
+            break;
+
+        case DisplayCommand::Font::Words:
+        case DisplayCommand::Font::Lyrics:
+            _stream << " font-family=\"" << kTextFontFamily << "\" font-size=\"";
+            writeNumber(kWordsFontSize);
+            _stream << '"';
+            break;
+
+        case DisplayCommand::Font::Dynamics:
+            _stream << " font-family=\"" << kTextFontFamily << "\" font-size=\"";
+            writeNumber(kDynamicsFontSize);
+            _stream << "\" font-style=\"italic\" font-weight=\"bold\"";
+            break;
+    }
+    writeOpacity(command);
+    _stream << '>';
+
+    if (command.font == DisplayCommand::Font::Music) {
+        // Numbers in the music font, like time signatures and tuplets, use the SMuFL digits
+        for (auto c : text) {
+            if (c >= '0' && c <= '9')
+                writeCodepoint(kTimeSigDigitZero + static_cast<std::uint32_t>(c - '0'));
+        }
+    } else {
+        writeEscaped(text);
+    }
+    _stream << "</text>\n";
+}
+
+void SvgWriter::writeOpacity(const DisplayCommand& command) {
+    if (command.active)
+        return;
+    _stream << " opacity=\"";
+    writeNumber(kInactiveOpacity);
+    _stream << '"';
+}
+
+void SvgWriter::writeNumber(coord_t value) {
+    // Fixed point with at most two decimals so that the output does not depend on stream formatting state
+    long long hundredths = std::llround(static_cast<double>(value) * 100);
+    if (hundredths < 0) {
+        _stream << '-';
+        hundredths = -hundredths;
+    }
+    writeInteger(static_cast<unsigned long long>(hundredths / 100));
+
+    const auto fraction = hundredths % 100;
+    if (fraction != 0) {
+        _stream << '.' << static_cast<char>('0' + fraction / 10);
+        if (fraction % 10 != 0)
+            _stream << static_cast<char>('0' + fraction % 10);
+    }
+}
+
+void SvgWriter::writeInteger(unsigned long long value) {
+    // Digits are written by hand, the stream's locale could otherwise add digit grouping
+    char buffer[24];
+    auto end = buffer + sizeof(buffer);
+    auto begin = end;
+    do {
+        *--begin = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    _stream.write(begin, end - begin);
+}
+
+void SvgWriter::writeCodepoint(std::uint32_t codepoint) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "&#x%X;", static_cast<unsigned int>(codepoint));
+    _stream << buffer;
+}
+
+void SvgWriter::writeEscaped(const std::string& text) {
+    for (auto c : text) {
+        switch (c) {
+            case '&': _stream << "&amp;"; break;
+            case '<': _stream << "&lt;"; break;
+            case '>': _stream << "&gt;"; break;
+            case '"': _stream << "&quot;"; break;
+            case '\'': _stream << "&apos;"; break;
+            default: _stream << c; break;
+        }
+    }
+}
+
+} // namespace mxml
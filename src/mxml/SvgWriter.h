@@ -0,0 +1,68 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/geometry/DisplayList.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace mxml {
+
+class PageScoreGeometry;
+class ScrollScoreGeometry;
+
+/**
+ Writes score geometries as SVG. Elements are streamed to the output as the display list is traversed, there is no
+ intermediate document. Glyphs are written as text in a SMuFL font and numbers are rounded to two decimals, so the
+ output for a given geometry is always the same.
+ */
+class SvgWriter {
+public:
+    static const char* const kMusicFontFamily;
+    static const char* const kTextFontFamily;
+    static const coord_t kMusicFontSize;
+    static const coord_t kWordsFontSize;
+    static const coord_t kDynamicsFontSize;
+    static const coord_t kInactiveOpacity;
+
+public:
+    explicit SvgWriter(std::ostream& stream);
+
+    /**
+     Write a single page of a page geometry.
+     */
+    void writePage(const PageScoreGeometry& geometry, std::size_t pageIndex);
+    void writePage(const PageScoreGeometry& geometry, const DisplayList& displayList, std::size_t pageIndex);
+
+    /**
+     Write the horizontal range [startX, endX) of a scroll geometry, in root coordinates. Measures that intersect the
+     range are written whole and clipped by the view box.
+     */
+    void writeRange(const ScrollScoreGeometry& geometry, coord_t startX, coord_t endX);
+    void writeRange(const ScrollScoreGeometry& geometry, const DisplayList& displayList, coord_t startX, coord_t endX);
+
+private:
+    void writeChunks(const DisplayList& displayList, const std::vector<std::size_t>& chunks, const Rect& viewBox);
+    void writeCommand(const DisplayList& displayList, const DisplayCommand& command);
+    void writeGlyph(const DisplayCommand& command);
+    void writeLine(const DisplayCommand& command);
+    void writeCurve(const DisplayCommand& command);
+    void writeText(const DisplayCommand& command, const std::string& text);
+    void writeOpacity(const DisplayCommand& command);
+
+    void writeNumber(coord_t value);
+    void writeInteger(unsigned long long value);
+    void writeCodepoint(std::uint32_t codepoint);
+    void writeEscaped(const std::string& text);
+
+private:
+    std::ostream& _stream;
+};
+
+} // namespace mxml
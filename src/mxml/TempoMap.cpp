@@ -0,0 +1,124 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TempoMap.h"
+
+#include <stdexcept>
+
+
+namespace mxml {
+
+TempoMap::TempoMap(const ScoreProperties& scoreProperties) {
+    const auto measureCount = scoreProperties.measureCount();
+    std::vector<dom::time_t> measureDurations(measureCount);
+    for (std::size_t measureIndex = 0; measureIndex < measureCount; measureIndex += 1)
+        measureDurations[measureIndex] = scoreProperties.divisionsPerMeasure(measureIndex);
+
+    build(scoreProperties, scoreProperties.playbackOrder(0, measureCount), measureDurations);
+}
+
+TempoMap::TempoMap(const ScoreProperties& scoreProperties, const std::vector<std::size_t>& playbackOrder, const std::vector<dom::time_t>& measureDurations) {
+    build(scoreProperties, playbackOrder, measureDurations);
+}
+
+void TempoMap::build(const ScoreProperties& scoreProperties, const std::vector<std::size_t>& playbackOrder, const std::vector<dom::time_t>& measureDurations) {
+    _measures.reserve(playbackOrder.size());
+    _occurrences.resize(measureDurations.size());
+
+    dom::time_t start = 0;
+    for (auto measureIndex : playbackOrder) {
+        const auto duration = measureDurations.at(measureIndex);
+        _occurrences[measureIndex].push_back(_measures.size());
+        _measures.push_back(Measure{measureIndex, start, duration});
+
+        if (duration > 0) {
+            const auto divisionsPerBeat = scoreProperties.divisionsPerBeat(measureIndex);
+            addSegment(start, 60.0 / (divisionsPerBeat * scoreProperties.tempo(measureIndex, 0)));
+            for (auto time : scoreProperties.tempoChanges(measureIndex)) {
+                if (time > 0 && time < duration)
+                    addSegment(start + time, 60.0 / (divisionsPerBeat * scoreProperties.tempo(measureIndex, time)));
+            }
+        }
+
+        start += duration;
+    }
+
+    if (_segments.empty())
+        _segments.push_back(Segment{0, 0.0, 1.0});
+}
+
+void TempoMap::addSegment(dom::time_t start, double secondsPerDivision) {
+    if (_segments.empty()) {
+        _segments.push_back(Segment{start, 0.0, secondsPerDivision});
+        return;
+    }
+
+    auto& last = _segments.back();
+    if (last.secondsPerDivision == secondsPerDivision)
+        return;
+    if (last.start == start) {
+        last.secondsPerDivision = secondsPerDivision;
+        return;
+    }
+    _segments.push_back(Segment{start, wallTime(last, start), secondsPerDivision});
+}
+
+double TempoMap::wallTime(double absoluteTime) const {
+    auto it = std::upper_bound(_segments.begin(), _segments.end(), absoluteTime, [](double time, const Segment& segment) {
+        return time < segment.start;
+    });
+    if (it != _segments.begin())
+        --it;
+    return wallTime(*it, absoluteTime);
+}
+
+double TempoMap::absoluteTime(double wallTime) const {
+    auto it = std::upper_bound(_segments.begin(), _segments.end(), wallTime, [](double time, const Segment& segment) {
+        return time < segment.wallTime;
+    });
+    if (it != _segments.begin())
+        --it;
+    return absoluteTime(*it, wallTime);
+}
+
+dom::time_t TempoMap::absoluteTime(MeasureLocation location, std::size_t occurrence) const {
+    const auto index = _occurrences.at(location.measureIndex).at(occurrence);
+    return _measures[index].start + location.division;
+}
+
+MeasureLocation TempoMap::measureLocation(dom::time_t absoluteTime) const {
+    auto it = std::upper_bound(_measures.begin(), _measures.end(), absoluteTime, [](dom::time_t time, const Measure& measure) {
+        return time < measure.start;
+    });
+    if (it != _measures.begin())
+        --it;
+    return measureLocation(std::distance(_measures.begin(), it), absoluteTime);
+}
+
+MeasureLocation TempoMap::measureLocation(std::size_t index, dom::time_t absoluteTime) const {
+    MeasureLocation location;
+    if (_measures.empty()) {
+        location.division = absoluteTime;
+        return location;
+    }
+
+    // Prefer the first measure starting at the given time over empty measures before it
+    while (index + 1 < _measures.size() && _measures[index + 1].start == _measures[index].start && _measures[index].duration == 0)
+        index += 1;
+
+    auto& measure = _measures[index];
+    location.measureIndex = measure.measureIndex;
+    location.division = absoluteTime - measure.start;
+    return location;
+}
+
+std::size_t TempoMap::occurrenceCount(std::size_t measureIndex) const {
+    if (measureIndex >= _occurrences.size())
+        return 0;
+    return _occurrences[measureIndex].size();
+}
+
+} // namespace mxml
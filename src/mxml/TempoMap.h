@@ -0,0 +1,151 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "Event.h"
+#include "ScoreProperties.h"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Piecewise-linear mapping between wall time in seconds, absolute time in divisions and measure locations, for the
+ measures of a score in playback order. Absolute time 0 corresponds to wall time 0.
+ */
+class TempoMap {
+public:
+    /**
+     A measure in playback order.
+     */
+    struct Measure {
+        std::size_t measureIndex;
+        dom::time_t start;
+        dom::time_t duration;
+    };
+
+    /**
+     A span of absolute time with a constant tempo.
+     */
+    struct Segment {
+        dom::time_t start;
+        double wallTime;
+        double secondsPerDivision;
+    };
+
+public:
+    /**
+     Build a tempo map for the whole score using the nominal duration of every measure.
+     */
+    explicit TempoMap(const ScoreProperties& scoreProperties);
+
+    /**
+     Build a tempo map for the given playback order.
+
+     @param playbackOrder    The measure indices in playback order
+     @param measureDurations The played duration of every measure, indexed by measure index
+     */
+    TempoMap(const ScoreProperties& scoreProperties, const std::vector<std::size_t>& playbackOrder, const std::vector<dom::time_t>& measureDurations);
+
+    const std::vector<Measure>& measures() const {
+        return _measures;
+    }
+
+    const std::vector<Segment>& segments() const {
+        return _segments;
+    }
+
+    /**
+     Get the wall time in seconds for the given absolute time. Times outside of the map are extrapolated.
+     */
+    double wallTime(double absoluteTime) const;
+
+    /**
+     Get the absolute time for the given wall time in seconds. Times outside of the map are extrapolated.
+     */
+    double absoluteTime(double wallTime) const;
+
+    /**
+     Get the absolute time of a measure location. A measure can be played more than once, `occurrence` selects which
+     time. Throws `std::out_of_range` if the measure is not played that many times.
+     */
+    dom::time_t absoluteTime(MeasureLocation location, std::size_t occurrence = 0) const;
+
+    /**
+     Get the measure location for the given absolute time.
+     */
+    MeasureLocation measureLocation(dom::time_t absoluteTime) const;
+
+    /**
+     Get the number of times the given measure is played.
+     */
+    std::size_t occurrenceCount(std::size_t measureIndex) const;
+
+    /**
+     Convert a sorted sequence of absolute times to wall times in a single pass.
+     */
+    template <typename InputIterator, typename OutputIterator>
+    void wallTimes(InputIterator begin, const InputIterator end, OutputIterator output) const {
+        std::size_t index = 0;
+        for (; begin != end; ++begin, ++output) {
+            const double time = *begin;
+            while (index + 1 < _segments.size() && _segments[index + 1].start <= time)
+                index += 1;
+            *output = wallTime(_segments[index], time);
+        }
+    }
+
+    /**
+     Convert a sorted sequence of wall times to absolute times in a single pass.
+     */
+    template <typename InputIterator, typename OutputIterator>
+    void absoluteTimes(InputIterator begin, const InputIterator end, OutputIterator output) const {
+        std::size_t index = 0;
+        for (; begin != end; ++begin, ++output) {
+            const double time = *begin;
+            while (index + 1 < _segments.size() && _segments[index + 1].wallTime <= time)
+                index += 1;
+            *output = absoluteTime(_segments[index], time);
+        }
+    }
+
+    /**
+     Convert a sorted sequence of absolute times to measure locations in a single pass.
+     */
+    template <typename InputIterator, typename OutputIterator>
+    void measureLocations(InputIterator begin, const InputIterator end, OutputIterator output) const {
+        std::size_t index = 0;
+        for (; begin != end; ++begin, ++output) {
+            const dom::time_t time = *begin;
+            while (index + 1 < _measures.size() && _measures[index + 1].start <= time)
+                index += 1;
+            *output = measureLocation(index, time);
+        }
+    }
+
+private:
+    void build(const ScoreProperties& scoreProperties, const std::vector<std::size_t>& playbackOrder, const std::vector<dom::time_t>& measureDurations);
+    void addSegment(dom::time_t start, double secondsPerDivision);
+
+    static double wallTime(const Segment& segment, double absoluteTime) {
+        return segment.wallTime + (absoluteTime - segment.start) * segment.secondsPerDivision;
+    }
+    static double absoluteTime(const Segment& segment, double wallTime) {
+        return segment.start + (wallTime - segment.wallTime) / segment.secondsPerDivision;
+    }
+    MeasureLocation measureLocation(std::size_t index, dom::time_t absoluteTime) const;
+
+private:
+    std::vector<Measure> _measures;
+    std::vector<Segment> _segments;
+
+    /// Indices into `_measures` for every measure index, in playback order
+    std::vector<std::vector<std::size_t>> _occurrences;
+};
+
+} // namespace mxml
@@ -0,0 +1,129 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TieIndex.h"
+
+#include <mxml/dom/Chord.h>
+#include <mxml/dom/Score.h>
+
+#include <algorithm>
+#include <functional>
+
+
+namespace mxml {
+
+const std::uint32_t TieIndex::kNone;
+
+namespace {
+
+std::uint64_t location(std::size_t partIndex, std::size_t measureIndex) {
+    return static_cast<std::uint64_t>(partIndex) << 32 | static_cast<std::uint64_t>(measureIndex);
+}
+
+} // namespace
+
+TieIndex::TieIndex(const dom::Score& score) {
+    for (auto& part : score.parts()) {
+        for (auto& measure : part->measures()) {
+            for (auto& node : measure->nodes()) {
+                if (auto chord = dom::nodeCast<dom::Chord>(node.get()))
+                    addChord(part->index(), measure->index(), *chord);
+            }
+        }
+    }
+    finish();
+}
+
+void TieIndex::addChord(std::size_t partIndex, std::size_t measureIndex, const dom::Chord& chord) {
+    // Match the chords that get a geometry
+    if (!chord.firstNote() || !chord.firstNote()->printObject)
+        return;
+
+    for (auto& note : chord.notes()) {
+        auto notations = note->notations.get();
+        if (!notations)
+            continue;
+
+        // A continued tie replaces the open tie without closing it
+        auto pitch = note->pitch.get();
+        for (auto& tie : notations->ties) {
+            if (!pitch || tie->type() == dom::kChange)
+                continue;
+            const int value = static_cast<int>(pitch->step()) * static_cast<int>(dom::Pitch::kOctaveCount) + pitch->octave();
+            const bool stop = tie->type() == dom::kStop;
+            add(partIndex, measureIndex, *note, Kind::Tie, tie->placement(), value, stop, !stop);
+        }
+
+        for (auto& slur : notations->slurs) {
+            if (slur->type() == dom::kChange)
+                continue;
+            const bool stop = slur->type() == dom::kStop || slur->type() == dom::kContinue;
+            const bool start = slur->type() == dom::kStart || slur->type() == dom::kContinue;
+            add(partIndex, measureIndex, *note, Kind::Slur, slur->placement(), slur->number(), stop, start);
+        }
+    }
+}
+
+void TieIndex::add(std::size_t partIndex, std::size_t measureIndex, const dom::Note& note, Kind kind, dom::Placement placement, int value, bool stop, bool start) {
+    const auto index = static_cast<std::uint32_t>(_notes.size());
+    _notes.push_back(&note);
+    _locations.push_back(location(partIndex, measureIndex));
+    _kinds.push_back(kind);
+    _placements.push_back(placement);
+    _stops.push_back(stop);
+    _starts.push_back(start);
+    _partners.push_back(kNone);
+    _nexts.push_back(kNone);
+    _keys.push_back({note.staff(), value});
+
+    const Key key{partIndex, kind, note.staff(), value};
+    auto it = _open.find(key);
+    if (it != _open.end()) {
+        _nexts[it->second] = index;
+        if (stop)
+            _partners[index] = it->second;
+    }
+
+    if (start) {
+        if (it != _open.end())
+            it->second = index;
+        else
+            _open.emplace(key, index);
+    } else if (it != _open.end()) {
+        _open.erase(it);
+    }
+}
+
+void TieIndex::finish() {
+    std::unordered_map<Key, std::uint32_t, KeyHash>().swap(_open);
+}
+
+std::pair<std::size_t, std::size_t> TieIndex::range(std::size_t partIndex, std::size_t beginMeasure, std::size_t endMeasure) const {
+    auto begin = std::lower_bound(_locations.begin(), _locations.end(), location(partIndex, beginMeasure));
+    auto end = std::lower_bound(begin, _locations.end(), location(partIndex, endMeasure));
+    return {static_cast<std::size_t>(begin - _locations.begin()), static_cast<std::size_t>(end - _locations.begin())};
+}
+
+void TieIndex::clear() {
+    _notes.clear();
+    _locations.clear();
+    _kinds.clear();
+    _placements.clear();
+    _stops.clear();
+    _starts.clear();
+    _partners.clear();
+    _nexts.clear();
+    _keys.clear();
+    _open.clear();
+}
+
+std::size_t TieIndex::KeyHash::operator()(const Key& key) const {
+    std::size_t hash = std::hash<std::size_t>()(key.partIndex);
+    hash ^= (static_cast<std::size_t>(key.value) << 10 | static_cast<std::size_t>(key.staff) << 1 | static_cast<std::size_t>(key.kind)) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+} // namespace mxml
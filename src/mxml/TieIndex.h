@@ -0,0 +1,142 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/dom/Types.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace mxml {
+
+namespace dom {
+    class Chord;
+    class Note;
+    class Score;
+}
+
+/**
+ A flat index of every tie and slur in a score, in score order, with starts and stops already paired. Ties are paired
+ by part, staff and pitch (step and octave), slurs by part, staff and number.
+
+ Each entry is a tie or slur event on a note. A stop event records the start it closes, if any. A start event records
+ the next event with the same key, which is either the stop that closes it or a later start that replaces it. This is
+ enough to lay out any range of measures without searching: a stop is paired if its start is in the range and comes
+ from the edge otherwise, and a start goes to the edge if nothing in the range follows it.
+ */
+class TieIndex {
+public:
+    static const std::uint32_t kNone = static_cast<std::uint32_t>(-1);
+
+    enum class Kind : std::uint8_t {
+        Tie,
+        Slur
+    };
+
+public:
+    TieIndex() = default;
+
+    /**
+     Build the index for a whole score.
+     */
+    explicit TieIndex(const dom::Score& score);
+
+    /**
+     Append the ties and slurs of a chord's notes. Chords have to be added in score order. Chords that are not
+     displayed are skipped.
+     */
+    void addChord(std::size_t partIndex, std::size_t measureIndex, const dom::Chord& chord);
+
+    /**
+     Release the table of open ties and slurs once every chord has been added. Chords added afterwards are not paired
+     with earlier ones.
+     */
+    void finish();
+
+    void clear();
+
+    /// The number of tie and slur events
+    std::size_t size() const {
+        return _notes.size();
+    }
+
+    /**
+     Get the range of events in `[beginMeasure, endMeasure)` for a part.
+     */
+    std::pair<std::size_t, std::size_t> range(std::size_t partIndex, std::size_t beginMeasure, std::size_t endMeasure) const;
+
+    const std::vector<const dom::Note*>& notes() const {
+        return _notes;
+    }
+    const std::vector<Kind>& kinds() const {
+        return _kinds;
+    }
+    const std::vector<dom::Placement>& placements() const {
+        return _placements;
+    }
+
+    /// Whether the event closes an open tie or slur
+    const std::vector<std::uint8_t>& stops() const {
+        return _stops;
+    }
+
+    /// Whether the event opens a tie or slur
+    const std::vector<std::uint8_t>& starts() const {
+        return _starts;
+    }
+
+    /// For stop events, the index of the start event being closed or `kNone`
+    const std::vector<std::uint32_t>& partners() const {
+        return _partners;
+    }
+
+    /// For start events, the index of the next event with the same key or `kNone`
+    const std::vector<std::uint32_t>& nexts() const {
+        return _nexts;
+    }
+
+    /// The staff and the pitch or slur number of each event, in the order used for unfinished ties and slurs
+    const std::vector<std::pair<int, int>>& keys() const {
+        return _keys;
+    }
+
+private:
+    struct Key {
+        std::size_t partIndex;
+        Kind kind;
+        int staff;
+        int value;
+
+        bool operator==(const Key& rhs) const {
+            return partIndex == rhs.partIndex && kind == rhs.kind && staff == rhs.staff && value == rhs.value;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    void add(std::size_t partIndex, std::size_t measureIndex, const dom::Note& note, Kind kind, dom::Placement placement, int value, bool stop, bool start);
+
+private:
+    std::vector<const dom::Note*> _notes;
+    std::vector<std::uint64_t> _locations;
+    std::vector<Kind> _kinds;
+    std::vector<dom::Placement> _placements;
+    std::vector<std::uint8_t> _stops;
+    std::vector<std::uint8_t> _starts;
+    std::vector<std::uint32_t> _partners;
+    std::vector<std::uint32_t> _nexts;
+    std::vector<std::pair<int, int>> _keys;
+
+    /// The last start event of each key that has not been closed yet
+    std::unordered_map<Key, std::uint32_t, KeyHash> _open;
+};
+
+} // namespace mxml
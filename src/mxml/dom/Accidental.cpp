@@ -18,15 +18,23 @@ Accidental::Type Accidental::Type::Sharp{1, "sharp"};
 Accidental::Type Accidental::Type::DoubleSharp{2, "double-sharp"};
 
 Accidental::Type* Accidental::Type::byName(const char* name) noexcept {
-    if (strcmp(name, DoubleFlat.name) == 0 || strcmp(name, "flat-flat") == 0)
+    return byName(name, strlen(name));
+}
+
+Accidental::Type* Accidental::Type::byName(const char* name, std::size_t length) noexcept {
+    auto equals = [name, length](const char* string) {
+        return strlen(string) == length && strncmp(name, string, length) == 0;
+    };
+
+    if (equals(DoubleFlat.name) || equals("flat-flat"))
         return &DoubleFlat;
-    if (strcmp(name, Flat.name) == 0)
+    if (equals(Flat.name))
         return &Flat;
-    if (strcmp(name, Natural.name) == 0)
+    if (equals(Natural.name))
         return &Natural;
-    if (strcmp(name, Sharp.name) == 0)
+    if (equals(Sharp.name))
         return &Sharp;
-    if (strcmp(name, DoubleSharp.name) == 0 || strcmp(name, "sharp-sharp") == 0)
+    if (equals(DoubleSharp.name) || equals("sharp-sharp"))
         return &DoubleSharp;
     return nullptr;
 }
@@ -30,6 +30,7 @@ public:
         static Type DoubleSharp;
 
         static Type* byName(const char* name) noexcept;
+        static Type* byName(const char* name, std::size_t length) noexcept;
         static Type* byAlter(int alter) noexcept;
         
         constexpr operator int() const { return alter; }
@@ -20,7 +20,11 @@ namespace dom {
 
 class Attributes : public Node {
 public:
-    Attributes() : _divisions(1), _staves(1), _clefs(1), _keys(1), _time(), _start() {}
+        static bool classof(const Node& node) {
+        return node.kind() == Kind::Attributes;
+    }
+
+    Attributes() : Node(Kind::Attributes), _divisions(1), _staves(1), _clefs(1), _keys(1), _time(), _start() {}
     
     Optional<int> divisions() const {
         return _divisions;
@@ -11,6 +11,12 @@ namespace mxml {
 namespace dom {
 
 class Backup : public TimedNode {
+public:
+    Backup() : TimedNode(Kind::Backup) {}
+
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Backup;
+    }
 };
 
 } // namespace dom
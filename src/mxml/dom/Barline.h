@@ -36,7 +36,11 @@ public:
     };
     
 public:
-    Barline() : _style(Style::Regular), _location(Location::Middle), _ending(), _repeat() {}
+        static bool classof(const Node& node) {
+        return node.kind() == Kind::Barline;
+    }
+
+    Barline() : Node(Kind::Barline), _style(Style::Regular), _location(Location::Middle), _ending(), _repeat() {}
     
     Style style() const {
         return _style;
@@ -7,6 +7,9 @@
 #pragma once
 #include "Node.h"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace mxml {
 namespace dom {
 
@@ -21,6 +24,9 @@ public:
     };
     
 public:
+    Beam() : _number(1), _type(Type::Begin) {}
+    Beam(int number, Type type) : _number(number), _type(type) {}
+
     int number() const {
         return _number;
     }
@@ -40,5 +46,47 @@ private:
     Type _type;
 };
 
+/**
+ The beams of a note, stored inline as bytes. MusicXML allows at most eight beams per note, additional beams are
+ ignored. Beams are returned by value.
+ */
+class BeamList {
+public:
+    static const std::size_t kMaxBeams = 8;
+
+public:
+    BeamList() : _size(0), _numbers(), _types() {}
+
+    std::size_t size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    Beam operator[](std::size_t index) const {
+        return Beam(_numbers[index], static_cast<Beam::Type>(_types[index]));
+    }
+    Beam front() const {
+        return operator[](0);
+    }
+    Beam back() const {
+        return operator[](_size - 1);
+    }
+
+    void push_back(const Beam& beam) {
+        if (_size == kMaxBeams)
+            return;
+        _numbers[_size] = static_cast<std::uint8_t>(beam.number());
+        _types[_size] = static_cast<std::uint8_t>(beam.type());
+        _size += 1;
+    }
+
+private:
+    std::uint8_t _size;
+    std::uint8_t _numbers[kMaxBeams];
+    std::uint8_t _types[kMaxBeams];
+};
+
 } // namespace dom
 } // namespace mxml
@@ -14,7 +14,11 @@ namespace mxml {
         
         class Bracket : public DirectionType {
         public:
-            Bracket() : _type(kStart), _line(false), _sign(true) {}
+            static bool classof(const Node& node) {
+                return node.kind() == Kind::Bracket;
+            }
+
+            Bracket() : DirectionType(Kind::Bracket), _type(kStart), _line(false), _sign(true) {}
             
             bool span() const {
                 return true;
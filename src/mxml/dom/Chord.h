@@ -16,7 +16,11 @@ namespace dom {
 
 class Chord : public TimedNode {
 public:
-    Chord() {}
+    Chord() : TimedNode(Kind::Chord) {}
+
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Chord;
+    }
     
     bool empty() const {
         return _notes.empty();
@@ -36,26 +40,26 @@ public:
         return firstNote()->stem();
     }
     
-    const std::vector<std::unique_ptr<Beam>>& beams() const {
+    const BeamList& beams() const {
         return firstNote()->beams();
     }
     
     bool isBeamStart() const {
         if (_notes.empty() || firstNote()->beams().empty())
             return false;
-        return firstNote()->beams().front()->type() == Beam::Type::Begin;
+        return firstNote()->beams().front().type() == Beam::Type::Begin;
     }
     
     bool isBeamContinue() const {
         if (_notes.empty() || firstNote()->beams().empty())
             return false;
-        return firstNote()->beams().front()->type() == Beam::Type::Continue;
+        return firstNote()->beams().front().type() == Beam::Type::Continue;
     }
     
     bool isBeamEnd() const {
         if (_notes.empty() || firstNote()->beams().empty())
             return false;
-        return firstNote()->beams().front()->type() == Beam::Type::End;
+        return firstNote()->beams().front().type() == Beam::Type::End;
     }
     
     bool hasBeam() const {
@@ -16,7 +16,11 @@ namespace dom {
 
 class Direction : public Node {
 public:
-    Direction() : _placement(absentOptional(Placement::Above)), _type(), _staff(1), _start(0), _offset() {}
+        static bool classof(const Node& node) {
+        return node.kind() == Kind::Direction;
+    }
+
+    Direction() : Node(Kind::Direction), _placement(absentOptional(Placement::Above)), _type(), _staff(1), _start(0), _offset() {}
     
     Optional<Placement> placement() const {
         return _placement;
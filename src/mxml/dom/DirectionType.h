@@ -16,7 +16,10 @@ namespace dom {
 
 class DirectionType : public Node {
 public:
-    DirectionType() = default;
+    static bool classof(const Node& node) {
+        return node.kind() >= Kind::Bracket && node.kind() <= Kind::Words;
+    }
+
     virtual ~DirectionType() = default;
     
     /** Return true if this direction type has start and stop elements. */
@@ -24,10 +27,19 @@ public:
     
 public:
     Position position;
+
+protected:
+    explicit DirectionType(Kind kind) : Node(kind) {}
 };
 
 class Dynamics : public DirectionType {
 public:
+    Dynamics() : DirectionType(Kind::Dynamics) {}
+
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Dynamics;
+    }
+
     const std::string& string() const {
         return _string;
     }
@@ -45,6 +57,12 @@ private:
 
 class Words : public DirectionType {
 public:
+    Words() : DirectionType(Kind::Words) {}
+
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Words;
+    }
+
     const std::string& contents() const {
         return _contents;
     }
@@ -62,6 +80,12 @@ private:
 
 class Segno : public DirectionType {
 public:
+    Segno() : DirectionType(Kind::Segno) {}
+
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Segno;
+    }
+
     bool span() const {
         return false;
     }
@@ -69,6 +93,12 @@ public:
 
 class Coda : public DirectionType {
 public:
+    Coda() : DirectionType(Kind::Coda) {}
+
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Coda;
+    }
+
     bool span() const {
         return false;
     }
@@ -11,6 +11,12 @@ namespace mxml {
 namespace dom {
 
 class Forward : public TimedNode {
+public:
+    Forward() : TimedNode(Kind::Forward) {}
+
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Forward;
+    }
 };
 
 } // namespace dom
@@ -0,0 +1,94 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace mxml {
+namespace dom {
+
+/**
+ An optional element stored inline that reads like a `std::unique_ptr`. This lets a member that used to be allocated
+ separately live inside its owner without changing the code that uses it: it can be tested, dereferenced and assigned
+ a `std::unique_ptr`, whose value is moved in. Pointers to the value are only valid while it is present.
+ */
+template <typename T>
+class InlinePtr {
+public:
+    InlinePtr() : _value(), _present(false) {}
+
+    // Not copyable, like std::unique_ptr, so that code reading the value can't copy it by mistake
+    InlinePtr(const InlinePtr&) = delete;
+    InlinePtr& operator=(const InlinePtr&) = delete;
+    InlinePtr(InlinePtr&&) = default;
+    InlinePtr& operator=(InlinePtr&&) = default;
+
+    InlinePtr& operator=(std::unique_ptr<T> pointer) {
+        if (pointer) {
+            _value = std::move(*pointer);
+            _present = true;
+        } else {
+            reset();
+        }
+        return *this;
+    }
+    InlinePtr& operator=(const T& value) {
+        _value = value;
+        _present = true;
+        return *this;
+    }
+    InlinePtr& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    void reset() {
+        _value = T();
+        _present = false;
+    }
+
+    const T* get() const {
+        return _present ? &_value : nullptr;
+    }
+    T* get() {
+        return _present ? &_value : nullptr;
+    }
+
+    const T* operator->() const {
+        return &_value;
+    }
+    T* operator->() {
+        return &_value;
+    }
+    const T& operator*() const {
+        return _value;
+    }
+    T& operator*() {
+        return _value;
+    }
+
+    explicit operator bool() const {
+        return _present;
+    }
+
+private:
+    T _value;
+    bool _present;
+};
+
+template <typename T>
+bool operator==(const InlinePtr<T>& pointer, std::nullptr_t) {
+    return !pointer;
+}
+template <typename T>
+bool operator!=(const InlinePtr<T>& pointer, std::nullptr_t) {
+    return static_cast<bool>(pointer);
+}
+
+} // namespace dom
+} // namespace mxml
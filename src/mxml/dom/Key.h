@@ -28,8 +28,12 @@ public:
     };
     
 public:
-    Key() : _number(1), _printObject(true), _cancel(), _fifths(), _mode(Mode::Major) {}
-    Key(const Key& rhs) : _number(rhs.number()), _printObject(rhs.printObject()), _cancel(rhs.cancel()), _fifths(rhs.fifths()), _mode(rhs.mode()) {}
+        static bool classof(const Node& node) {
+        return node.kind() == Kind::Key;
+    }
+
+    Key() : Node(Kind::Key), _number(1), _printObject(true), _cancel(), _fifths(), _mode(Mode::Major) {}
+    Key(const Key& rhs) : Node(rhs), _number(rhs.number()), _printObject(rhs.printObject()), _cancel(rhs.cancel()), _fifths(rhs.fifths()), _mode(rhs.mode()) {}
     
     int number() const {
         return _number;
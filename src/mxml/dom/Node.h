@@ -5,15 +5,51 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
+#include <cstdint>
 
 namespace mxml {
 namespace dom {
 
 class Node {
 public:
-    Node() : _parent() {}
+    /**
+     Concrete node type, used to dispatch on nodes without RTTI. Subclasses of TimedNode and DirectionType occupy
+     contiguous ranges so that the intermediate types can be tested with a range check.
+     */
+    enum class Kind : std::uint8_t {
+        Other,
+        Attributes,
+        Barline,
+        Clef,
+        Direction,
+        Key,
+        Print,
+        Sound,
+        Time,
+
+        Backup,
+        Chord,
+        Forward,
+        Note,
+
+        Bracket,
+        Coda,
+        Dynamics,
+        OctaveShift,
+        Pedal,
+        Segno,
+        Wedge,
+        Words,
+    };
+
+public:
+    explicit Node(Kind kind = Kind::Other) : _parent(), _kind(kind) {}
     virtual ~Node() {}
-    
+
+    Kind kind() const {
+        return _kind;
+    }
+
     const Node* parent() const {
         return _parent;
     }
@@ -35,7 +71,26 @@ protected:
 
 private:
     const Node* _parent;
+    Kind _kind;
 };
 
+/**
+ Cast a node to a concrete type `T` if the node's kind matches, otherwise return `nullptr`. `T` must provide a static
+ `classof(const Node&)` predicate. Use this instead of `dynamic_cast` on hot paths.
+ */
+template <typename T>
+const T* nodeCast(const Node* node) {
+    if (node && T::classof(*node))
+        return static_cast<const T*>(node);
+    return nullptr;
+}
+
+template <typename T>
+T* nodeCast(Node* node) {
+    if (node && T::classof(*node))
+        return static_cast<T*>(node);
+    return nullptr;
+}
+
 } // namespace dom
 } // namespace mxml
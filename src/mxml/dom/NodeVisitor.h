@@ -0,0 +1,65 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "Attributes.h"
+#include "Backup.h"
+#include "Barline.h"
+#include "Bracket.h"
+#include "Chord.h"
+#include "Clef.h"
+#include "Direction.h"
+#include "DirectionType.h"
+#include "Forward.h"
+#include "Key.h"
+#include "Note.h"
+#include "OctaveShift.h"
+#include "Pedal.h"
+#include "Print.h"
+#include "Sound.h"
+#include "Time.h"
+#include "Wedge.h"
+
+namespace mxml {
+namespace dom {
+
+/**
+ Call `visitor` with `node` downcast to its concrete type, selected with a switch on the node's kind. The visitor
+ should provide call operators for the types it is interested in and a `const Node&` overload for everything else;
+ intermediate types such as `const TimedNode&` work as well through normal overload resolution.
+ */
+template <typename Visitor>
+void visit(const Node& node, Visitor&& visitor) {
+    switch (node.kind()) {
+        case Node::Kind::Attributes: visitor(static_cast<const Attributes&>(node)); break;
+        case Node::Kind::Barline: visitor(static_cast<const Barline&>(node)); break;
+        case Node::Kind::Clef: visitor(static_cast<const Clef&>(node)); break;
+        case Node::Kind::Direction: visitor(static_cast<const Direction&>(node)); break;
+        case Node::Kind::Key: visitor(static_cast<const Key&>(node)); break;
+        case Node::Kind::Print: visitor(static_cast<const Print&>(node)); break;
+        case Node::Kind::Sound: visitor(static_cast<const Sound&>(node)); break;
+        case Node::Kind::Time: visitor(static_cast<const Time&>(node)); break;
+
+        case Node::Kind::Backup: visitor(static_cast<const Backup&>(node)); break;
+        case Node::Kind::Chord: visitor(static_cast<const Chord&>(node)); break;
+        case Node::Kind::Forward: visitor(static_cast<const Forward&>(node)); break;
+        case Node::Kind::Note: visitor(static_cast<const Note&>(node)); break;
+
+        case Node::Kind::Bracket: visitor(static_cast<const Bracket&>(node)); break;
+        case Node::Kind::Coda: visitor(static_cast<const Coda&>(node)); break;
+        case Node::Kind::Dynamics: visitor(static_cast<const Dynamics&>(node)); break;
+        case Node::Kind::OctaveShift: visitor(static_cast<const OctaveShift&>(node)); break;
+        case Node::Kind::Pedal: visitor(static_cast<const Pedal&>(node)); break;
+        case Node::Kind::Segno: visitor(static_cast<const Segno&>(node)); break;
+        case Node::Kind::Wedge: visitor(static_cast<const Wedge&>(node)); break;
+        case Node::Kind::Words: visitor(static_cast<const Words&>(node)); break;
+
+        case Node::Kind::Other: visitor(node); break;
+    }
+}
+
+} // namespace dom
+} // namespace mxml
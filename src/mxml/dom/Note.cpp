@@ -13,6 +13,37 @@
 namespace mxml {
 namespace dom {
 
+const std::size_t BeamList::kMaxBeams;
+
+void Note::setVoice(const std::string& voice) {
+    if (voice.empty()) {
+        _voice = &emptyVoice();
+        return;
+    }
+
+    auto& extras = this->extras();
+    extras.voice = voice;
+    _voice = &extras.voice;
+}
+
+void Note::setVoice(const std::string& voice, VoiceTable& voices) {
+    if (voice.empty()) {
+        _voice = &emptyVoice();
+        return;
+    }
+    _voice = &voices.intern(voice);
+}
+
+const std::string& Note::emptyVoice() {
+    static const std::string empty;
+    return empty;
+}
+
+const std::vector<std::unique_ptr<Lyric>>& Note::emptyLyrics() {
+    static const std::vector<std::unique_ptr<Lyric>> empty;
+    return empty;
+}
+
 unsigned int Note::midiNumber() const {
     unsigned int number = 0;
     if (!pitch)
@@ -10,6 +10,7 @@
 #include "Beam.h"
 #include "EmptyPlacement.h"
 #include "Fermata.h"
+#include "InlinePtr.h"
 #include "Lyric.h"
 #include "Node.h"
 #include "Notations.h"
@@ -24,6 +25,7 @@
 #include "TimedNode.h"
 #include "Types.h"
 #include "Unpitched.h"
+#include "VoiceTable.h"
 
 #include <memory>
 #include <vector>
@@ -54,13 +56,23 @@ public:
     };
     
 public:
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Note;
+    }
+
     Note()
-    : printObject(true),
+    : TimedNode(Kind::Note),
+      printObject(true),
+      _measure(),
+      _voice(&emptyVoice()),
+      _attack(),
+      _release(),
+      _staff(1),
       _type(absentOptional(Type::Quarter)),
+      _stem(Stem::Up, false),
       _chord(false),
       _grace(false),
-      _stem(Stem::Up, false),
-      _staff(1)
+      _beams()
     {}
     
     const Measure* measure() const {
@@ -106,24 +118,32 @@ public:
     }
 
     const std::string& voice() const {
-        return _voice;
-    }
-    void setVoice(const std::string& voice) {
-        _voice = voice;
+        return *_voice;
     }
+
+    /**
+     Set the voice name. The note keeps its own copy of the name, use the overload taking a `VoiceTable` to share the
+     name with the other notes of a score.
+     */
+    void setVoice(const std::string& voice);
+
+    /**
+     Set the voice name to the copy in a score's voice table. The table has to outlive the note.
+     */
+    void setVoice(const std::string& voice, VoiceTable& voices);
     
     Optional<float> dynamics() const {
-        return  _dynamics;
+        return _extras ? _extras->dynamics : Optional<float>();
     }
     void setDynamics(Optional<float> dynamics) {
-        _dynamics = dynamics;
+        extras().dynamics = dynamics;
     }
 
     Optional<float> endDynamics() const {
-        return _endDynamics;
+        return _extras ? _extras->endDynamics : Optional<float>();
     }
     void setEndDynamics(Optional<float> endDynamics) {
-        _endDynamics = endDynamics;
+        extras().endDynamics = endDynamics;
     }
 
     time_t attack() const {
@@ -140,18 +160,25 @@ public:
         _release = release;
     }
     
-    const std::vector<std::unique_ptr<Beam>>& beams() const {
+    /**
+     The beams of the note, stored inline.
+     */
+    const BeamList& beams() const {
         return _beams;
     }
+    void addBeam(const Beam& beam) {
+        _beams.push_back(beam);
+    }
     void addBeam(std::unique_ptr<Beam> beam) {
-        _beams.push_back(std::move(beam));
+        if (beam)
+            _beams.push_back(*beam);
     }
 
     const std::vector<std::unique_ptr<Lyric>>& lyrics() const {
-        return _lyrics;
+        return _extras ? _extras->lyrics : emptyLyrics();
     }
     void addLyric(std::unique_ptr<Lyric> lyric) {
-        _lyrics.push_back(std::move(lyric));
+        extras().lyrics.push_back(std::move(lyric));
     }
 
     /**
@@ -171,7 +198,9 @@ public:
     Position position;
     bool printObject;
 
-    std::unique_ptr<Pitch> pitch;
+    /// The pitch is stored inline, most notes have one
+    InlinePtr<Pitch> pitch;
+
     std::unique_ptr<Rest> rest;
     std::unique_ptr<Unpitched> unpitched;
     std::unique_ptr<Accidental> accidental;
@@ -180,23 +209,42 @@ public:
     std::unique_ptr<Notations> notations;
     std::unique_ptr<TimeModification> timeModification;
 
+private:
+    /**
+     Values that most notes don't have, allocated on first use.
+     */
+    struct Extras {
+        Optional<float> dynamics;
+        Optional<float> endDynamics;
+        std::vector<std::unique_ptr<Lyric>> lyrics;
+
+        /// The voice name of a note that is not in a voice table
+        std::string voice;
+    };
+
+    Extras& extras() {
+        if (!_extras)
+            _extras.reset(new Extras{});
+        return *_extras;
+    }
+
+    static const std::string& emptyVoice();
+    static const std::vector<std::unique_ptr<Lyric>>& emptyLyrics();
+
 private:
     const Measure* _measure;
-    
-    bool _chord;
-    bool _grace;
-    Optional<Stem> _stem;
-    int _staff;
-    std::string _voice;
+    const std::string* _voice;
+    std::unique_ptr<Extras> _extras;
 
-    Optional<Type> _type;
-    Optional<float> _dynamics;
-    Optional<float> _endDynamics;
     time_t _attack;
     time_t _release;
-    
-    std::vector<std::unique_ptr<Beam>> _beams;
-    std::vector<std::unique_ptr<Lyric>> _lyrics;
+    int _staff;
+    Optional<Type> _type;
+    Optional<Stem> _stem;
+
+    bool _chord;
+    bool _grace;
+    BeamList _beams;
 };
 
 } // namespace dom
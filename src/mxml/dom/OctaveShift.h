@@ -25,7 +25,11 @@ public:
     };
 
 public:
-    OctaveShift() : type(Type::Up), number(1), size(8)  {}
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::OctaveShift;
+    }
+
+    OctaveShift() : DirectionType(Kind::OctaveShift), type(Type::Up), number(1), size(8)  {}
 
     bool span() const {
         return true;
@@ -11,12 +11,27 @@ namespace mxml {
 namespace dom {
 
 const Measure* Part::measureWithNumber(const std::string& number) const {
-    auto it = std::find_if(_measures.begin(), _measures.end(), [number](const std::unique_ptr<Measure>& measure) {
-        return measure->number() == number;
-    });
-    if (it == _measures.end())
+    if (!_measureIndexBuilt)
+        buildMeasureIndex();
+
+    auto it = _measureIndex.find(number);
+    if (it == _measureIndex.end())
         return nullptr;
-    return it->get();
+    return it->second;
+}
+
+void Part::buildMeasureIndex() const {
+    std::lock_guard<std::mutex> lock(_measureIndexMutex);
+    if (_measureIndexBuilt)
+        return;
+
+    _measureIndex.clear();
+    _measureIndex.reserve(_measures.size());
+    for (auto& measure : _measures) {
+        // Keep the first measure when a number repeats
+        _measureIndex.emplace(measure->number(), measure.get());
+    }
+    _measureIndexBuilt = true;
 }
 
 } // namespace dom
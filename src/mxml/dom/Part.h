@@ -8,7 +8,11 @@
 #include "Measure.h"
 #include "Node.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mxml {
@@ -18,8 +22,8 @@ class Score;
 
 class Part : public Node {
 public:
-    Part() : _id(), _name(), _measures() {}
-    explicit Part(const std::string& id) : _id(id) {}
+    Part() : _id(), _name(), _measures(), _measureIndexBuilt(false) {}
+    explicit Part(const std::string& id) : _id(id), _measureIndexBuilt(false) {}
 
     /**
      The part's index. The first part has index 0.
@@ -54,16 +58,30 @@ public:
     const std::vector<std::unique_ptr<Measure>>& measures() const {
         return _measures;
     }
+
+    /**
+     Find the first measure with the given number. The lookup uses a hash index which is built on the first call, so
+     measure numbers should not change after that. Adding a measure discards the index.
+     */
     const Measure* measureWithNumber(const std::string& number) const;
+
     void addMeasure(std::unique_ptr<Measure>&& measure) {
         _measures.push_back(std::move(measure));
+        _measureIndexBuilt = false;
     }
+
+private:
+    void buildMeasureIndex() const;
     
 private:
     std::size_t _index;
     std::string _id;
     std::string _name;
     std::vector<std::unique_ptr<Measure>> _measures;
+
+    mutable std::mutex _measureIndexMutex;
+    mutable std::atomic<bool> _measureIndexBuilt;
+    mutable std::unordered_map<std::string, const Measure*> _measureIndex;
 };
 
 } // namespace dom
@@ -14,7 +14,11 @@ namespace dom {
 
 class Pedal : public DirectionType {
 public:
-    Pedal() : _type(kStart), _line(false), _sign(true) {}
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Pedal;
+    }
+
+    Pedal() : DirectionType(Kind::Pedal), _type(kStart), _line(false), _sign(true) {}
 
     bool span() const {
         return true;
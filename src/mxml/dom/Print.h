@@ -28,7 +28,11 @@ namespace dom {
  continues to take the default values from the layout included in the defaults element.
  */
 struct Print : public Node {
-    Print() : newSystem(false), newPage(false) {}
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Print;
+    }
+
+    Print() : Node(Kind::Print), newSystem(false), newPage(false) {}
 
     Optional<PageLayout> pageLayout;
     Optional<SystemLayout> systemLayout;
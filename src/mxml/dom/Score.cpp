@@ -0,0 +1,40 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Score.h"
+
+
+namespace mxml {
+namespace dom {
+
+const std::size_t Score::kNoMeasure;
+
+std::size_t Score::measureIndex(const std::string& number) const {
+    if (!_measureIndexBuilt)
+        buildMeasureIndex();
+
+    auto it = _measureIndex.find(number);
+    if (it == _measureIndex.end())
+        return kNoMeasure;
+    return it->second;
+}
+
+void Score::buildMeasureIndex() const {
+    std::lock_guard<std::mutex> lock(_measureIndexMutex);
+    if (_measureIndexBuilt)
+        return;
+
+    _measureIndex.clear();
+    for (auto& part : _parts) {
+        _measureIndex.reserve(part->measures().size());
+        for (auto& measure : part->measures())
+            _measureIndex.emplace(measure->number(), measure->index());
+    }
+    _measureIndexBuilt = true;
+}
+
+} // namespace dom
+} // namespace mxml
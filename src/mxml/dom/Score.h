@@ -10,8 +10,13 @@
 #include "Identification.h"
 #include "Node.h"
 #include "Part.h"
+#include "VoiceTable.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mxml {
@@ -19,7 +24,10 @@ namespace dom {
 
 class Score : public Node {
 public:
-    Score() : _parts() {}
+    static const std::size_t kNoMeasure = static_cast<std::size_t>(-1);
+
+public:
+    Score() : _parts(), _measureIndexBuilt(false) {}
     
     const std::unique_ptr<Identification>& identification() const {
         return _identification;
@@ -47,13 +55,46 @@ public:
     }
     void addPart(std::unique_ptr<Part> part) {
         _parts.push_back(std::move(part));
+        _measureIndexBuilt = false;
     }
-    
+
+    /**
+     The voice names of the notes in the score.
+     */
+    const VoiceTable& voices() const {
+        return _voices;
+    }
+    VoiceTable& voices() {
+        return _voices;
+    }
+
+    /**
+     Find the index of the first measure with the given number, looking at the parts in order. Measure indices are
+     shared by all parts, so the result selects the same measure in every part. Returns `kNoMeasure` if no part has a
+     measure with that number. Like `Part::measureWithNumber`, the index is built on the first call.
+     */
+    std::size_t measureIndex(const std::string& number) const;
+
+    /**
+     Find the first measure with the given number in the part at `partIndex`.
+     */
+    const Measure* measureWithNumber(std::size_t partIndex, const std::string& number) const {
+        return _parts.at(partIndex)->measureWithNumber(number);
+    }
+
+private:
+    void buildMeasureIndex() const;
+
 private:
     std::unique_ptr<Identification> _identification;
     std::unique_ptr<Defaults> _defaults;
     std::vector<std::unique_ptr<Credit>> _credits;
     std::vector<std::unique_ptr<Part>> _parts;
+    VoiceTable _voices;
+
+    mutable std::mutex _measureIndexMutex;
+    mutable std::atomic<bool> _measureIndexBuilt;
+    mutable std::unordered_map<std::string, std::size_t> _measureIndex;
 };
 
 } // namespace dom
@@ -13,6 +13,12 @@ namespace dom {
 
 class Sound : public Node {
 public:
+    Sound() : Node(Kind::Sound), dacapo(false), forwardRepeat(false), pizzicato(false) {}
+
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Sound;
+    }
+
     /**
      Tempo is expressed in quarter notes per minute. If 0, the sound-generating program should prompt the user at the
      time of compiling a sound (MIDI) file.
@@ -27,7 +27,11 @@ public:
     };
     
 public:
-    Time() : _number(1), _symbol(Symbol::Normal), _senzaMisura(), _beats(4), _beatType(4) {}
+        static bool classof(const Node& node) {
+        return node.kind() == Kind::Time;
+    }
+
+    Time() : Node(Kind::Time), _number(1), _symbol(Symbol::Normal), _senzaMisura(), _beats(4), _beatType(4) {}
     
     const Optional<int>& number() const {
         return _number;
@@ -14,7 +14,10 @@ namespace dom {
 
 class TimedNode : public Node {
 public:
-    TimedNode() : _start(), _duration() {}
+    static bool classof(const Node& node) {
+        return node.kind() >= Kind::Backup && node.kind() <= Kind::Note;
+    }
+
     virtual ~TimedNode() {}
     
     time_t start() const {
@@ -34,6 +37,9 @@ public:
         _duration = duration;
     }
     
+protected:
+    explicit TimedNode(Kind kind) : Node(kind), _start(), _duration() {}
+
 private:
     time_t _start;
     Optional<time_t> _duration;
@@ -0,0 +1,17 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "VoiceTable.h"
+
+namespace mxml {
+namespace dom {
+
+const std::string& VoiceTable::intern(const std::string& voice) {
+    return *_voices.insert(voice).first;
+}
+
+} // namespace dom
+} // namespace mxml
@@ -0,0 +1,35 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <string>
+#include <unordered_set>
+
+namespace mxml {
+namespace dom {
+
+/**
+ The voice names used in a score, each stored once. Notes point to their voice's name in the table of their score, so
+ notes in the same voice share the string.
+ */
+class VoiceTable {
+public:
+    /**
+     Get the table's copy of a voice name, adding it if needed. The returned string lives as long as the table.
+     */
+    const std::string& intern(const std::string& voice);
+
+    std::size_t size() const {
+        return _voices.size();
+    }
+
+private:
+    // Elements of an unordered set keep their address when the set grows
+    std::unordered_set<std::string> _voices;
+};
+
+} // namespace dom
+} // namespace mxml
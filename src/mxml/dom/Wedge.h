@@ -20,7 +20,11 @@ public:
     };
     
 public:
-    Wedge() : _type(), _number(1), _spread(15), _niente(false) {}
+    static bool classof(const Node& node) {
+        return node.kind() == Kind::Wedge;
+    }
+
+    Wedge() : DirectionType(Kind::Wedge), _type(), _number(1), _spread(15), _niente(false) {}
     
     bool span() const {
         return true;
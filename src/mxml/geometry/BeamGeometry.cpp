@@ -6,6 +6,7 @@
 
 #include "BeamGeometry.h"
 #include "NoteGeometry.h"
+#include <mxml/geometry/factories/BeamSolver.h>
 
 namespace mxml {
 
@@ -17,10 +18,13 @@ const coord_t BeamGeometry::kBeamLineWidth = 4;
 const coord_t BeamGeometry::kBeamLineSpacing = 2;
 const coord_t BeamGeometry::kHookLength = 8;
 
-BeamGeometry::BeamGeometry(std::vector<ChordGeometry*> chords)
+BeamGeometry::BeamGeometry(std::vector<ChordGeometry*> chords, bool layout)
 : _chords(chords), _placement()
 {
-    build();
+    if (layout) {
+        BeamSolver solver;
+        solver.solve({this});
+    }
 }
 
 coord_t BeamGeometry::slope() const {
@@ -67,119 +71,4 @@ void BeamGeometry::recomputeFrame() {
         setVerticalAnchorPointValues(0, location().y - frame.origin.y);
 }
 
-void BeamGeometry::build() {
-    if (_chords.size() <= 1)
-        return;
-
-    const ChordGeometry* first = _chords.front();
-    const ChordGeometry* last = _chords.back();
-
-    auto stemDirection = dom::Stem::Up;
-    if (first->stem())
-        stemDirection = first->stem()->stemDirection();
-
-    // Chose beam placement
-    if (stemDirection == dom::Stem::Up)
-        _placement = dom::Placement::Below;
-    else
-        _placement = dom::Placement::Above;
-
-    Point firstLocation = first->convertToGeometry(first->refNoteLocation(), first->parentGeometry());
-    Point lastLocation = last->convertToGeometry(last->refNoteLocation(), last->parentGeometry());
-
-    // Set the location to the first chord's location
-    setLocation(firstLocation);
-
-    //find the minimum and maximum y values
-    coord_t min_y = _location.y;
-    coord_t max_y = _location.y;
-    for (ChordGeometry* chordGeom : _chords) {
-        chordGeom->setShowFlags(false);
-        Point location = chordGeom->location();
-        
-        if (location.y < min_y)
-            min_y = location.y;
-
-        if (location.y > max_y)
-            max_y = location.y;
-    }
-
-    if (stemDirection == dom::Stem::Up) {
-        _beamBegin.x = firstLocation.x + NoteGeometry::kQuarterWidth/2 - kStemLineWidth;
-        _beamBegin.y = first->frame().min().y;
-    } else {
-        _beamBegin.x = firstLocation.x - NoteGeometry::kQuarterWidth/2;
-        _beamBegin.y = first->frame().max().y;
-    }
-    
-    if (last->stem()->stemDirection() == dom::Stem::Up) {
-        _beamEnd.x = lastLocation.x + NoteGeometry::kQuarterWidth/2;
-        _beamEnd.y = last->frame().min().y;
-    } else {
-        _beamEnd.x = lastLocation.x - NoteGeometry::kQuarterWidth/2 + kStemLineWidth;
-        _beamEnd.y = last->frame().max().y;
-    }
-    
-    if (_beamEnd.x == _beamBegin.x)
-        _beamEnd.x = _beamBegin.x + NoteGeometry::kQuarterWidth;
-    
-    // Cap slope
-    Point midPoint = {(_beamEnd.x + _beamBegin.x)/2, (_beamEnd.y + _beamBegin.y)/2};
-    coord_t s = slope();
-    
-    if (s > kMaxSlope) {
-        s = kMaxSlope;
-    } else if (s < -kMaxSlope) {
-        s = -kMaxSlope;
-    }
-    _beamBegin.y = midPoint.y - s * (midPoint.x - _beamBegin.x);
-    _beamEnd.y = midPoint.y - s * (midPoint.x - _beamEnd.x);
-    
-    // Move away so that stems are not too short
-    coord_t dy = 0;
-    for (ChordGeometry* chordGeom : _chords) {
-        const dom::Chord& chord = chordGeom->chord();
-        const coord_t beamsWidth = chord.firstNote()->beams().size() * (kBeamLineWidth + kBeamLineSpacing);
-
-        if (chordGeom->stem()->stemDirection() == dom::Stem::Up) {
-            coord_t beamx = chordGeom->frame().origin.x + chordGeom->size().width - kStemLineWidth/2;
-            coord_t beamy = _beamEnd.y - s * (_beamEnd.x - beamx) - kBeamLineWidth/2;
-            coord_t maxy = chordGeom->notesFrame().min().y - kMinStem - beamsWidth;
-            if (beamy > maxy)
-                dy = std::min(dy, maxy - beamy);
-        } else {
-            coord_t beamx = chordGeom->frame().origin.x + kStemLineWidth/2;
-            coord_t beamy = _beamEnd.y - s * (_beamEnd.x - beamx) + kBeamLineWidth/2;
-            coord_t miny = chordGeom->notesFrame().max().y + kMinStem + beamsWidth;
-            if (beamy < miny)
-                dy = std::max(dy, miny - beamy);
-        }
-    }
-    _beamBegin.y += dy;
-    _beamEnd.y += dy;
-    
-    // Resize chords
-    for (ChordGeometry* chordGeom : _chords) {
-        const dom::Chord& chord = chordGeom->chord();
-        const coord_t beamsWidth = (chord.firstNote()->beams().size() - 1) * (kBeamLineWidth + kBeamLineSpacing);
-
-        coord_t beamx;
-        coord_t beamy = 0;
-        if (chordGeom->stem()->stemDirection() == dom::Stem::Up) {
-            beamx = chordGeom->location().x + NoteGeometry::kQuarterWidth/2 - kStemLineWidth/2;
-            if (_placement == dom::Placement::Above)
-                beamy = -beamsWidth;
-        } else {
-            beamx = chordGeom->location().x - NoteGeometry::kQuarterWidth/2 + kStemLineWidth/2;
-            if (_placement == dom::Placement::Below)
-                beamy = beamsWidth;
-        }
-        beamy += _beamEnd.y - s * (_beamEnd.x - beamx);
-
-        chordGeom->extendStem(beamy);
-    }
-    
-    recomputeFrame();
-}
-
 } // namespace mxml
@@ -21,7 +21,11 @@ public:
     static const coord_t kHookLength;
     
 public:
-    BeamGeometry(std::vector<ChordGeometry*> chords);
+    /**
+     Create a beam for a group of chords. With `layout` the beam line is computed and the chords' stems are extended
+     right away, otherwise that is left to a `BeamSolver` which can lay out many beams together.
+     */
+    BeamGeometry(std::vector<ChordGeometry*> chords, bool layout = true);
     
     const std::vector<ChordGeometry*>& chords() const {
         return _chords;
@@ -44,15 +48,14 @@ public:
     
     void recomputeFrame();
     
-private:
-    void build();
-    
 private:
     std::vector<ChordGeometry*> _chords;
 
     dom::Placement _placement;
     Point _beamBegin;
     Point _beamEnd;
+
+    friend class BeamSolver;
 };
 
 } // namespace mxml
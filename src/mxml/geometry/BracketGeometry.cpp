@@ -24,7 +24,7 @@ namespace mxml {
         else if (stop)
             type = stop->type();
         
-        const dom::Bracket* bracket = dynamic_cast<const dom::Bracket*>(type);
+        const dom::Bracket* bracket = dom::nodeCast<dom::Bracket>(type);
         if (bracket->sign())
             size.width = std::max(size.width, kPedSize.width + kStarSize.width);
         else
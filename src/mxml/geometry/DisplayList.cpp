@@ -0,0 +1,130 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "DisplayList.h"
+
+#include <algorithm>
+
+
+namespace mxml {
+
+namespace {
+
+struct GlyphInfo {
+    const char* name;
+    std::uint32_t codepoint;
+};
+
+/// Indexed by `Glyph`, in declaration order
+const GlyphInfo kGlyphs[] = {
+    {"", 0},
+    {"noteheadDoubleWhole", 0xE0A0},
+    {"noteheadWhole", 0xE0A2},
+    {"noteheadHalf", 0xE0A3},
+    {"noteheadBlack", 0xE0A4},
+    {"augmentationDot", 0xE1E7},
+    {"accidentalDoubleFlat", 0xE264},
+    {"accidentalFlat", 0xE260},
+    {"accidentalNatural", 0xE261},
+    {"accidentalSharp", 0xE262},
+    {"accidentalDoubleSharp", 0xE263},
+    {"gClef", 0xE050},
+    {"fClef", 0xE062},
+    {"cClef", 0xE05C},
+    {"unpitchedPercussionClef1", 0xE069},
+    {"timeSigCommon", 0xE08A},
+    {"timeSigCutCommon", 0xE08B},
+    {"repeatDot", 0xE044},
+    {"restDoubleWhole", 0xE4E2},
+    {"restWhole", 0xE4E3},
+    {"restHalf", 0xE4E4},
+    {"restQuarter", 0xE4E5},
+    {"rest8th", 0xE4E6},
+    {"rest16th", 0xE4E7},
+    {"rest32nd", 0xE4E8},
+    {"rest64th", 0xE4E9},
+    {"rest128th", 0xE4EA},
+    {"flag8thUp", 0xE240},
+    {"flag8thDown", 0xE241},
+    {"flag16thUp", 0xE242},
+    {"flag16thDown", 0xE243},
+    {"flag32ndUp", 0xE244},
+    {"flag32ndDown", 0xE245},
+    {"flag64thUp", 0xE246},
+    {"flag64thDown", 0xE247},
+    {"flag128thUp", 0xE248},
+    {"flag128thDown", 0xE249},
+    {"articAccentAbove", 0xE4A0},
+    {"articAccentBelow", 0xE4A1},
+    {"articStaccatoAbove", 0xE4A2},
+    {"articStaccatoBelow", 0xE4A3},
+    {"articStaccatissimoAbove", 0xE4A6},
+    {"articStaccatissimoBelow", 0xE4A7},
+    {"articStaccatissimoWedgeAbove", 0xE4A8},
+    {"articStaccatissimoWedgeBelow", 0xE4A9},
+    {"articTenutoAbove", 0xE4A4},
+    {"articTenutoBelow", 0xE4A5},
+    {"articTenutoStaccatoAbove", 0xE4B2},
+    {"articTenutoStaccatoBelow", 0xE4B3},
+    {"articMarcatoAbove", 0xE4AC},
+    {"articMarcatoBelow", 0xE4AD},
+    {"articStressAbove", 0xE4B6},
+    {"articStressBelow", 0xE4B7},
+    {"articUnstressAbove", 0xE4B8},
+    {"articUnstressBelow", 0xE4B9},
+    {"breathMarkComma", 0xE4CE},
+    {"caesura", 0xE4D1},
+    {"fermataAbove", 0xE4C0},
+    {"fermataBelow", 0xE4C1},
+    {"ornamentTrill", 0xE566},
+    {"ornamentMordent", 0xE56D},
+    {"ornamentShortTrill", 0xE56C},
+    {"ornamentTurn", 0xE567},
+    {"ornamentTurnInverted", 0xE568},
+    {"segno", 0xE047},
+    {"coda", 0xE048},
+    {"keyboardPedalPed", 0xE650},
+    {"keyboardPedalUp", 0xE655},
+};
+static_assert(sizeof(kGlyphs) / sizeof(kGlyphs[0]) == static_cast<std::size_t>(Glyph::Count), "Every glyph needs an entry in kGlyphs");
+
+} // namespace
+
+const char* glyphName(Glyph glyph) {
+    return kGlyphs[static_cast<std::size_t>(glyph)].name;
+}
+
+std::uint32_t glyphCodepoint(Glyph glyph) {
+    return kGlyphs[static_cast<std::size_t>(glyph)].codepoint;
+}
+
+const std::size_t DisplayList::kNoChunk;
+
+std::size_t DisplayList::chunkIndex(std::size_t measureIndex) const {
+    auto it = std::lower_bound(_chunks.begin(), _chunks.end(), measureIndex, [](const Chunk& chunk, std::size_t index) {
+        return chunk.measureIndex < index;
+    });
+    if (it == _chunks.end() || it->measureIndex != measureIndex)
+        return kNoChunk;
+    return static_cast<std::size_t>(it - _chunks.begin());
+}
+
+std::vector<std::size_t> DisplayList::visibleChunks(const Rect& rect) const {
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < _chunks.size(); i += 1) {
+        if (intersect(_chunks[i].bounds, rect))
+            indices.push_back(i);
+    }
+    return indices;
+}
+
+void DisplayList::clear() {
+    _commands.clear();
+    _chunks.clear();
+    _texts.clear();
+}
+
+} // namespace mxml
@@ -0,0 +1,214 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "Point.h"
+#include "Rect.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Music symbols referenced by display commands. The names of the symbols follow SMuFL, see `glyphName`.
+ */
+enum class Glyph : std::uint16_t {
+    None,
+
+    NoteheadDoubleWhole,
+    NoteheadWhole,
+    NoteheadHalf,
+    NoteheadBlack,
+    AugmentationDot,
+
+    AccidentalDoubleFlat,
+    AccidentalFlat,
+    AccidentalNatural,
+    AccidentalSharp,
+    AccidentalDoubleSharp,
+
+    GClef,
+    FClef,
+    CClef,
+    PercussionClef,
+    TimeSigCommon,
+    TimeSigCutCommon,
+    RepeatDot,
+
+    RestDoubleWhole,
+    RestWhole,
+    RestHalf,
+    RestQuarter,
+    Rest8th,
+    Rest16th,
+    Rest32nd,
+    Rest64th,
+    Rest128th,
+
+    Flag8thUp,
+    Flag8thDown,
+    Flag16thUp,
+    Flag16thDown,
+    Flag32ndUp,
+    Flag32ndDown,
+    Flag64thUp,
+    Flag64thDown,
+    Flag128thUp,
+    Flag128thDown,
+
+    ArticAccentAbove,
+    ArticAccentBelow,
+    ArticStaccatoAbove,
+    ArticStaccatoBelow,
+    ArticStaccatissimoAbove,
+    ArticStaccatissimoBelow,
+    ArticStaccatissimoWedgeAbove,
+    ArticStaccatissimoWedgeBelow,
+    ArticTenutoAbove,
+    ArticTenutoBelow,
+    ArticTenutoStaccatoAbove,
+    ArticTenutoStaccatoBelow,
+    ArticMarcatoAbove,
+    ArticMarcatoBelow,
+    ArticStressAbove,
+    ArticStressBelow,
+    ArticUnstressAbove,
+    ArticUnstressBelow,
+    BreathMarkComma,
+    Caesura,
+
+    FermataAbove,
+    FermataBelow,
+    OrnamentTrill,
+    OrnamentMordent,
+    OrnamentShortTrill,
+    OrnamentTurn,
+    OrnamentTurnInverted,
+
+    Segno,
+    Coda,
+    KeyboardPedalPed,
+    KeyboardPedalUp,
+
+    /// The number of glyphs, not a glyph
+    Count
+};
+
+/**
+ Get the SMuFL name of a glyph, for instance "noteheadBlack". Returns an empty string for `Glyph::None`.
+ */
+const char* glyphName(Glyph glyph);
+
+/**
+ Get the code point of a glyph in SMuFL fonts such as Bravura. Returns 0 for `Glyph::None`.
+ */
+std::uint32_t glyphCodepoint(Glyph glyph);
+
+/**
+ A single draw command. All coordinates are in the coordinate system of the root geometry. Geometries only translate
+ their contents, so a command's transform is the translation to its frame plus a uniform scale, which is only
+ different from 1 for grace notes.
+ */
+struct DisplayCommand {
+    enum class Type : std::uint8_t {
+        /// Draw `glyph` with its anchor at `points[0]`, scaled by `scale`
+        Glyph,
+
+        /// Stroke a straight line from `points[0]` to `points[1]`
+        Line,
+
+        /// Stroke a cubic Bézier curve from `points[0]` to `points[3]` with control points `points[1]` and `points[2]`
+        Curve,
+
+        /// Draw the text at `textIndex` centered in `frame`
+        Text
+    };
+
+    enum class Font : std::uint8_t {
+        Music,
+        Words,
+        Dynamics,
+        Lyrics
+    };
+
+    Type type;
+    Font font;
+    Glyph glyph;
+
+    /// Inactive commands should be grayed out
+    bool active;
+
+    std::uint32_t partIndex;
+    std::uint32_t measureIndex;
+
+    /// Index into `DisplayList::texts()` for text commands
+    std::uint32_t textIndex;
+
+    coord_t scale;
+    coord_t lineWidth;
+
+    /// The area covered by the command, used for culling
+    Rect frame;
+    Point points[4];
+};
+
+/**
+ A flat list of draw commands for a score geometry, sorted by measure index. Commands in the same measure keep their
+ paint order and are grouped in a chunk, so that a renderer can skip whole measures that are not visible.
+ */
+class DisplayList {
+public:
+    static const std::size_t kNoChunk = static_cast<std::size_t>(-1);
+
+    struct Chunk {
+        std::size_t measureIndex;
+
+        /// The range of commands in the chunk, `end` is one past the last command
+        std::size_t begin;
+        std::size_t end;
+
+        /// The union of the frames of the chunk's commands
+        Rect bounds;
+    };
+
+public:
+    const std::vector<DisplayCommand>& commands() const {
+        return _commands;
+    }
+    const std::vector<Chunk>& chunks() const {
+        return _chunks;
+    }
+    const std::vector<std::string>& texts() const {
+        return _texts;
+    }
+    const std::string& text(const DisplayCommand& command) const {
+        return _texts[command.textIndex];
+    }
+
+    /**
+     Get the index of the chunk for a measure, or `kNoChunk` if the measure has no commands.
+     */
+    std::size_t chunkIndex(std::size_t measureIndex) const;
+
+    /**
+     Get the indices of the chunks whose bounds intersect a rectangle in root coordinates.
+     */
+    std::vector<std::size_t> visibleChunks(const Rect& rect) const;
+
+    void clear();
+
+private:
+    std::vector<DisplayCommand> _commands;
+    std::vector<Chunk> _chunks;
+    std::vector<std::string> _texts;
+
+    friend class DisplayListFactory;
+};
+
+} // namespace mxml
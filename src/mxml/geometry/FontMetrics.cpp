@@ -0,0 +1,399 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "FontMetrics.h"
+
+#include <mxml/StringUtility.h>
+#include <mxml/dom/InvalidDataError.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+
+
+namespace mxml {
+
+const coord_t BuiltinFontMetrics::kWordsFontSize = 23;
+const coord_t BuiltinFontMetrics::kDynamicsFontSize = 30;
+const coord_t BuiltinFontMetrics::kLyricsFontSize = 21;
+
+namespace {
+
+// Character widths for the first 256 code points of the font used to render words
+// See https://gist.github.com/aleph7/3f29c6da342f639b9232
+const int kWordCharacterDefaultWidth = 20;
+const int kWordCharacterWidths[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0, 28,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     5,  6, 11, 14, 10, 17, 15,  6,  6,  6, 11, 14,  6,  7,  6,  6,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10,  6,  6, 14, 14, 14,  9,
+    18, 14, 14, 15, 16, 14, 12, 16, 17,  8,  8, 16, 13, 20, 16, 17,
+    13, 17, 15, 12, 15, 15, 16, 20, 17, 15, 13,  8,  6,  8, 12, 10,
+     7, 11, 12, 10, 13, 11,  7, 11, 12,  7,  7, 12,  7, 19, 12, 12,
+    13, 12,  9, 10,  8, 12, 11, 17, 12, 11, 10,  8, 12,  8, 14,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     5,  6, 10, 15, 14, 15, 12, 11,  7, 15,  7, 12, 14,  0, 15, 10,
+     8, 14,  6,  6,  7, 12, 11,  6,  7,  6,  8, 12, 16, 16, 16,  9,
+    14, 14, 14, 14, 14, 14, 20, 15, 14, 14, 14, 14,  8,  8,  8,  8,
+    16, 16, 17, 17, 17, 17, 17, 14, 17, 15, 15, 15, 15, 15, 13, 13,
+    11, 11, 11, 11, 11, 11, 15, 10, 11, 11, 11, 11,  7,  7,  7,  7,
+    12, 12, 12, 12, 12, 12, 12, 14, 12, 12, 12, 12, 12, 11, 13, 11,
+};
+
+// Character widths for the first 256 code points of the font used to render dynamics
+// See https://gist.github.com/aleph7/3f29c6da342f639b9232
+const int kDynamicsCharacterDefaultWidth = 26;
+const int kDynamicsCharacterWidths[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0, 28,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     7,  9, 15, 18, 13, 24, 21,  8,  9,  9, 15, 18,  9,  9,  9, 17,
+    14, 14, 14, 14, 14, 14, 14, 14, 14, 14,  9,  9, 18, 18, 18, 12,
+    22, 18, 17, 19, 20, 18, 15, 21, 22, 11, 12, 20, 16, 26, 20, 21,
+    16, 21, 19, 15, 18, 19, 17, 25, 18, 16, 17, 10, 17, 10, 15, 13,
+     9, 15, 16, 13, 16, 13,  9, 14, 16,  9,  8, 16,  9, 26, 16, 15,
+    16, 16, 12, 13, 10, 16, 15, 22, 15, 14, 13, 11, 16, 11, 18,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     7,  9, 13, 19, 18, 15, 16, 13,  9, 20, 10, 15, 18,  0, 20, 13,
+    11, 18,  9,  9,  9, 16, 15,  9,  9,  9, 10, 15, 24, 24, 24, 12,
+    18, 18, 18, 18, 18, 18, 24, 19, 18, 18, 18, 18, 11, 11, 11, 11,
+    20, 20, 21, 21, 21, 21, 21, 18, 21, 19, 19, 19, 19, 16, 16, 16,
+    15, 15, 15, 15, 15, 15, 19, 13, 13, 13, 13, 13,  9,  9,  9,  9,
+    15, 16, 15, 15, 15, 15, 15, 18, 15, 16, 16, 16, 16, 14, 16, 14,
+};
+
+// Character widths for the first 256 code points of the font used to render lyrics
+// See https://gist.github.com/aleph7/3f29c6da342f639b9232
+const int kLyricCharacterDefaultWidth = 18;
+const int kLyricCharacterWidths[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0, 28,  0,  6,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     5,  5,  8, 12,  9, 16, 13,  4,  5,  5,  8, 12,  5,  6,  5, 10,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  5,  5, 12, 12, 12,  8,
+    17, 13, 12, 13, 14, 12, 10, 14, 15,  7,  7, 15, 11, 17, 14, 15,
+    11, 15, 14, 10, 13, 14, 14, 18, 14, 13, 12,  7, 10,  7,  9,  9,
+     7,  9, 10,  8, 10,  8,  5,  9, 10,  5,  5,  9,  5, 15, 10,  9,
+    10, 10,  7,  7,  6, 10,  9, 13,  9,  9,  8,  9, 10,  9, 12,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    10, 10,  7,  7,  6, 10,  9, 13,  9,  9,  8,  9, 10,  9, 12,  0,
+     5,  5,  8, 13, 12, 11, 10,  8,  7, 14,  6,  9, 12,  0, 14,  9,
+     8, 12,  6,  6,  7,  9,  9,  7,  7,  6,  6,  9, 16, 16, 16,  8,
+    13, 13, 13, 13, 13, 13, 16, 13, 12, 12, 12, 12,  7,  7,  7,  7,
+    14, 14, 15, 15, 15, 15, 15, 12, 15, 14, 14, 14, 14, 13, 11, 10,
+     9,  9,  9,  9,  9,  9, 12,  8,  8,  8,  8,  8,  5,  5,  5,  5,
+     9, 10,  9,  9,  9,  9,  9, 12,  9, 10, 10, 10, 10,  9, 10,  9,
+};
+
+std::uint16_t readUInt16(const unsigned char* data) {
+    return static_cast<std::uint16_t>(data[0] << 8 | data[1]);
+}
+
+std::uint32_t readUInt32(const unsigned char* data) {
+    return static_cast<std::uint32_t>(data[0]) << 24 | static_cast<std::uint32_t>(data[1]) << 16 |
+        static_cast<std::uint32_t>(data[2]) << 8 | static_cast<std::uint32_t>(data[3]);
+}
+
+/// A bounds-checked view of a font file
+class FontData {
+public:
+    FontData(const char* data, std::size_t size) : _data(reinterpret_cast<const unsigned char*>(data)), _size(size) {}
+
+    std::uint16_t uint16(std::size_t offset) const {
+        check(offset, 2);
+        return readUInt16(_data + offset);
+    }
+    std::uint32_t uint32(std::size_t offset) const {
+        check(offset, 4);
+        return readUInt32(_data + offset);
+    }
+
+    /// Get the offset of a table, or 0 if the font doesn't have it
+    std::size_t table(const char* tag) const {
+        const std::size_t tableCount = uint16(4);
+        for (std::size_t i = 0; i < tableCount; i += 1) {
+            const std::size_t record = 12 + i * 16;
+            check(record, 16);
+            if (std::equal(tag, tag + 4, _data + record))
+                return uint32(record + 8);
+        }
+        return 0;
+    }
+
+private:
+    void check(std::size_t offset, std::size_t length) const {
+        if (offset > _size || length > _size - offset)
+            throw dom::InvalidDataError("Truncated font data");
+    }
+
+private:
+    const unsigned char* _data;
+    std::size_t _size;
+};
+
+/// Invoke `f(codePoint, glyphIndex)` for every mapping in a format 4 cmap subtable
+template <typename F>
+void readCmapFormat4(const FontData& data, std::size_t offset, F f) {
+    const std::size_t segmentCount = data.uint16(offset + 6) / 2;
+    const std::size_t endCodes = offset + 14;
+    const std::size_t startCodes = endCodes + segmentCount * 2 + 2;
+    const std::size_t idDeltas = startCodes + segmentCount * 2;
+    const std::size_t idRangeOffsets = idDeltas + segmentCount * 2;
+
+    for (std::size_t segment = 0; segment < segmentCount; segment += 1) {
+        const std::uint32_t start = data.uint16(startCodes + segment * 2);
+        const std::uint32_t end = data.uint16(endCodes + segment * 2);
+        const std::uint16_t delta = data.uint16(idDeltas + segment * 2);
+        const std::size_t rangeOffsetAddress = idRangeOffsets + segment * 2;
+        const std::uint16_t rangeOffset = data.uint16(rangeOffsetAddress);
+
+        for (std::uint32_t c = start; c <= end && c != 0xFFFF; c += 1) {
+            std::uint16_t glyph;
+            if (rangeOffset == 0) {
+                glyph = static_cast<std::uint16_t>(c + delta);
+            } else {
+                glyph = data.uint16(rangeOffsetAddress + rangeOffset + (c - start) * 2);
+                if (glyph != 0)
+                    glyph = static_cast<std::uint16_t>(glyph + delta);
+            }
+            f(static_cast<char32_t>(c), glyph);
+        }
+    }
+}
+
+/// Invoke `f(codePoint, glyphIndex)` for every mapping in a format 12 cmap subtable
+template <typename F>
+void readCmapFormat12(const FontData& data, std::size_t offset, F f) {
+    const std::size_t groupCount = data.uint32(offset + 12);
+    for (std::size_t group = 0; group < groupCount; group += 1) {
+        const std::size_t record = offset + 16 + group * 12;
+        const std::uint32_t start = data.uint32(record);
+        const std::uint32_t end = std::min<std::uint32_t>(data.uint32(record + 4), 0x10FFFF);
+        const std::uint32_t startGlyph = data.uint32(record + 8);
+        for (std::uint32_t c = start; c <= end; c += 1)
+            f(static_cast<char32_t>(c), static_cast<std::uint16_t>(startGlyph + (c - start)));
+    }
+}
+
+} // namespace
+
+
+coord_t BuiltinFontMetrics::advance(TextFont font, coord_t size, char32_t codePoint) const {
+    const int* widths;
+    int defaultWidth;
+    coord_t tableSize;
+    switch (font) {
+        case TextFont::Words:
+            widths = kWordCharacterWidths;
+            defaultWidth = kWordCharacterDefaultWidth;
+            tableSize = kWordsFontSize;
+            break;
+
+        case TextFont::Dynamics:
+            widths = kDynamicsCharacterWidths;
+            defaultWidth = kDynamicsCharacterDefaultWidth;
+            tableSize = kDynamicsFontSize;
+            break;
+
+        case TextFont::Lyrics:
+            widths = kLyricCharacterWidths;
+            defaultWidth = kLyricCharacterDefaultWidth;
+            tableSize = kLyricsFontSize;
+            break;
+    }
+
+    if (codePoint <= 255)
+        return widths[codePoint] * size / tableSize;
+    if (isWide(codePoint))
+        return size;
+    return defaultWidth * size / tableSize;
+}
+
+bool BuiltinFontMetrics::isWide(char32_t c) {
+    return (c >= 0x1100 && c <= 0x115F) ||   // Hangul Jamo
+        (c >= 0x2E80 && c <= 0x303E) ||      // CJK radicals, symbols and punctuation
+        (c >= 0x3041 && c <= 0x33FF) ||      // Kana, Bopomofo, CJK compatibility
+        (c >= 0x3400 && c <= 0x4DBF) ||      // CJK extension A
+        (c >= 0x4E00 && c <= 0x9FFF) ||      // CJK unified ideographs
+        (c >= 0xA000 && c <= 0xA4CF) ||      // Yi
+        (c >= 0xAC00 && c <= 0xD7A3) ||      // Hangul syllables
+        (c >= 0xF900 && c <= 0xFAFF) ||      // CJK compatibility ideographs
+        (c >= 0xFE30 && c <= 0xFE4F) ||      // CJK compatibility forms
+        (c >= 0xFF00 && c <= 0xFF60) ||      // Fullwidth forms
+        (c >= 0xFFE0 && c <= 0xFFE6) ||
+        (c >= 0x20000 && c <= 0x3FFFD);      // CJK extensions B and later
+}
+
+
+TrueTypeFontMetrics::TrueTypeFontMetrics(std::shared_ptr<const FontMetrics> fallback)
+: _fallback(std::move(fallback))
+{
+}
+
+void TrueTypeFontMetrics::loadFile(TextFont font, const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw dom::InvalidDataError("Could not open " + path);
+
+    std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    load(font, buffer.data(), buffer.size());
+}
+
+void TrueTypeFontMetrics::load(TextFont font, const char* bytes, std::size_t size) {
+    const FontData data(bytes, size);
+
+    const auto head = data.table("head");
+    const auto hhea = data.table("hhea");
+    const auto hmtx = data.table("hmtx");
+    const auto cmap = data.table("cmap");
+    if (head == 0 || hhea == 0 || hmtx == 0 || cmap == 0)
+        throw dom::InvalidDataError("Not a TrueType font, missing required tables");
+
+    Face face;
+    face.unitsPerEm = data.uint16(head + 18);
+    if (face.unitsPerEm == 0)
+        throw dom::InvalidDataError("Invalid font units per em");
+
+    // Glyphs past the last long metric share its advance
+    const std::size_t metricCount = data.uint16(hhea + 34);
+    if (metricCount == 0)
+        throw dom::InvalidDataError("Font has no horizontal metrics");
+    auto glyphAdvance = [&](std::uint16_t glyph) {
+        return data.uint16(hmtx + std::min<std::size_t>(glyph, metricCount - 1) * 4);
+    };
+
+    // Prefer a full Unicode subtable, then a BMP one
+    std::size_t subtable = 0;
+    int subtableRank = 0;
+    const std::size_t encodingCount = data.uint16(cmap + 2);
+    for (std::size_t i = 0; i < encodingCount; i += 1) {
+        const std::size_t record = cmap + 4 + i * 8;
+        const auto platform = data.uint16(record);
+        const auto encoding = data.uint16(record + 2);
+        const std::size_t offset = cmap + data.uint32(record + 4);
+        const auto format = data.uint16(offset);
+
+        const bool unicode = platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10));
+        int rank = 0;
+        if (unicode && format == 12)
+            rank = 2;
+        else if (unicode && format == 4)
+            rank = 1;
+        if (rank > subtableRank) {
+            subtable = offset;
+            subtableRank = rank;
+        }
+    }
+    if (subtableRank == 0)
+        throw dom::InvalidDataError("Font has no Unicode character map");
+
+    auto add = [&](char32_t codePoint, std::uint16_t glyph) {
+        if (glyph != 0)
+            face.advances.emplace_back(codePoint, glyphAdvance(glyph));
+    };
+    if (subtableRank == 2)
+        readCmapFormat12(data, subtable, add);
+    else
+        readCmapFormat4(data, subtable, add);
+
+    std::sort(face.advances.begin(), face.advances.end());
+    face.advances.erase(std::unique(face.advances.begin(), face.advances.end(), [](const std::pair<char32_t, std::uint16_t>& lhs, const std::pair<char32_t, std::uint16_t>& rhs) {
+        return lhs.first == rhs.first;
+    }), face.advances.end());
+
+    _faces[static_cast<std::size_t>(font)] = std::move(face);
+}
+
+coord_t TrueTypeFontMetrics::advance(TextFont font, coord_t size, char32_t codePoint) const {
+    auto& face = _faces[static_cast<std::size_t>(font)];
+    if (face.unitsPerEm != 0) {
+        auto it = std::lower_bound(face.advances.begin(), face.advances.end(), std::make_pair(codePoint, std::uint16_t(0)));
+        if (it != face.advances.end() && it->first == codePoint)
+            return it->second * size / face.unitsPerEm;
+    }
+
+    if (_fallback)
+        return _fallback->advance(font, size, codePoint);
+    return -1;
+}
+
+
+std::size_t GlyphAdvanceCache::KeyHash::operator()(const Key& key) const {
+    std::size_t hash = std::hash<coord_t>()(key.size);
+    hash ^= (static_cast<std::size_t>(key.codePoint) << 2 | static_cast<std::size_t>(key.font)) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+GlyphAdvanceCache::GlyphAdvanceCache(std::shared_ptr<const FontMetrics> metrics)
+: _metrics(std::move(metrics))
+{
+}
+
+GlyphAdvanceCache& GlyphAdvanceCache::shared() {
+    static GlyphAdvanceCache cache;
+    return cache;
+}
+
+void GlyphAdvanceCache::setMetrics(std::shared_ptr<const FontMetrics> metrics) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _metrics = std::move(metrics);
+    _advances.clear();
+}
+
+coord_t GlyphAdvanceCache::advance(TextFont font, coord_t size, char32_t codePoint) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return lookup({font, size, codePoint});
+}
+
+coord_t GlyphAdvanceCache::measure(TextFont font, coord_t size, const std::string& text) {
+    return measure(font, size, std::vector<const std::string*>{&text}).front();
+}
+
+std::vector<coord_t> GlyphAdvanceCache::measure(TextFont font, coord_t size, const std::vector<const std::string*>& lines) {
+    std::vector<coord_t> widths;
+    widths.reserve(lines.size());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto line : lines) {
+        _codePoints.clear();
+        const char* string = line->c_str();
+        const std::size_t length = line->length();
+        for (std::size_t i = 0; i < length; ) {
+            char32_t codePoint;
+            auto result = utf8ToCodePoint(&codePoint, string + i, length - i);
+            if (result == 0 || static_cast<int>(result) < 0)
+                break;
+
+            i += result;
+            _codePoints.push_back(codePoint);
+        }
+
+        coord_t width = 0;
+        for (auto codePoint : _codePoints)
+            width += lookup({font, size, codePoint});
+        widths.push_back(width);
+    }
+
+    return widths;
+}
+
+std::size_t GlyphAdvanceCache::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _advances.size();
+}
+
+coord_t GlyphAdvanceCache::lookup(const Key& key) {
+    auto it = _advances.find(key);
+    if (it != _advances.end())
+        return it->second;
+
+    // Code points the font can't draw take no space rather than a negative one
+    const coord_t advance = std::max(coord_t(0), _metrics->advance(key.font, key.size, key.codePoint));
+    _advances.emplace(key, advance);
+    return advance;
+}
+
+} // namespace mxml
@@ -0,0 +1,162 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "Point.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ The fonts used to lay out text.
+ */
+enum class TextFont : std::uint8_t {
+    Words,
+    Dynamics,
+    Lyrics
+};
+
+/**
+ Provides glyph advances for the text fonts. Implementations are queried through a `GlyphAdvanceCache` and have to be
+ safe to call from several threads.
+ */
+class FontMetrics {
+public:
+    virtual ~FontMetrics() = default;
+
+    /**
+     Get the horizontal advance of a code point at a font size. Returns a negative value if the font has no glyph for
+     the code point.
+     */
+    virtual coord_t advance(TextFont font, coord_t size, char32_t codePoint) const = 0;
+};
+
+/**
+ Font metrics from built-in width tables for the first 256 code points of each font. East Asian wide characters are
+ one em wide and everything else gets a default width.
+ */
+class BuiltinFontMetrics : public FontMetrics {
+public:
+    /// The font sizes the width tables were measured at
+    static const coord_t kWordsFontSize;
+    static const coord_t kDynamicsFontSize;
+    static const coord_t kLyricsFontSize;
+
+public:
+    coord_t advance(TextFont font, coord_t size, char32_t codePoint) const override;
+
+    /**
+     Whether a code point is an East Asian wide or fullwidth character, such as CJK ideographs and kana.
+     */
+    static bool isWide(char32_t codePoint);
+};
+
+/**
+ Font metrics read from the `cmap` and `hmtx` tables of TrueType or OpenType fonts. Fonts that are not loaded and code
+ points without a glyph are measured with a fallback.
+ */
+class TrueTypeFontMetrics : public FontMetrics {
+public:
+    explicit TrueTypeFontMetrics(std::shared_ptr<const FontMetrics> fallback = std::make_shared<BuiltinFontMetrics>());
+
+    /**
+     Load the advances for a text font from a font file. Throws `dom::InvalidDataError` if the file can't be read or
+     is not a TrueType font.
+     */
+    void loadFile(TextFont font, const std::string& path);
+
+    /**
+     Load the advances for a text font from the contents of a font file.
+     */
+    void load(TextFont font, const char* data, std::size_t size);
+
+    bool loaded(TextFont font) const {
+        return _faces[static_cast<std::size_t>(font)].unitsPerEm != 0;
+    }
+
+    coord_t advance(TextFont font, coord_t size, char32_t codePoint) const override;
+
+private:
+    struct Face {
+        unsigned int unitsPerEm = 0;
+
+        /// Advances in font units, sorted by code point
+        std::vector<std::pair<char32_t, std::uint16_t>> advances;
+    };
+
+private:
+    std::shared_ptr<const FontMetrics> _fallback;
+    Face _faces[3];
+};
+
+/**
+ Measures text with a `FontMetrics` and caches the advance of every (font, size, code point) it looks up. The cache
+ can be used from several threads, a batch of strings only locks it once.
+ */
+class GlyphAdvanceCache {
+public:
+    explicit GlyphAdvanceCache(std::shared_ptr<const FontMetrics> metrics = std::make_shared<BuiltinFontMetrics>());
+
+    /**
+     The cache used to lay out words, dynamics and lyrics.
+     */
+    static GlyphAdvanceCache& shared();
+
+    /**
+     Replace the metrics and drop all cached advances. Geometries built before the change keep their sizes.
+     */
+    void setMetrics(std::shared_ptr<const FontMetrics> metrics);
+
+    coord_t advance(TextFont font, coord_t size, char32_t codePoint);
+
+    /**
+     Get the width of UTF-8 text, the sum of the advances of its code points. Decoding stops at the first invalid
+     sequence.
+     */
+    coord_t measure(TextFont font, coord_t size, const std::string& text);
+
+    /**
+     Get the widths of several lines of UTF-8 text, for instance all the syllables of a verse, in the same order.
+     */
+    std::vector<coord_t> measure(TextFont font, coord_t size, const std::vector<const std::string*>& lines);
+
+    std::size_t size() const;
+
+private:
+    struct Key {
+        TextFont font;
+        coord_t size;
+        char32_t codePoint;
+
+        bool operator==(const Key& rhs) const {
+            return font == rhs.font && size == rhs.size && codePoint == rhs.codePoint;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    coord_t lookup(const Key& key);
+
+private:
+    mutable std::mutex _mutex;
+    std::shared_ptr<const FontMetrics> _metrics;
+    std::unordered_map<Key, coord_t, KeyHash> _advances;
+
+    /// Decoded code points of the current batch, guarded by `_mutex`
+    std::vector<char32_t> _codePoints;
+};
+
+} // namespace mxml
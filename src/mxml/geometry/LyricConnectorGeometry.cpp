@@ -0,0 +1,22 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "LyricConnectorGeometry.h"
+
+namespace mxml {
+
+const coord_t LyricConnectorGeometry::kHyphenWidth = 8;
+const coord_t LyricConnectorGeometry::kLineWidth = 1;
+
+LyricConnectorGeometry::LyricConnectorGeometry(Type type, const LyricGeometry& lyricGeometry)
+: PlacementGeometry(lyricGeometry.placement(), lyricGeometry.staff()),
+  _type(type),
+  _lyricGeometry(lyricGeometry)
+{
+    setSize({kHyphenWidth, kLineWidth});
+}
+
+} // namespace mxml
@@ -0,0 +1,42 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "LyricGeometry.h"
+
+namespace mxml {
+
+/**
+ A hyphen between the syllables of a word, or an extender line after a syllable that is held over several notes.
+ */
+class LyricConnectorGeometry : public PlacementGeometry {
+public:
+    enum class Type {
+        Hyphen,
+        Extender
+    };
+
+    static const coord_t kHyphenWidth;
+    static const coord_t kLineWidth;
+
+public:
+    LyricConnectorGeometry(Type type, const LyricGeometry& lyricGeometry);
+
+    Type type() const {
+        return _type;
+    }
+
+    /// The syllable that the connector follows
+    const LyricGeometry& lyricGeometry() const {
+        return _lyricGeometry;
+    }
+
+private:
+    Type _type;
+    const LyricGeometry& _lyricGeometry;
+};
+
+} // namespace mxml
@@ -4,39 +4,14 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "FontMetrics.h"
 #include "LyricGeometry.h"
 #include <mxml/StringUtility.h>
 
 namespace mxml {
 
 static const std::size_t kLyricPadding = 2;
-
-// Character widths for the first 256 code points of the font used to render lyrics
-// See https://gist.github.com/aleph7/3f29c6da342f639b9232
 static const int kCharacterHeight = 21;
-static const int kCharacterDefaultWidth = 18;
-static const int kCharacterWidths[256] = {
-    0,  0,  0,  0,  0,  0,  0,  0,  0, 28,  0,  6,  0,  0,  0,  0,
-    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-    5,  5,  8, 12,  9, 16, 13,  4,  5,  5,  8, 12,  5,  6,  5, 10,
-    9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  5,  5, 12, 12, 12,  8,
-    17, 13, 12, 13, 14, 12, 10, 14, 15,  7,  7, 15, 11, 17, 14, 15,
-    11, 15, 14, 10, 13, 14, 14, 18, 14, 13, 12,  7, 10,  7,  9,  9,
-    7,  9, 10,  8, 10,  8,  5,  9, 10,  5,  5,  9,  5, 15, 10,  9,
-    10, 10,  7,  7,  6, 10,  9, 13,  9,  9,  8,  9, 10,  9, 12,  0,
-    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-    10, 10,  7,  7,  6, 10,  9, 13,  9,  9,  8,  9, 10,  9, 12,  0,
-    5,  5,  8, 13, 12, 11, 10,  8,  7, 14,  6,  9, 12,  0, 14,  9,
-    8, 12,  6,  6,  7,  9,  9,  7,  7,  6,  6,  9, 16, 16, 16,  8,
-    13, 13, 13, 13, 13, 13, 16, 13, 12, 12, 12, 12,  7,  7,  7,  7,
-    14, 14, 15, 15, 15, 15, 15, 12, 15, 14, 14, 14, 14, 13, 11, 10,
-    9,  9,  9,  9,  9,  9, 12,  8,  8,  8,  8,  8,  5,  5,  5,  5,
-    9, 10,  9,  9,  9,  9,  9, 12,  9, 10, 10, 10, 10,  9, 10,  9, 
-};
-
-
-size_t utf8ToCodePoint(char32_t* pc32, const char* s, size_t n);
-
 
 LyricGeometry::LyricGeometry(const dom::Lyric& lyric, int staff)
 : PlacementGeometry(lyric.placement(), staff),
@@ -52,25 +27,29 @@ LyricGeometry::LyricGeometry(const dom::Lyric& lyric, int staff)
 }
 
 coord_t LyricGeometry::width(const dom::Lyric& lyric) {
-    const auto& size = lyric.text().length();
+    auto string = lyric.text();
+    trim(string);
 
-    auto stringCopy = lyric.text();
-    const auto& string = trim(stringCopy).c_str();
-
-    int width = 0;
-    for (std::size_t i = 0; i < size; ) {
-        char32_t codePoint;
-        auto result = utf8ToCodePoint(&codePoint, string + i, size - i);
-        if (static_cast<int>(result) < 0)
-            break;
+    return GlyphAdvanceCache::shared().measure(TextFont::Lyrics, BuiltinFontMetrics::kLyricsFontSize, string) + kLyricPadding;
+}
 
-        i += result;
-        if (codePoint < 255)
-            width += kCharacterWidths[codePoint];
-        else
-            width += kCharacterDefaultWidth;
+std::vector<coord_t> LyricGeometry::widths(const std::vector<const dom::Lyric*>& lyrics) {
+    std::vector<std::string> strings;
+    strings.reserve(lyrics.size());
+    for (auto lyric : lyrics) {
+        strings.push_back(lyric->text());
+        trim(strings.back());
     }
-    return width + kLyricPadding;
+
+    std::vector<const std::string*> lines;
+    lines.reserve(strings.size());
+    for (auto& string : strings)
+        lines.push_back(&string);
+
+    auto result = GlyphAdvanceCache::shared().measure(TextFont::Lyrics, BuiltinFontMetrics::kLyricsFontSize, lines);
+    for (auto& width : result)
+        width += kLyricPadding;
+    return result;
 }
 
 } // namespace
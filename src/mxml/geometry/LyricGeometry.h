@@ -8,6 +8,8 @@
 #include "PlacementGeometry.h"
 #include <mxml/dom/Lyric.h>
 
+#include <vector>
+
 namespace mxml {
 
 class LyricGeometry : public PlacementGeometry {
@@ -20,6 +22,11 @@ public:
 
     static coord_t width(const dom::Lyric& lyric);
 
+    /**
+     Get the widths of several lyrics at once, in the same order.
+     */
+    static std::vector<coord_t> widths(const std::vector<const dom::Lyric*>& lyrics);
+
 private:
     const dom::Lyric& _lyric;
 };
@@ -22,7 +22,7 @@ namespace mxml {
         else if (stop)
             type = stop->type();
 
-        const dom::Pedal* pedal = dynamic_cast<const dom::Pedal*>(type);
+        const dom::Pedal* pedal = dom::nodeCast<dom::Pedal>(type);
         if (pedal->sign())
             size.width = std::max(size.width, kPedSize.width + kStarSize.width);
         else
@@ -6,11 +6,12 @@
 
 #include "ScrollScoreGeometry.h"
 #include <mxml/geometry/factories/PartGeometryFactory.h>
+#include <mxml/Parallel.h>
 #include <mxml/SpanFactory.h>
 
 namespace mxml {
 
-ScrollScoreGeometry::ScrollScoreGeometry(const dom::Score& score, bool naturalSpacing)
+ScrollScoreGeometry::ScrollScoreGeometry(const dom::Score& score, bool naturalSpacing, std::size_t threads)
 : _score(score),
   _scoreProperties(score, ScoreProperties::LayoutType::Scroll),
   _spans()
@@ -19,23 +20,26 @@ ScrollScoreGeometry::ScrollScoreGeometry(const dom::Score& score, bool naturalSp
     spanFactory.setNaturalSpacing(naturalSpacing);
     _spans = spanFactory.build();
 
-    DirectionGeometryFactory directionGeometryFactory;
-
-    std::size_t partIndex = 0;
-    coord_t offset = 0;
-    for (auto& part : _score.parts()) {
+    const auto partCount = _score.parts().size();
+    for (std::size_t partIndex = 0; partIndex < partCount; partIndex += 1)
         _metrics.emplace_back(new ScrollMetrics(_score, _scoreProperties, partIndex));
 
-        PartGeometryFactory factory(*part, _scoreProperties, *_metrics.back(), *_spans, directionGeometryFactory);
-        std::unique_ptr<PartGeometry> geom = factory.build();
+    // Span directions never cross parts, so each part gets its own direction factory and parts can be built in parallel
+    std::vector<std::unique_ptr<PartGeometry>> geometries(partCount);
+    parallelFor(partCount, [&](std::size_t partIndex) {
+        DirectionGeometryFactory directionGeometryFactory;
+        PartGeometryFactory factory(*_score.parts()[partIndex], _scoreProperties, *_metrics[partIndex], *_spans, directionGeometryFactory);
+        geometries[partIndex] = factory.build();
+    }, threads);
+
+    coord_t offset = 0;
+    for (auto& geom : geometries) {
         geom->setHorizontalAnchorPointValues(0, 0);
         geom->setVerticalAnchorPointValues(0, 0);
         geom->setLocation({0, offset});
         offset += geom->size().height;
         _partGeometries.push_back(geom.get());
         addGeometry(std::move(geom));
-
-        partIndex += 1;
     }
     
     setBounds(subGeometriesFrame());
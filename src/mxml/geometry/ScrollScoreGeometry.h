@@ -21,7 +21,15 @@ namespace mxml {
 
 class ScrollScoreGeometry : public Geometry {
 public:
-    ScrollScoreGeometry(const dom::Score& score, bool naturalSpacing = true);
+    /**
+     Lay out a score on a single system. Parts are independent, so they are built concurrently and then stacked.
+
+     @param score          The score to lay out
+     @param naturalSpacing Whether to space notes proportionally to their durations
+     @param threads        The maximum number of threads to use, 0 means one per hardware thread and 1 builds the parts
+                           on the calling thread
+     */
+    ScrollScoreGeometry(const dom::Score& score, bool naturalSpacing = true, std::size_t threads = 0);
 
     const dom::Score& score() const {
         return _score;
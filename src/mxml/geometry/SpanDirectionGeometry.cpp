@@ -37,8 +37,8 @@ SpanDirectionGeometry::SpanDirectionGeometry(const Direction* start, const Point
     Size size;
     size.width = stopLocation.x - startLocation.x;
     
-    if (const Wedge* startWedge = dynamic_cast<const Wedge*>(type)) {
-        const Wedge* stopWedge = dynamic_cast<const Wedge*>(type);
+    if (const Wedge* startWedge = nodeCast<Wedge>(type)) {
+        const Wedge* stopWedge = nodeCast<Wedge>(type);
         size.height = 2*kLineWidth + std::max(startWedge->spread(), stopWedge->spread());
     }
     setSize(size);
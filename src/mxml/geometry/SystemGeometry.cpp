@@ -12,12 +12,12 @@
 
 namespace mxml {
 
-SystemGeometry::SystemGeometry(const dom::Score& score, const ScoreProperties& scoreProperties, const SpanCollection& spans, DirectionGeometryFactory& directionGeometryFactory, std::size_t systemIndex, coord_t width)
+SystemGeometry::SystemGeometry(const dom::Score& score, const ScoreProperties& scoreProperties, const SpanCollection& spans, std::vector<DirectionGeometryFactory>& directionGeometryFactories, std::size_t systemIndex, coord_t width)
 : _score(score),
   _scoreProperties(scoreProperties),
   _spans(spans),
   _systemIndex(systemIndex),
-  _directionGeometryFactory(directionGeometryFactory)
+  _directionGeometryFactories(directionGeometryFactories)
 {
     auto range = _scoreProperties.measureRange(systemIndex);
 
@@ -26,7 +26,7 @@ SystemGeometry::SystemGeometry(const dom::Score& score, const ScoreProperties& s
     for (auto& part : _score.parts()) {
         _metrics.emplace_back(new PageMetrics(_score, _scoreProperties, systemIndex, partIndex));
 
-        PartGeometryFactory factory(*part, _scoreProperties, *_metrics.back(), _spans, _directionGeometryFactory);
+        PartGeometryFactory factory(*part, _scoreProperties, *_metrics.back(), _spans, _directionGeometryFactories[partIndex]);
         std::unique_ptr<PartGeometry> geom = factory.build(range.first, range.second);
 
         geom->setHorizontalAnchorPointValues(0, 0);
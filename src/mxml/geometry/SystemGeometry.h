@@ -18,7 +18,7 @@ namespace mxml {
 
 class SystemGeometry : public Geometry {
 public:
-    SystemGeometry(const dom::Score& score, const ScoreProperties& scoreProperties, const SpanCollection& spans, DirectionGeometryFactory& directionGeometryFactory, std::size_t systemIndex, coord_t width);
+    SystemGeometry(const dom::Score& score, const ScoreProperties& scoreProperties, const SpanCollection& spans, std::vector<DirectionGeometryFactory>& directionGeometryFactories, std::size_t systemIndex, coord_t width);
 
     const std::vector<PartGeometry*>& partGeometries() const {
         return _partGeometries;
@@ -43,7 +43,7 @@ private:
     const ScoreProperties& _scoreProperties;
     const SpanCollection& _spans;
     const std::size_t _systemIndex;
-    DirectionGeometryFactory& _directionGeometryFactory;
+    std::vector<DirectionGeometryFactory>& _directionGeometryFactories;
 
     std::vector<PartGeometry*> _partGeometries;
     std::vector<std::unique_ptr<PageMetrics>> _metrics;
@@ -12,6 +12,7 @@
 #include <typeindex>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace mxml {
@@ -66,17 +67,37 @@ protected:
 
 public:
     CollisionResolver(const Geometry& geometry, const Metrics& metrics);
+
+    /**
+     Create a resolver that only checks some of the geometries in `geometry`. They have to be in the same order as
+     returned by `collectGeometries()`.
+     */
+    CollisionResolver(const Geometry& geometry, const Metrics& metrics, const std::vector<Geometry*>& geometries);
+
+    /**
+     Don't resolve collisions involving any of these geometries. They are still taken into account when looking for a
+     free position.
+     */
+    void excludeCollisions(const std::vector<Geometry*>& geometries);
+
+    /**
+     Only start with the collisions that involve one of these geometries. Only the neighbors of these geometries are
+     scanned for the initial collisions. Collisions found after moving a geometry are all resolved.
+     */
+    void restrictInitialCollisions(const std::vector<Geometry*>& geometries);
     
     /**
      Resolve all collisions in the set of geometries.
      */
     void resolveCollisions();
-    
-protected:
+
     /**
-     Add a vector of geometries to the set of geometries that are going be checked for collisions.
+     Get the geometries in `geometry` that are checked for collisions, in tree order.
      */
-    void addAllGeometries(const std::vector<std::unique_ptr<Geometry>>& geometries);
+    static std::vector<Geometry*> collectGeometries(const Geometry& geometry);
+    
+protected:
+    static void collectGeometries(const std::vector<std::unique_ptr<Geometry>>& geometries, Comparator& comparator, std::vector<Geometry*>& result);
     
     /**
      Add a geometry to the set of geometries that are going be checked for collisions.
@@ -86,7 +107,9 @@ protected:
     void addGeometry(Geometry* geometry);
     
     void addAllCollisions();
+    void addInitialCollisions();
     bool addAllCollisions(Geometry* geometry);
+    bool isExcluded(const Geometry* geometry) const;
     
     /**
      Check if two given geometries are colliding.
@@ -122,6 +145,10 @@ protected:
     std::multiset<Geometry*, GeometryXComparator> _geometries;
     std::multiset<CollisionPair, CollisionPairComparator> _collisionPairs;
     Comparator _geometryTypeComparator;
+
+    std::unordered_set<const Geometry*> _excludedGeometries;
+    std::unordered_set<const Geometry*> _initialGeometries;
+    bool _restrictInitialCollisions = false;
 };
     
 }
@@ -7,6 +7,7 @@
 #include <mxml/geometry/ChordGeometry.h>
 #include <mxml/geometry/MeasureGeometry.h>
 
+#include <algorithm>
 #include <typeinfo>
 
 namespace mxml {
@@ -14,11 +15,27 @@ namespace mxml {
 template <typename Comparator>
 CollisionResolver<Comparator>::CollisionResolver(const Geometry& geometry, const Metrics& metrics)
 : _geometry(geometry), _metrics(metrics) {
-    addAllGeometries(_geometry.geometries());
+    for (auto geom : collectGeometries(_geometry))
+        addGeometry(geom);
 }
 
 template <typename Comparator>
-void CollisionResolver<Comparator>::addAllGeometries(const std::vector<std::unique_ptr<Geometry>>& geometries) {
+CollisionResolver<Comparator>::CollisionResolver(const Geometry& geometry, const Metrics& metrics, const std::vector<Geometry*>& geometries)
+: _geometry(geometry), _metrics(metrics) {
+    for (auto geom : geometries)
+        addGeometry(geom);
+}
+
+template <typename Comparator>
+std::vector<Geometry*> CollisionResolver<Comparator>::collectGeometries(const Geometry& geometry) {
+    Comparator comparator;
+    std::vector<Geometry*> result;
+    collectGeometries(geometry.geometries(), comparator, result);
+    return result;
+}
+
+template <typename Comparator>
+void CollisionResolver<Comparator>::collectGeometries(const std::vector<std::unique_ptr<Geometry>>& geometries, Comparator& comparator, std::vector<Geometry*>& result) {
     using std::type_index;
     const auto measureGeometryIndex = type_index(typeid(MeasureGeometry));
     const auto chordGeometryIndex = type_index(typeid(ChordGeometry));
@@ -26,16 +43,32 @@ void CollisionResolver<Comparator>::addAllGeometries(const std::vector<std::uniq
     for (auto& geometry : geometries) {
         auto index = type_index(typeid(*geometry));
         if (index == measureGeometryIndex || index == chordGeometryIndex) {
-            addAllGeometries(geometry->geometries());
+            collectGeometries(geometry->geometries(), comparator, result);
             continue;
         }
         
-        auto it = _geometryTypeComparator.typeOrder.find(index);
-        if (it != _geometryTypeComparator.typeOrder.end())
-            addGeometry(geometry.get());
+        auto it = comparator.typeOrder.find(index);
+        if (it != comparator.typeOrder.end())
+            result.push_back(geometry.get());
     }
 }
 
+template <typename Comparator>
+void CollisionResolver<Comparator>::excludeCollisions(const std::vector<Geometry*>& geometries) {
+    _excludedGeometries.insert(geometries.begin(), geometries.end());
+}
+
+template <typename Comparator>
+void CollisionResolver<Comparator>::restrictInitialCollisions(const std::vector<Geometry*>& geometries) {
+    _initialGeometries.insert(geometries.begin(), geometries.end());
+    _restrictInitialCollisions = true;
+}
+
+template <typename Comparator>
+bool CollisionResolver<Comparator>::isExcluded(const Geometry* geometry) const {
+    return !_excludedGeometries.empty() && _excludedGeometries.count(geometry) != 0;
+}
+
 template <typename Comparator>
 void CollisionResolver<Comparator>::addGeometry(Geometry* geometry) {
     _geometries.insert(geometry);
@@ -43,13 +76,27 @@ void CollisionResolver<Comparator>::addGeometry(Geometry* geometry) {
 
 template <typename Comparator>
 void CollisionResolver<Comparator>::addAllCollisions() {
+    if (_restrictInitialCollisions) {
+        addInitialCollisions();
+        return;
+    }
+
     for (auto i = _geometries.begin(); i != _geometries.end(); ++i) {
+        if (isExcluded(*i))
+            continue;
+        const bool immovable = isImmovable(*i);
         Rect f1 = _geometry.convertFromGeometry((*i)->frame(), (*i)->parentGeometry());
         
         for (auto j = std::next(i); j != _geometries.end(); ++j) {
             Rect f2 = _geometry.convertFromGeometry((*j)->frame(), (*j)->parentGeometry());
             if (f2.origin.x > f1.origin.x + f1.size.width)
                 break;
+            if (isExcluded(*j))
+                continue;
+
+            // Immovable geometries, like lyrics, are only obstacles for the others
+            if (immovable && isImmovable(*j))
+                continue;
             
             if (colliding(*i, *j))
                 _collisionPairs.emplace(*i, *j);
@@ -57,6 +104,54 @@ void CollisionResolver<Comparator>::addAllCollisions() {
     }
 }
 
+template <typename Comparator>
+void CollisionResolver<Comparator>::addInitialCollisions() {
+    std::vector<Geometry*> geometries(_geometries.begin(), _geometries.end());
+    std::unordered_map<const Geometry*, std::size_t> indices;
+    std::vector<Rect> frames;
+    std::vector<coord_t> rightEdges; // The rightmost edge of the geometries up to each position
+    frames.reserve(geometries.size());
+    rightEdges.reserve(geometries.size());
+    for (std::size_t i = 0; i < geometries.size(); i += 1) {
+        indices[geometries[i]] = i;
+        frames.push_back(_geometry.convertFromGeometry(geometries[i]->frame(), geometries[i]->parentGeometry()));
+        const coord_t edge = frames[i].origin.x + frames[i].size.width;
+        rightEdges.push_back(i == 0 ? edge : std::max(rightEdges[i - 1], edge));
+    }
+
+    // Only scan the neighbors of the initial geometries, collecting the pairs by position so that they are added in
+    // the same order as when scanning all pairs
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for (auto geometry : _initialGeometries) {
+        auto it = indices.find(geometry);
+        if (it == indices.end() || isExcluded(geometry))
+            continue;
+        const std::size_t index = it->second;
+        const bool immovable = isImmovable(geometry);
+        const Rect& f1 = frames[index];
+
+        auto first = std::lower_bound(rightEdges.begin(), rightEdges.end(), f1.origin.x) - rightEdges.begin();
+        for (std::size_t i = static_cast<std::size_t>(first); i < geometries.size(); i += 1) {
+            if (i == index)
+                continue;
+            if (frames[i].origin.x > f1.origin.x + f1.size.width)
+                break;
+            if (isExcluded(geometries[i]))
+                continue;
+            if (immovable && isImmovable(geometries[i]))
+                continue;
+
+            if (colliding(geometry, geometries[i]))
+                pairs.emplace_back(std::min(index, i), std::max(index, i));
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    for (auto& pair : pairs)
+        _collisionPairs.emplace(geometries[pair.first], geometries[pair.second]);
+}
+
 template <typename Comparator>
 bool CollisionResolver<Comparator>::addAllCollisions(Geometry* geometry) {
     Rect f1 = _geometry.convertFromGeometry(geometry->frame(), geometry->parentGeometry());
@@ -69,6 +164,8 @@ bool CollisionResolver<Comparator>::addAllCollisions(Geometry* geometry) {
         Rect f2 = _geometry.convertFromGeometry((*i)->frame(), (*i)->parentGeometry());
         if (f2.origin.x > f1.origin.x + f1.size.width)
             break;
+        if (isExcluded(*i))
+            continue;
         
         if (colliding(geometry, *i)) {
             foundCollision = true;
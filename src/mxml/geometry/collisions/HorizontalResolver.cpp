@@ -37,6 +37,9 @@ namespace mxml {
     
     HorizontalResolver::HorizontalResolver(const Geometry& geometry, const Metrics& metrics) : CollisionResolver(geometry, metrics) {
     }
+
+    HorizontalResolver::HorizontalResolver(const Geometry& geometry, const Metrics& metrics, const std::vector<Geometry*>& geometries) : CollisionResolver(geometry, metrics, geometries) {
+    }
     
     void HorizontalResolver::resolveCollision(const CollisionPair& pair) {
         if (!canResolveCollision(pair))
@@ -24,6 +24,7 @@ namespace mxml {
     class HorizontalResolver : public CollisionResolver<HorizontalTypeComparator> {
     public:
         HorizontalResolver(const Geometry& geometry, const Metrics& metrics);
+        HorizontalResolver(const Geometry& geometry, const Metrics& metrics, const std::vector<Geometry*>& geometries);
         
     protected:
         void resolveCollision(const CollisionPair& pair);
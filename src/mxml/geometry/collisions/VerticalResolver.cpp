@@ -39,7 +39,7 @@ namespace mxml {
     
     VerticalTypeComparator::VerticalTypeComparator() {
         // This is the collision priority of different geometry types. Geometries with lower numbers are less likely to
-        // be moved.
+        // be moved. Lyrics are spaced by LyricGeometryFactory and only act as obstacles.
         typeOrder[std::type_index(typeid(ClefGeometry))] = 0;
         typeOrder[std::type_index(typeid(KeyGeometry))] = 0;
         typeOrder[std::type_index(typeid(TimeSignatureGeometry))] = 0;
@@ -77,6 +77,9 @@ namespace mxml {
     
     VerticalResolver::VerticalResolver(const Geometry& geometry, const Metrics& metrics) : CollisionResolver(geometry, metrics) {
     }
+
+    VerticalResolver::VerticalResolver(const Geometry& geometry, const Metrics& metrics, const std::vector<Geometry*>& geometries) : CollisionResolver(geometry, metrics, geometries) {
+    }
     
     void VerticalResolver::resolveCollision(const CollisionPair& pair) {
         if (!canResolveCollision(pair))
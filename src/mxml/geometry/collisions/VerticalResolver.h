@@ -26,6 +26,7 @@ namespace mxml {
     class VerticalResolver : public CollisionResolver<VerticalTypeComparator> {
     public:
         VerticalResolver(const Geometry& geometry, const Metrics& metrics);
+        VerticalResolver(const Geometry& geometry, const Metrics& metrics, const std::vector<Geometry*>& geometries);
         
     protected:
         void resolveCollision(const CollisionPair& pair);
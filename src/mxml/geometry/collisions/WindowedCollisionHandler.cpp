@@ -0,0 +1,149 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "WindowedCollisionHandler.h"
+
+#include <mxml/Parallel.h>
+#include <mxml/geometry/PartGeometry.h>
+#include <mxml/geometry/SpanDirectionGeometry.h>
+
+#include <algorithm>
+
+namespace mxml {
+
+const std::size_t WindowedCollisionHandler::kDefaultWindowMeasures = 4;
+
+/// Geometries closer than this are considered overlapping, to stay clear of rounding in the collision tests
+static const coord_t kGapSlack = 1;
+
+WindowedCollisionHandler::WindowedCollisionHandler(const PartGeometry& geometry, const Metrics& metrics, std::size_t windowMeasures)
+: _geometry(geometry),
+  _metrics(metrics)
+{
+    buildWindows(windowMeasures);
+}
+
+void WindowedCollisionHandler::resolveCollisions(std::size_t threads) {
+    parallelFor(_windows.size(), [this](std::size_t index) {
+        VerticalResolver resolver(_geometry, _metrics, _windows[index].verticalGeometries);
+        resolver.excludeCollisions(_spanningGeometries);
+        resolver.resolveCollisions();
+    }, threads);
+
+    if (!_spanningGeometries.empty()) {
+        VerticalResolver resolver(_geometry, _metrics, _spanningWindowGeometries);
+        resolver.restrictInitialCollisions(_spanningGeometries);
+        resolver.resolveCollisions();
+    }
+
+    parallelFor(_windows.size(), [this](std::size_t index) {
+        HorizontalResolver resolver(_geometry, _metrics, _windows[index].horizontalGeometries);
+        resolver.resolveCollisions();
+    }, threads);
+}
+
+void WindowedCollisionHandler::buildWindows(std::size_t windowMeasures) {
+    _windows.clear();
+    _spanningGeometries.clear();
+    _spanningWindowGeometries.clear();
+
+    auto verticalGeometries = VerticalResolver::collectGeometries(_geometry);
+    auto horizontalGeometries = HorizontalResolver::collectGeometries(_geometry);
+
+    auto& measures = _geometry.measureGeometries();
+    if (windowMeasures == 0 || measures.size() <= windowMeasures) {
+        _windows.push_back(Window{std::move(verticalGeometries), std::move(horizontalGeometries)});
+        return;
+    }
+
+    std::vector<std::pair<coord_t, coord_t>> verticalExtents;
+    verticalExtents.reserve(verticalGeometries.size());
+    for (auto geometry : verticalGeometries)
+        verticalExtents.push_back(extent(*geometry));
+
+    // The horizontal resolver moves whole chords, so notes take the extent of their chord
+    std::vector<std::pair<coord_t, coord_t>> horizontalExtents;
+    horizontalExtents.reserve(horizontalGeometries.size());
+    for (auto geometry : horizontalGeometries) {
+        auto noteExtent = extent(*geometry);
+        auto chordExtent = extent(*geometry->parentGeometry());
+        horizontalExtents.push_back({std::min(noteExtent.first, chordExtent.first), std::max(noteExtent.second, chordExtent.second)});
+    }
+
+    // Find the places where no geometry other than a spanning one crosses
+    std::vector<std::pair<coord_t, coord_t>> extents;
+    extents.reserve(verticalExtents.size() + horizontalExtents.size());
+    for (std::size_t i = 0; i < verticalGeometries.size(); i += 1) {
+        if (!dynamic_cast<const SpanDirectionGeometry*>(verticalGeometries[i]))
+            extents.push_back(verticalExtents[i]);
+    }
+    extents.insert(extents.end(), horizontalExtents.begin(), horizontalExtents.end());
+    std::sort(extents.begin(), extents.end());
+
+    std::vector<coord_t> gaps;
+    if (!extents.empty()) {
+        coord_t maxX = extents.front().second;
+        for (std::size_t i = 1; i < extents.size(); i += 1) {
+            if (extents[i].first > maxX + kGapSlack)
+                gaps.push_back(extents[i].first);
+            maxX = std::max(maxX, extents[i].second);
+        }
+    }
+
+    std::vector<coord_t> measureStarts;
+    measureStarts.reserve(measures.size());
+    for (auto measure : measures)
+        measureStarts.push_back(measure->frame().origin.x);
+
+    // Close each window at the first gap after its last measure
+    std::vector<coord_t> cuts;
+    std::size_t begin = 0;
+    while (begin + windowMeasures < measures.size()) {
+        auto gap = std::lower_bound(gaps.begin(), gaps.end(), measureStarts[begin + windowMeasures]);
+        if (gap == gaps.end())
+            break;
+        cuts.push_back(*gap);
+
+        auto measure = std::upper_bound(measureStarts.begin(), measureStarts.end(), *gap);
+        begin = static_cast<std::size_t>(measure - measureStarts.begin()) - 1;
+    }
+
+    _windows.resize(cuts.size() + 1);
+    std::vector<std::size_t> firstWindows;
+    firstWindows.reserve(verticalGeometries.size());
+    std::vector<bool> spannedWindows(_windows.size(), false);
+    for (std::size_t i = 0; i < verticalGeometries.size(); i += 1) {
+        auto first = std::upper_bound(cuts.begin(), cuts.end(), verticalExtents[i].first) - cuts.begin();
+        auto last = std::upper_bound(cuts.begin(), cuts.end(), verticalExtents[i].second + kGapSlack) - cuts.begin();
+        if (last != first)
+            _spanningGeometries.push_back(verticalGeometries[i]);
+        for (auto window = first; window <= last; window += 1) {
+            _windows[window].verticalGeometries.push_back(verticalGeometries[i]);
+            if (last != first)
+                spannedWindows[window] = true;
+        }
+        firstWindows.push_back(static_cast<std::size_t>(first));
+    }
+
+    // The second pass only needs the windows crossed by spanning geometries, all of a spanning geometry's windows
+    // are crossed so checking the first one is enough
+    for (std::size_t i = 0; i < verticalGeometries.size(); i += 1) {
+        if (spannedWindows[firstWindows[i]])
+            _spanningWindowGeometries.push_back(verticalGeometries[i]);
+    }
+
+    for (std::size_t i = 0; i < horizontalGeometries.size(); i += 1) {
+        auto window = std::upper_bound(cuts.begin(), cuts.end(), horizontalExtents[i].first) - cuts.begin();
+        _windows[window].horizontalGeometries.push_back(horizontalGeometries[i]);
+    }
+}
+
+std::pair<coord_t, coord_t> WindowedCollisionHandler::extent(const Geometry& geometry) const {
+    const Rect frame = _geometry.convertFromGeometry(geometry.frame(), geometry.parentGeometry());
+    return {frame.min().x, frame.max().x};
+}
+
+} // namespace mxml
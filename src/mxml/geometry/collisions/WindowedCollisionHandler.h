@@ -0,0 +1,85 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "VerticalResolver.h"
+#include "HorizontalResolver.h"
+
+#include <utility>
+#include <vector>
+
+namespace mxml {
+
+    class PartGeometry;
+
+    /**
+     Resolves the collisions of a part one window of measures at a time.
+
+     Geometries only collide with geometries that they overlap horizontally, and the vertical resolver never changes
+     horizontal extents. A window boundary placed where no geometry crosses it therefore splits the work without
+     changing the result. Each window covers at least `windowMeasures` measures and ends at the next such gap.
+
+     Spanning geometries such as wedges, pedals and octave shifts are not considered when looking for gaps, otherwise a
+     long pedal line would keep the whole part in one window. A spanning geometry that crosses a window boundary is
+     added to every window it overlaps, so that it is avoided when looking for free positions, but its collisions are
+     left to a second pass over the windows it overlaps that starts from those collisions only.
+
+     This is where windows can change the result. Inside a window a spanning geometry is only an obstacle, and its own
+     collisions are resolved after everything else. A single pass over the whole part resolves all collisions in order
+     of priority, so when a spanning geometry collides with something the other geometries may end up in different
+     places. Use a `windowMeasures` of 0 when the result must match a single pass exactly.
+
+     Windows don't move shared geometries and can be resolved in parallel.
+     */
+    class WindowedCollisionHandler {
+    public:
+        static const std::size_t kDefaultWindowMeasures;
+
+        struct Window {
+            std::vector<Geometry*> verticalGeometries;
+            std::vector<Geometry*> horizontalGeometries;
+        };
+
+    public:
+        /**
+         @param windowMeasures The minimum number of measures in a window, 0 makes the whole part a single window.
+         */
+        WindowedCollisionHandler(const PartGeometry& geometry, const Metrics& metrics, std::size_t windowMeasures = kDefaultWindowMeasures);
+
+        const std::vector<Window>& windows() const {
+            return _windows;
+        }
+
+        /// The spanning geometries that cross a window boundary
+        const std::vector<Geometry*>& spanningGeometries() const {
+            return _spanningGeometries;
+        }
+
+        /// The geometries of the windows crossed by spanning geometries, these are the only ones in the second pass
+        const std::vector<Geometry*>& spanningWindowGeometries() const {
+            return _spanningWindowGeometries;
+        }
+
+        /**
+         Resolve all collisions using up to `threads` threads, 0 means one per hardware thread.
+         */
+        void resolveCollisions(std::size_t threads = 1);
+
+    private:
+        void buildWindows(std::size_t windowMeasures);
+
+        /// The horizontal extent of a geometry in the part's coordinates
+        std::pair<coord_t, coord_t> extent(const Geometry& geometry) const;
+
+    private:
+        const PartGeometry& _geometry;
+        const Metrics& _metrics;
+        std::vector<Window> _windows;
+        std::vector<Geometry*> _spanningGeometries;
+        std::vector<Geometry*> _spanningWindowGeometries;
+    };
+
+}
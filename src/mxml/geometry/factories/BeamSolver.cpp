@@ -0,0 +1,217 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BeamSolver.h"
+#include <mxml/geometry/NoteGeometry.h>
+
+#include <algorithm>
+
+
+namespace mxml {
+
+void BeamSolver::solve(const std::vector<BeamGeometry*>& beams) {
+    gather(beams);
+    solveBeamLines();
+    broadcast();
+    solveStemLimits();
+    broadcast();
+    solveStemLengths();
+    scatter(beams);
+}
+
+void BeamSolver::gather(const std::vector<BeamGeometry*>& beams) {
+    _beamBegin.clear();
+    _beamEnd.clear();
+    _beamUp.clear();
+    _firstLocation.clear();
+    _lastLocation.clear();
+    _chords.clear();
+
+    for (auto beam : beams) {
+        auto& chords = beam->_chords;
+        if (chords.size() <= 1)
+            continue;
+
+        const ChordGeometry* first = chords.front();
+        const ChordGeometry* last = chords.back();
+
+        auto stemDirection = dom::Stem::Up;
+        if (first->stem())
+            stemDirection = first->stem()->stemDirection();
+
+        _beamBegin.push_back(_chords.size());
+        _beamUp.push_back(stemDirection == dom::Stem::Up);
+
+        // The beam starts from the chord locations before flags are removed
+        _firstLocation.push_back(first->convertToGeometry(first->refNoteLocation(), first->parentGeometry()));
+        _lastLocation.push_back(last->convertToGeometry(last->refNoteLocation(), last->parentGeometry()));
+
+        _chords.insert(_chords.end(), chords.begin(), chords.end());
+        _beamEnd.push_back(_chords.size());
+    }
+
+    const auto count = _chords.size();
+    _up.resize(count);
+    _locationX.resize(count);
+    _frameStemX.resize(count);
+    _frameMinY.resize(count);
+    _frameMaxY.resize(count);
+    _notesMinY.resize(count);
+    _notesMaxY.resize(count);
+    _beamsWidth.resize(count);
+    _innerBeamsWidth.resize(count);
+
+    for (std::size_t i = 0; i < count; i += 1) {
+        ChordGeometry* chordGeom = _chords[i];
+        chordGeom->setShowFlags(false);
+
+        const Rect frame = chordGeom->frame();
+        const Rect notesFrame = chordGeom->notesFrame();
+        const auto beamCount = chordGeom->chord().firstNote()->beams().size();
+
+        _up[i] = chordGeom->stem()->stemDirection() == dom::Stem::Up;
+        _locationX[i] = chordGeom->location().x;
+        if (_up[i])
+            _frameStemX[i] = frame.origin.x + chordGeom->size().width - BeamGeometry::kStemLineWidth/2;
+        else
+            _frameStemX[i] = frame.origin.x + BeamGeometry::kStemLineWidth/2;
+        _frameMinY[i] = frame.min().y;
+        _frameMaxY[i] = frame.max().y;
+        _notesMinY[i] = notesFrame.min().y;
+        _notesMaxY[i] = notesFrame.max().y;
+        _beamsWidth[i] = beamCount * (BeamGeometry::kBeamLineWidth + BeamGeometry::kBeamLineSpacing);
+        _innerBeamsWidth[i] = (beamCount - 1) * (BeamGeometry::kBeamLineWidth + BeamGeometry::kBeamLineSpacing);
+    }
+}
+
+void BeamSolver::solveBeamLines() {
+    const auto count = _beamBegin.size();
+    _lineBegin.resize(count);
+    _lineEnd.resize(count);
+    _slope.resize(count);
+
+    for (std::size_t b = 0; b < count; b += 1) {
+        const auto first = _beamBegin[b];
+        const auto last = _beamEnd[b] - 1;
+
+        Point begin;
+        if (_beamUp[b]) {
+            begin.x = _firstLocation[b].x + NoteGeometry::kQuarterWidth/2 - BeamGeometry::kStemLineWidth;
+            begin.y = _frameMinY[first];
+        } else {
+            begin.x = _firstLocation[b].x - NoteGeometry::kQuarterWidth/2;
+            begin.y = _frameMaxY[first];
+        }
+
+        Point end;
+        if (_up[last]) {
+            end.x = _lastLocation[b].x + NoteGeometry::kQuarterWidth/2;
+            end.y = _frameMinY[last];
+        } else {
+            end.x = _lastLocation[b].x - NoteGeometry::kQuarterWidth/2 + BeamGeometry::kStemLineWidth;
+            end.y = _frameMaxY[last];
+        }
+
+        if (end.x == begin.x)
+            end.x = begin.x + NoteGeometry::kQuarterWidth;
+
+        // Cap slope
+        const Point midPoint = {(end.x + begin.x)/2, (end.y + begin.y)/2};
+        coord_t s = (end.y - begin.y) / (end.x - begin.x);
+        if (s > BeamGeometry::kMaxSlope) {
+            s = BeamGeometry::kMaxSlope;
+        } else if (s < -BeamGeometry::kMaxSlope) {
+            s = -BeamGeometry::kMaxSlope;
+        }
+        begin.y = midPoint.y - s * (midPoint.x - begin.x);
+        end.y = midPoint.y - s * (midPoint.x - end.x);
+
+        _lineBegin[b] = begin;
+        _lineEnd[b] = end;
+        _slope[b] = s;
+    }
+}
+
+void BeamSolver::broadcast() {
+    const auto count = _chords.size();
+    _chordBeamUp.resize(count);
+    _chordLineEndX.resize(count);
+    _chordLineEndY.resize(count);
+    _chordSlope.resize(count);
+
+    for (std::size_t b = 0; b < _beamBegin.size(); b += 1) {
+        for (std::size_t i = _beamBegin[b]; i < _beamEnd[b]; i += 1) {
+            _chordBeamUp[i] = _beamUp[b];
+            _chordLineEndX[i] = _lineEnd[b].x;
+            _chordLineEndY[i] = _lineEnd[b].y;
+            _chordSlope[i] = _slope[b];
+        }
+    }
+}
+
+void BeamSolver::solveStemLimits() {
+    // Find how far each chord would move its beam away so that the stem is not too short
+    const auto count = _chords.size();
+    _offset.resize(count);
+    for (std::size_t i = 0; i < count; i += 1) {
+        const coord_t lineY = _chordLineEndY[i] - _chordSlope[i] * (_chordLineEndX[i] - _frameStemX[i]);
+        const coord_t upOffset = _notesMinY[i] - BeamGeometry::kMinStem - _beamsWidth[i] - (lineY - BeamGeometry::kBeamLineWidth/2);
+        const coord_t downOffset = _notesMaxY[i] + BeamGeometry::kMinStem + _beamsWidth[i] - (lineY + BeamGeometry::kBeamLineWidth/2);
+        _offset[i] = _up[i] ? (upOffset < 0 ? upOffset : 0) : (downOffset > 0 ? downOffset : 0);
+    }
+
+    // Combine the offsets in chord order, an upward move can be undone by a later downward one and the other way around
+    for (std::size_t b = 0; b < _beamBegin.size(); b += 1) {
+        coord_t dy = 0;
+        for (std::size_t i = _beamBegin[b]; i < _beamEnd[b]; i += 1) {
+            if (_up[i])
+                dy = std::min(dy, _offset[i]);
+            else
+                dy = std::max(dy, _offset[i]);
+        }
+        _lineBegin[b].y += dy;
+        _lineEnd[b].y += dy;
+    }
+}
+
+void BeamSolver::solveStemLengths() {
+    const auto count = _chords.size();
+    _stemEnd.resize(count);
+    for (std::size_t i = 0; i < count; i += 1) {
+        const coord_t upBeamx = _locationX[i] + NoteGeometry::kQuarterWidth/2 - BeamGeometry::kStemLineWidth/2;
+        const coord_t downBeamx = _locationX[i] - NoteGeometry::kQuarterWidth/2 + BeamGeometry::kStemLineWidth/2;
+        const coord_t beamx = _up[i] ? upBeamx : downBeamx;
+
+        // Inner beams are stacked towards the notes of chords on the other side of the beam
+        coord_t beamy = 0;
+        if (_up[i] && !_chordBeamUp[i])
+            beamy = -_innerBeamsWidth[i];
+        else if (!_up[i] && _chordBeamUp[i])
+            beamy = _innerBeamsWidth[i];
+
+        _stemEnd[i] = beamy + (_chordLineEndY[i] - _chordSlope[i] * (_chordLineEndX[i] - beamx));
+    }
+}
+
+void BeamSolver::scatter(const std::vector<BeamGeometry*>& beams) {
+    for (std::size_t i = 0; i < _chords.size(); i += 1)
+        _chords[i]->extendStem(_stemEnd[i]);
+
+    std::size_t b = 0;
+    for (auto beam : beams) {
+        if (beam->_chords.size() <= 1)
+            continue;
+
+        beam->_placement = _beamUp[b] ? dom::Placement::Below : dom::Placement::Above;
+        beam->_beamBegin = _lineBegin[b];
+        beam->_beamEnd = _lineEnd[b];
+        beam->setLocation(_firstLocation[b]);
+        beam->recomputeFrame();
+        b += 1;
+    }
+}
+
+} // namespace mxml
@@ -0,0 +1,74 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/geometry/BeamGeometry.h>
+
+#include <cstdint>
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Lays out a batch of beams at once. The chords of all the beams are read once into flat arrays, one entry per chord,
+ then beam lines and stem lengths are computed with plain loops over those arrays and finally written back to the
+ geometries.
+ */
+class BeamSolver {
+public:
+    /**
+     Set the beam lines of the beams and extend the stems of their chords to reach them. Beams must not share chords.
+     */
+    void solve(const std::vector<BeamGeometry*>& beams);
+
+private:
+    void gather(const std::vector<BeamGeometry*>& beams);
+    void solveBeamLines();
+    void solveStemLimits();
+    void solveStemLengths();
+    void scatter(const std::vector<BeamGeometry*>& beams);
+
+    /// Copy per-beam values to the chords of each beam
+    void broadcast();
+
+private:
+    // Per beam
+    std::vector<std::size_t> _beamBegin;
+    std::vector<std::size_t> _beamEnd;
+    std::vector<std::uint8_t> _beamUp;
+    std::vector<Point> _firstLocation;
+    std::vector<Point> _lastLocation;
+    std::vector<Point> _lineBegin;
+    std::vector<Point> _lineEnd;
+    std::vector<coord_t> _slope;
+
+    // Per chord
+    std::vector<ChordGeometry*> _chords;
+    std::vector<std::uint8_t> _up;
+    std::vector<std::uint8_t> _chordBeamUp;
+    std::vector<coord_t> _locationX;
+
+    /// The x coordinate of the stem at the edge of the chord's frame
+    std::vector<coord_t> _frameStemX;
+    std::vector<coord_t> _frameMinY;
+    std::vector<coord_t> _frameMaxY;
+    std::vector<coord_t> _notesMinY;
+    std::vector<coord_t> _notesMaxY;
+    std::vector<coord_t> _beamsWidth;
+    std::vector<coord_t> _innerBeamsWidth;
+    std::vector<coord_t> _chordLineEndX;
+    std::vector<coord_t> _chordLineEndY;
+    std::vector<coord_t> _chordSlope;
+
+    /// How far the beam has to move for the chord's stem to be long enough, 0 if it doesn't
+    std::vector<coord_t> _offset;
+
+    /// The y coordinate where the chord's stem meets the beam
+    std::vector<coord_t> _stemEnd;
+};
+
+} // namespace mxml
@@ -7,9 +7,45 @@
 #include "ChordGeometryFactory.h"
 #include <mxml/geometry/FermataGeometry.h>
 
+#include <type_traits>
+
 
 namespace mxml {
 
+namespace {
+
+/// Append the bytes of a scalar. Structs go field by field so that their padding never ends up in a signature.
+template <typename T>
+void appendValue(std::string& signature, const T& value) {
+    static_assert(std::is_scalar<T>::value, "Append the fields of a struct separately");
+    signature.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+void appendValue(std::string& signature, const dom::Optional<T>& optional) {
+    appendValue(signature, optional.isPresent());
+    appendValue(signature, optional.value());
+}
+
+void appendValue(std::string& signature, const Point& point) {
+    appendValue(signature, point.x);
+    appendValue(signature, point.y);
+}
+
+void appendValue(std::string& signature, const Size& size) {
+    appendValue(signature, size.width);
+    appendValue(signature, size.height);
+}
+
+} // namespace
+
+double ChordGeometryFactory::CacheStatistics::hitRate() const {
+    const auto lookups = hits + misses;
+    if (lookups == 0)
+        return 0;
+    return static_cast<double>(hits) / static_cast<double>(lookups);
+}
+
 ChordGeometryFactory::ChordGeometryFactory(const ScoreProperties& scoreProperties, const Metrics& metrics)
 : _scoreProperties(scoreProperties),
   _metrics(metrics)
@@ -20,12 +56,22 @@ std::unique_ptr<ChordGeometry> ChordGeometryFactory::build(const dom::Chord& cho
     if (!chord.firstNote() || !chord.firstNote()->printObject)
         return {};
 
-    _geometry.reset(new ChordGeometry{chord});
+    const auto signature = buildSignature(chord);
+    auto it = _buildLayouts.find(signature);
+    if (it != _buildLayouts.end()) {
+        _buildStatistics.hits += 1;
+        instantiate(chord, it->second);
+    } else {
+        _buildStatistics.misses += 1;
+        _geometry.reset(new ChordGeometry{chord});
+
+        Rect notesFrame = buildNotes(chord);
+        buildAccidentals(notesFrame);
+        buildNotations(chord, notesFrame);
+        buildStem(chord);
 
-    Rect notesFrame = buildNotes(chord);
-    buildAccidentals(notesFrame);
-    buildNotations(chord, notesFrame);
-    buildStem(chord);
+        _buildLayouts.emplace(signature, recordLayout(*_geometry, notesFrame));
+    }
 
     _geometry->setBounds(_geometry->subGeometriesFrame());
 
@@ -36,12 +82,25 @@ void ChordGeometryFactory::resetForStem(ChordGeometry* chordGeometry) {
     if (!chordGeometry->stem())
         return;
 
-    Rect notesFrame = placeNotes(chordGeometry);
+    // Articulations are placed after the stem because they don't affect it and they are not part of the layout
+    Rect notesFrame;
+    const auto signature = stemSignature(*chordGeometry);
+    auto it = _stemLayouts.find(signature);
+    if (it != _stemLayouts.end()) {
+        _stemStatistics.hits += 1;
+        applyLayout(chordGeometry, it->second);
+        notesFrame = it->second.notesFrame;
+    } else {
+        _stemStatistics.misses += 1;
+        notesFrame = placeNotes(chordGeometry);
+        placeStem(chordGeometry);
+        _stemLayouts.emplace(signature, recordLayout(*chordGeometry, notesFrame));
+    }
+
     for (auto& geom : chordGeometry->geometries()) {
         if (auto articulationGeometry = dynamic_cast<ArticulationGeometry*>(geom.get()))
             placeArticulation(chordGeometry, articulationGeometry, notesFrame);
     }
-    placeStem(chordGeometry);
 
     chordGeometry->setBounds(chordGeometry->subGeometriesFrame());
 }
@@ -127,7 +186,7 @@ void ChordGeometryFactory::buildNotations(const dom::Chord& chord, const Rect& n
         return;
 
     Rect frame = notesFrame;
-    const auto& notations = note->notations;
+    auto notations = note->notations.get();
     for (auto& artic : notations->articulations) {
         buildArticulation(chord, *artic, frame);
     }
@@ -313,4 +372,137 @@ void ChordGeometryFactory::placeStem(ChordGeometry* chordGeometry) {
     stem->setLocation(stemLocation);
 }
 
+
+#pragma mark - Layout cache
+
+std::string ChordGeometryFactory::buildSignature(const dom::Chord& chord) const {
+    const dom::Note* firstNote = chord.firstNote();
+
+    std::string signature;
+    appendValue(signature, chord.stem().value());
+    appendValue(signature, firstNote->type());
+    appendValue(signature, firstNote->beams().empty());
+    appendValue(signature, _metrics.staffOrigin(firstNote->staff()));
+
+    for (auto& note : chord.notes()) {
+        appendValue(signature, _metrics.noteY(*note));
+        appendValue(signature, NoteGeometry::Size(*note).width);
+        appendValue(signature, _metrics.staffOrigin(note->staff()));
+
+        const bool dot = static_cast<bool>(note->dot);
+        appendValue(signature, dot);
+        if (dot)
+            appendValue(signature, note->dot->placement() == dom::Placement::Above);
+
+        // Accidentals that are not shown don't change the layout
+        int alter = note->alter();
+        bool accidental = note->pitch && alter != _scoreProperties.alter(*note);
+        appendValue(signature, accidental);
+        if (accidental)
+            appendValue(signature, alter);
+    }
+
+    return signature;
+}
+
+std::string ChordGeometryFactory::stemSignature(const ChordGeometry& chordGeometry) const {
+    auto stem = chordGeometry.stem();
+
+    std::string signature;
+    appendValue(signature, stem->stemDirection());
+    appendValue(signature, stem->size());
+    appendValue(signature, stem->location());
+    appendValue(signature, _metrics.staffOrigin(chordGeometry.staff()));
+
+    for (auto& note : chordGeometry.notes()) {
+        appendValue(signature, note->location());
+        appendValue(signature, note->size());
+    }
+
+    return signature;
+}
+
+ChordGeometryFactory::Layout ChordGeometryFactory::recordLayout(const ChordGeometry& chordGeometry, const Rect& notesFrame) const {
+    Layout layout;
+    for (auto& note : chordGeometry.notes())
+        layout.notes.push_back(note->location());
+
+    for (auto& geom : chordGeometry.geometries()) {
+        if (auto dot = dynamic_cast<const DotGeometry*>(geom.get()))
+            layout.dots.push_back(dot->location());
+        else if (auto accidental = dynamic_cast<const AccidentalGeometry*>(geom.get()))
+            layout.accidentals.emplace_back(accidental->alter(), accidental->location());
+    }
+
+    layout.refNoteLocation = chordGeometry.refNoteLocation();
+    layout.notesFrame = notesFrame;
+
+    if (auto stem = chordGeometry.stem()) {
+        layout.stem = true;
+        layout.stemSize = stem->size();
+        layout.stemLocation = stem->location();
+    }
+
+    return layout;
+}
+
+void ChordGeometryFactory::applyLayout(ChordGeometry* chordGeometry, const Layout& layout) const {
+    for (std::size_t i = 0; i < chordGeometry->_notes.size(); i += 1)
+        chordGeometry->_notes[i]->setLocation(layout.notes[i]);
+    chordGeometry->_refNoteLocation = layout.refNoteLocation;
+
+    if (chordGeometry->_stem)
+        applyStemLayout(chordGeometry->_stem, layout);
+}
+
+void ChordGeometryFactory::applyStemLayout(StemGeometry* stem, const Layout& layout) {
+    if (stem->stemDirection() == dom::Stem::Up)
+        stem->setVerticalAnchorPointValues(1, -NoteGeometry::kHeight/2);
+    else
+        stem->setVerticalAnchorPointValues(0, NoteGeometry::kHeight/2);
+    stem->setHorizontalAnchorPointValues(0, NoteGeometry::kQuarterWidth/2);
+    stem->setSize(layout.stemSize);
+    stem->setLocation(layout.stemLocation);
+}
+
+void ChordGeometryFactory::instantiate(const dom::Chord& chord, const Layout& layout) {
+    _geometry.reset(new ChordGeometry{chord});
+
+    for (auto& note : chord.notes()) {
+        std::unique_ptr<NoteGeometry> geom(new NoteGeometry(*note));
+        _geometry->_notes.push_back(geom.get());
+        _geometry->addGeometry(std::move(geom));
+    }
+
+    auto dotLocation = layout.dots.begin();
+    for (auto& noteGeometry : _geometry->_notes) {
+        if (!noteGeometry->note().dot)
+            continue;
+
+        std::unique_ptr<DotGeometry> dotGeom(new DotGeometry);
+        dotGeom->setLocation(*dotLocation);
+        dotLocation += 1;
+        _geometry->addGeometry(std::move(dotGeom));
+    }
+
+    for (auto& accidental : layout.accidentals) {
+        std::unique_ptr<AccidentalGeometry> accGeom(new AccidentalGeometry(accidental.first));
+        accGeom->setLocation(accidental.second);
+        _geometry->addGeometry(std::move(accGeom));
+    }
+
+    applyLayout(_geometry.get(), layout);
+
+    // Notations are placed around the notes frame and are not part of the layout
+    buildNotations(chord, layout.notesFrame);
+
+    if (layout.stem) {
+        const dom::Note* note = chord.firstNote();
+        std::unique_ptr<StemGeometry> stem(new StemGeometry(*note, note->beams().empty()));
+        applyStemLayout(stem.get(), layout);
+        _geometry->_stem = stem.get();
+        _geometry->addGeometry(std::move(stem));
+    }
+}
+
 } // namespace mxml
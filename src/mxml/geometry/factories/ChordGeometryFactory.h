@@ -11,13 +11,30 @@
 #include <mxml/geometry/NoteGeometry.h>
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace mxml {
 
 class ChordGeometry;
 
+/**
+ Builds chord geometries. Scores repeat the same chord shapes over and over, so the local layout of notes, dots,
+ accidentals and stems is computed once per chord signature and reused. A signature holds every input of the layout:
+ note positions, note and stem types, dots, visible accidentals and staff origins.
+ */
 class ChordGeometryFactory {
+public:
+    struct CacheStatistics {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+
+        /// The fraction of lookups that were hits, 0 if there were no lookups
+        double hitRate() const;
+    };
+
 public:
     ChordGeometryFactory(const ScoreProperties& scoreProperties, const Metrics& metrics);
 
@@ -26,6 +43,43 @@ public:
     // Adjust placement of subgeometries based on new stem orientation
     void resetForStem(ChordGeometry* chordGeometry);
 
+    /// Layout cache statistics for `build`
+    const CacheStatistics& buildStatistics() const {
+        return _buildStatistics;
+    }
+
+    /// Layout cache statistics for `resetForStem`
+    const CacheStatistics& stemStatistics() const {
+        return _stemStatistics;
+    }
+
+private:
+    /// The layout computed for a chord signature, in the chord's coordinate system
+    struct Layout {
+        /// Note locations, in the order of the chord's notes
+        std::vector<Point> notes;
+
+        /// Dot locations, in the order of the dotted notes
+        std::vector<Point> dots;
+
+        /// Alter and location of the visible accidentals, in the order of their notes
+        std::vector<std::pair<int, Point>> accidentals;
+
+        Point refNoteLocation;
+        Rect notesFrame;
+
+        bool stem = false;
+        Size stemSize;
+        Point stemLocation;
+    };
+
+    std::string buildSignature(const dom::Chord& chord) const;
+    std::string stemSignature(const ChordGeometry& chordGeometry) const;
+    Layout recordLayout(const ChordGeometry& chordGeometry, const Rect& notesFrame) const;
+    void applyLayout(ChordGeometry* chordGeometry, const Layout& layout) const;
+    void instantiate(const dom::Chord& chord, const Layout& layout);
+    static void applyStemLayout(StemGeometry* stem, const Layout& layout);
+
 private:
     Rect buildNotes(const dom::Chord& chord);
     void buildDot(const NoteGeometry& noteGeom);
@@ -45,6 +99,11 @@ private:
     const Metrics& _metrics;
 
     std::unique_ptr<ChordGeometry> _geometry;
+
+    std::unordered_map<std::string, Layout> _buildLayouts;
+    std::unordered_map<std::string, Layout> _stemLayouts;
+    CacheStatistics _buildStatistics;
+    CacheStatistics _stemStatistics;
 };
 
 } // namespace mxml
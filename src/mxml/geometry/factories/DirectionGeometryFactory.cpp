@@ -53,7 +53,7 @@ std::vector<std::unique_ptr<PlacementGeometry>> DirectionGeometryFactory::build(
 
     for (auto& measure: _measureGeometries) {
         for (auto& node : measure->measure().nodes()) {
-            if (const dom::Direction* direction = dynamic_cast<const dom::Direction*>(node.get()))
+            if (const dom::Direction* direction = dom::nodeCast<dom::Direction>(node.get()))
                 buildDirection(*measure, *direction);
         }
     }
@@ -62,18 +62,18 @@ std::vector<std::unique_ptr<PlacementGeometry>> DirectionGeometryFactory::build(
     for (auto& pair : _openSpanDirections) {
         auto measureGeometry = pair.first;
         auto direction = pair.second;
-        if (dynamic_cast<const dom::OctaveShift*>(direction->type())) {
+        if (dom::nodeCast<dom::OctaveShift>(direction->type())) {
             buildOctaveShiftToEdge(*measureGeometry, *direction);
-        } else if (dynamic_cast<const dom::Pedal*>(direction->type())) {
+        } else if (dom::nodeCast<dom::Pedal>(direction->type())) {
             buildPedalToEdge(*measureGeometry, *direction);
         }
     }
 
     // Build directions that neither started or stopped
     for (auto& direction : _previouslyOpenSpanDirections) {
-        if (dynamic_cast<const dom::OctaveShift*>(direction->type())) {
+        if (dom::nodeCast<dom::OctaveShift>(direction->type())) {
             buildOctaveShiftFromEdgeToEdge(*direction);
-        } else if (dynamic_cast<const dom::Pedal*>(direction->type())) {
+        } else if (dom::nodeCast<dom::Pedal>(direction->type())) {
             buildPedalFromEdgeToEdge(*direction);
         }
     }
@@ -82,40 +82,41 @@ std::vector<std::unique_ptr<PlacementGeometry>> DirectionGeometryFactory::build(
 }
 
 void DirectionGeometryFactory::buildDirection(const MeasureGeometry& measureGeom, const dom::Direction& direction) {
-    if (dynamic_cast<const dom::Wedge*>(direction.type())) {
-        buildWedge(measureGeom, direction);
+    if (!direction.type())
         return;
-    }
 
-    if (dynamic_cast<const dom::Pedal*>(direction.type())) {
-        buildPedal(measureGeom, direction);
-        return;
-    }
+    switch (direction.type()->kind()) {
+        case dom::Node::Kind::Wedge:
+            buildWedge(measureGeom, direction);
+            break;
 
-    if (dynamic_cast<const dom::OctaveShift*>(direction.type())) {
-        buildOctaveShift(measureGeom, direction);
-        return;
-    }
+        case dom::Node::Kind::Pedal:
+            buildPedal(measureGeom, direction);
+            break;
 
-    if (dynamic_cast<const dom::Coda*>(direction.type())) {
-        buildCoda(measureGeom, direction);
-        return;
-    }
+        case dom::Node::Kind::OctaveShift:
+            buildOctaveShift(measureGeom, direction);
+            break;
 
-    if (dynamic_cast<const dom::Segno*>(direction.type())) {
-        buildSegno(measureGeom, direction);
-        return;
-    }
+        case dom::Node::Kind::Coda:
+            buildCoda(measureGeom, direction);
+            break;
 
-    if (dynamic_cast<const dom::Words*>(direction.type()) ||
-        dynamic_cast<const dom::Dynamics*>(direction.type()) ) {
-        buildWords(measureGeom, direction);
-        return;
-    }
-    
-    if (dynamic_cast<const dom::Bracket*>(direction.type())) {
-        buildBracket(measureGeom, direction);
-        return;
+        case dom::Node::Kind::Segno:
+            buildSegno(measureGeom, direction);
+            break;
+
+        case dom::Node::Kind::Words:
+        case dom::Node::Kind::Dynamics:
+            buildWords(measureGeom, direction);
+            break;
+
+        case dom::Node::Kind::Bracket:
+            buildBracket(measureGeom, direction);
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -146,10 +147,10 @@ void DirectionGeometryFactory::placeDirection(PlacementGeometry& geometry) {
 void DirectionGeometryFactory::buildWedge(const MeasureGeometry& measureGeom, const dom::Direction& direction) {
     using dom::Wedge;
 
-    const Wedge& wedge = dynamic_cast<const Wedge&>(*direction.type());
+    const Wedge& wedge = static_cast<const Wedge&>(*direction.type());
     if (wedge.type() == Wedge::Type::Stop) {
         auto it = std::find_if(_openSpanDirections.rbegin(), _openSpanDirections.rend(), [wedge](std::pair<const MeasureGeometry*, const dom::Direction*> pair) {
-            if (const Wedge* startWedge = dynamic_cast<const Wedge*>(pair.second->type()))
+            if (const Wedge* startWedge = dom::nodeCast<Wedge>(pair.second->type()))
                 return startWedge->number() == wedge.number();
             return false;
         });
@@ -200,7 +201,7 @@ void DirectionGeometryFactory::buildWedge(const MeasureGeometry& startMeasureGeo
 void DirectionGeometryFactory::buildPedal(const MeasureGeometry& measureGeom, const dom::Direction& direction) {
     using dom::Pedal;
 
-    const Pedal& pedal = dynamic_cast<const Pedal&>(*direction.type());
+    const Pedal& pedal = static_cast<const Pedal&>(*direction.type());
     if (pedal.type() == dom::kStop) {
         auto pair = pullPedalStart(measureGeom, direction);
         if (pair.first) {
@@ -215,7 +216,7 @@ void DirectionGeometryFactory::buildPedal(const MeasureGeometry& measureGeom, co
 
 DirectionGeometryFactory::MDPair DirectionGeometryFactory::pullPedalStart(const MeasureGeometry& stopMeasure, const dom::Direction& stopDirection) {
     auto it = std::find_if(_openSpanDirections.rbegin(), _openSpanDirections.rend(), [&](std::pair<const MeasureGeometry*, const dom::Direction*> pair) {
-        if (dynamic_cast<const dom::Pedal*>(pair.second->type()))
+        if (dom::nodeCast<dom::Pedal>(pair.second->type()))
             return pair.second->staff() == stopDirection.staff();
         return false;
     });
@@ -226,7 +227,7 @@ DirectionGeometryFactory::MDPair DirectionGeometryFactory::pullPedalStart(const
     }
 
     auto pit = std::find_if(_previouslyOpenSpanDirections.rbegin(), _previouslyOpenSpanDirections.rend(), [&](const dom::Direction* d) {
-        if (dynamic_cast<const dom::Pedal*>(d->type()))
+        if (dom::nodeCast<dom::Pedal>(d->type()))
             return d->staff() == stopDirection.staff();
         return false;
     });
@@ -315,7 +316,7 @@ void DirectionGeometryFactory::buildPedalFromEdgeToEdge(const dom::Direction& st
 }
 
 void DirectionGeometryFactory::buildOctaveShift(const MeasureGeometry& measureGeom, const dom::Direction& direction) {
-    const dom::OctaveShift& octaveShift = dynamic_cast<const dom::OctaveShift&>(*direction.type());
+    const dom::OctaveShift& octaveShift = static_cast<const dom::OctaveShift&>(*direction.type());
     if (octaveShift.type == dom::OctaveShift::Type::Stop) {
         const MeasureGeometry* startMeasure;
         const dom::Direction* startDirection;
@@ -332,10 +333,10 @@ void DirectionGeometryFactory::buildOctaveShift(const MeasureGeometry& measureGe
 }
 
 DirectionGeometryFactory::MDPair DirectionGeometryFactory::pullOctaveShiftStart(const MeasureGeometry& stopMeasure, const dom::Direction& stopDirection) {
-    const dom::OctaveShift& octaveShift = dynamic_cast<const dom::OctaveShift&>(*stopDirection.type());
+    const dom::OctaveShift& octaveShift = static_cast<const dom::OctaveShift&>(*stopDirection.type());
 
     auto it = std::find_if(_openSpanDirections.rbegin(), _openSpanDirections.rend(), [&](std::pair<const MeasureGeometry*, const dom::Direction*> pair) {
-        if (auto os = dynamic_cast<const dom::OctaveShift*>(pair.second->type()))
+        if (auto os = dom::nodeCast<dom::OctaveShift>(pair.second->type()))
             return pair.second->staff() == stopDirection.staff() && os->number == octaveShift.number;
         return false;
     });
@@ -346,7 +347,7 @@ DirectionGeometryFactory::MDPair DirectionGeometryFactory::pullOctaveShiftStart(
     }
 
     auto pit = std::find_if(_previouslyOpenSpanDirections.rbegin(), _previouslyOpenSpanDirections.rend(), [&](const dom::Direction* d) {
-        if (auto os = dynamic_cast<const dom::OctaveShift*>(d->type()))
+        if (auto os = dom::nodeCast<dom::OctaveShift>(d->type()))
             return d->staff() == stopDirection.staff() && os->number == octaveShift.number;
         return false;
     });
@@ -435,7 +436,7 @@ void DirectionGeometryFactory::buildWords(const MeasureGeometry& measureGeom, co
 
     const Span& span = *measureGeom.spans().with(&direction);
     Point location;
-    if (dynamic_cast<dom::Dynamics*>(direction.type()))
+    if (dom::nodeCast<dom::Dynamics>(direction.type()))
         location.x = span.start() + span.eventOffset();
     else
         location.x = span.start() - span.leftMargin()/2;
@@ -472,7 +473,7 @@ void DirectionGeometryFactory::buildWords(const MeasureGeometry& measureGeom, co
 }
 
 void DirectionGeometryFactory::buildSegno(const MeasureGeometry& measureGeom, const dom::Direction& direction) {
-    const dom::Segno& segno = dynamic_cast<const dom::Segno&>(*direction.type());
+    const dom::Segno& segno = static_cast<const dom::Segno&>(*direction.type());
     std::unique_ptr<SegnoGeometry> segnoGeom(new SegnoGeometry(segno));
     
     // Segnos are always placed at the start of the measure
@@ -485,7 +486,7 @@ void DirectionGeometryFactory::buildSegno(const MeasureGeometry& measureGeom, co
 }
 
 void DirectionGeometryFactory::buildCoda(const MeasureGeometry& measureGeom, const dom::Direction& direction) {
-    const dom::Coda& coda = dynamic_cast<const dom::Coda&>(*direction.type());
+    const dom::Coda& coda = static_cast<const dom::Coda&>(*direction.type());
     std::unique_ptr<CodaGeometry> codaGeom(new CodaGeometry(coda));
     
     // Codas are always placed at the start of the measure
@@ -500,7 +501,7 @@ void DirectionGeometryFactory::buildCoda(const MeasureGeometry& measureGeom, con
 void DirectionGeometryFactory::buildBracket(const MeasureGeometry&  measureGeom, const dom::Direction& direction) {
         using dom::Bracket;
         bool isPage = measureGeom.scoreProperties().layoutType() == ScoreProperties::LayoutType::Page;
-        const Bracket& bracket = dynamic_cast<const Bracket&>(*direction.type());
+        const Bracket& bracket = static_cast<const Bracket&>(*direction.type());
         if (bracket.type() == dom::kStart) {
             auto pair = pullPedalStart(measureGeom, direction);
             assert(!pair.first);
@@ -0,0 +1,719 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "DisplayListFactory.h"
+
+#include "AccidentalGeometry.h"
+#include "ArticulationGeometry.h"
+#include "BarlineGeometry.h"
+#include "BeamGeometry.h"
+#include "BracketGeometry.h"
+#include "ChordGeometry.h"
+#include "ClefGeometry.h"
+#include "CodaGeometry.h"
+#include "DotGeometry.h"
+#include "EndingGeometry.h"
+#include "FermataGeometry.h"
+#include "KeyGeometry.h"
+#include "LyricConnectorGeometry.h"
+#include "LyricGeometry.h"
+#include "MeasureGeometry.h"
+#include "NoteGeometry.h"
+#include "OctaveShiftGeometry.h"
+#include "OrnamentsGeometry.h"
+#include "PageScoreGeometry.h"
+#include "PartGeometry.h"
+#include "PedalGeometry.h"
+#include "RestGeometry.h"
+#include "ScrollScoreGeometry.h"
+#include "SegnoGeometry.h"
+#include "SpanDirectionGeometry.h"
+#include "StemGeometry.h"
+#include "SystemGeometry.h"
+#include "TieGeometry.h"
+#include "TimeSignatureGeometry.h"
+#include "TupletGeometry.h"
+#include "WordsGeometry.h"
+
+#include <mxml/Metrics.h>
+#include <mxml/dom/Chord.h>
+#include <mxml/dom/OctaveShift.h>
+#include <mxml/dom/Ornaments.h>
+#include <mxml/dom/Pedal.h>
+#include <mxml/dom/Wedge.h>
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+
+namespace mxml {
+
+using dom::Note;
+
+const coord_t DisplayListFactory::kStaffLineWidth = 1;
+const coord_t DisplayListFactory::kLedgerLineWidth = 1;
+const coord_t DisplayListFactory::kLedgerLineExtension = 3;
+
+namespace {
+
+Point translate(const Point& point, const Point& translation) {
+    return {point.x + translation.x, point.y + translation.y};
+}
+
+Rect translate(const Rect& rect, const Point& translation) {
+    return Rect(translate(rect.origin, translation), rect.size);
+}
+
+/// The translation from a geometry's coordinates to root coordinates given the translation of its parent
+Point childTranslation(const Geometry& geometry, const Point& translation) {
+    const Point origin = geometry.origin();
+    const Point offset = geometry.contentOffset();
+    return {translation.x + origin.x - offset.x, translation.y + origin.y - offset.y};
+}
+
+Glyph noteheadGlyph(const Note& note) {
+    if (note.type() >= Note::Type::Breve)
+        return Glyph::NoteheadDoubleWhole;
+    if (note.type() == Note::Type::Whole)
+        return Glyph::NoteheadWhole;
+    if (note.type() == Note::Type::Half)
+        return Glyph::NoteheadHalf;
+    return Glyph::NoteheadBlack;
+}
+
+Glyph restGlyph(const Note& note) {
+    switch (note.type()) {
+        case Note::Type::Maxima:
+        case Note::Type::Long:
+        case Note::Type::Breve: return Glyph::RestDoubleWhole;
+        case Note::Type::Whole: return Glyph::RestWhole;
+        case Note::Type::Half: return Glyph::RestHalf;
+        case Note::Type::Quarter: return Glyph::RestQuarter;
+        case Note::Type::Eighth: return Glyph::Rest8th;
+        case Note::Type::_16th: return Glyph::Rest16th;
+        case Note::Type::_32nd: return Glyph::Rest32nd;
+        case Note::Type::_64th: return Glyph::Rest64th;
+        default: return Glyph::Rest128th;
+    }
+}
+
+Glyph flagGlyph(const Note& note, dom::Stem stem) {
+    const bool up = stem == dom::Stem::Up;
+    switch (note.type()) {
+        case Note::Type::Eighth: return up ? Glyph::Flag8thUp : Glyph::Flag8thDown;
+        case Note::Type::_16th: return up ? Glyph::Flag16thUp : Glyph::Flag16thDown;
+        case Note::Type::_32nd: return up ? Glyph::Flag32ndUp : Glyph::Flag32ndDown;
+        case Note::Type::_64th: return up ? Glyph::Flag64thUp : Glyph::Flag64thDown;
+        default: return up ? Glyph::Flag128thUp : Glyph::Flag128thDown;
+    }
+}
+
+Glyph accidentalGlyph(int alter) {
+    switch (alter) {
+        case -2: return Glyph::AccidentalDoubleFlat;
+        case -1: return Glyph::AccidentalFlat;
+        case 1: return Glyph::AccidentalSharp;
+        case 2: return Glyph::AccidentalDoubleSharp;
+        default: return Glyph::AccidentalNatural;
+    }
+}
+
+Glyph clefGlyph(const dom::Clef& clef) {
+    switch (clef.sign().value()) {
+        case dom::Clef::Sign::F: return Glyph::FClef;
+        case dom::Clef::Sign::C: return Glyph::CClef;
+        case dom::Clef::Sign::Percussion: return Glyph::PercussionClef;
+        default: return Glyph::GClef;
+    }
+}
+
+/// Articulations go on the side of the note opposite to the stem
+Glyph articulationGlyph(const dom::Articulation& articulation, dom::Stem stem) {
+    using Type = dom::Articulation::Type;
+    const bool above = stem != dom::Stem::Up;
+    switch (articulation.type()) {
+        case Type::Accent: return above ? Glyph::ArticAccentAbove : Glyph::ArticAccentBelow;
+        case Type::Staccato: return above ? Glyph::ArticStaccatoAbove : Glyph::ArticStaccatoBelow;
+        case Type::Staccatissimo: return above ? Glyph::ArticStaccatissimoAbove : Glyph::ArticStaccatissimoBelow;
+        case Type::Spiccato: return above ? Glyph::ArticStaccatissimoWedgeAbove : Glyph::ArticStaccatissimoWedgeBelow;
+        case Type::Tenuto: return above ? Glyph::ArticTenutoAbove : Glyph::ArticTenutoBelow;
+        case Type::DetachedLegato: return above ? Glyph::ArticTenutoStaccatoAbove : Glyph::ArticTenutoStaccatoBelow;
+        case Type::StrongAccent: return above ? Glyph::ArticMarcatoAbove : Glyph::ArticMarcatoBelow;
+        case Type::Stress: return above ? Glyph::ArticStressAbove : Glyph::ArticStressBelow;
+        case Type::Unstress: return above ? Glyph::ArticUnstressAbove : Glyph::ArticUnstressBelow;
+        case Type::BreathMark: return Glyph::BreathMarkComma;
+        case Type::Caesura: return Glyph::Caesura;
+        default: return Glyph::None;
+    }
+}
+
+Glyph ornamentGlyph(const dom::Ornaments& ornaments) {
+    if (ornaments.trillMark())
+        return Glyph::OrnamentTrill;
+    if (ornaments.mordent())
+        return Glyph::OrnamentMordent;
+    if (ornaments.invertedMordent())
+        return Glyph::OrnamentShortTrill;
+    if (ornaments.turn())
+        return Glyph::OrnamentTurn;
+    if (ornaments.invertedTurn())
+        return Glyph::OrnamentTurnInverted;
+    return Glyph::None;
+}
+
+std::string endingText(const dom::Ending& ending) {
+    std::string text;
+    for (auto number : ending.numbers()) {
+        if (!text.empty())
+            text += ", ";
+        text += std::to_string(number);
+    }
+    if (!text.empty())
+        text += ".";
+    return text;
+}
+
+std::string octaveShiftText(const dom::OctaveShift& octaveShift, bool continuation) {
+    std::string text = std::to_string(octaveShift.size);
+    if (octaveShift.size == 15)
+        text += octaveShift.type == dom::OctaveShift::Type::Up ? "mb" : "ma";
+    else
+        text += octaveShift.type == dom::OctaveShift::Type::Up ? "vb" : "va";
+    if (continuation)
+        return "(" + text + ")";
+    return text;
+}
+
+} // namespace
+
+DisplayList DisplayListFactory::build(const ScrollScoreGeometry& geometry) {
+    buildRoot(geometry);
+
+    return std::move(_list);
+}
+
+DisplayList DisplayListFactory::build(const PageScoreGeometry& geometry) {
+    buildRoot(geometry);
+
+    return std::move(_list);
+}
+
+void DisplayListFactory::buildRoot(const Geometry& geometry) {
+    _list.clear();
+
+    // Root coordinates are the root geometry's own coordinates
+    Context context{Point{}, 0, 0, nullptr, 1};
+    for (auto& child : geometry.geometries())
+        buildGeometry(*child, context);
+
+    finish();
+}
+
+void DisplayListFactory::buildGeometry(const Geometry& geometry, const Context& context) {
+    const std::type_info& type = typeid(geometry);
+    if (type == typeid(PartGeometry)) {
+        buildPart(static_cast<const PartGeometry&>(geometry), context);
+        return;
+    }
+
+    if (buildCommands(geometry, context))
+        return;
+
+    Context childContext = context;
+    childContext.translation = childTranslation(geometry, context.translation);
+    if (type == typeid(MeasureGeometry)) {
+        childContext.metrics = &static_cast<const MeasureGeometry&>(geometry).metrics();
+    } else if (type == typeid(ChordGeometry)) {
+        if (static_cast<const ChordGeometry&>(geometry).chord().firstNote()->grace())
+            childContext.scale = MeasureGeometry::kGraceNoteScale;
+    }
+
+    for (auto& child : geometry.geometries())
+        buildGeometry(*child, childContext);
+}
+
+void DisplayListFactory::buildPart(const PartGeometry& geometry, const Context& context) {
+    auto& measureGeometries = geometry.measureGeometries();
+    if (measureGeometries.empty())
+        return;
+
+    // Measures are laid out left to right, so part-level geometries can be assigned to a measure by position
+    std::vector<coord_t> measureStarts;
+    measureStarts.reserve(measureGeometries.size());
+    for (auto measureGeometry : measureGeometries)
+        measureStarts.push_back(measureGeometry->frame().origin.x);
+
+    Context childContext = context;
+    childContext.translation = childTranslation(geometry, context.translation);
+    childContext.partIndex = static_cast<std::uint32_t>(geometry.part().index());
+    childContext.metrics = &measureGeometries.front()->metrics();
+
+    for (auto& child : geometry.geometries()) {
+        if (typeid(*child) == typeid(MeasureGeometry)) {
+            auto& measureGeometry = static_cast<const MeasureGeometry&>(*child);
+            childContext.measureIndex = static_cast<std::uint32_t>(measureGeometry.measure().index());
+            childContext.metrics = &measureGeometry.metrics();
+        } else {
+            auto it = std::upper_bound(measureStarts.begin(), measureStarts.end(), child->frame().origin.x);
+            if (it != measureStarts.begin())
+                it -= 1;
+            auto measureGeometry = measureGeometries[it - measureStarts.begin()];
+            childContext.measureIndex = static_cast<std::uint32_t>(measureGeometry->measure().index());
+            childContext.metrics = &measureGeometry->metrics();
+        }
+        buildGeometry(*child, childContext);
+    }
+}
+
+bool DisplayListFactory::buildCommands(const Geometry& geometry, const Context& context) {
+    const std::type_info& type = typeid(geometry);
+    const Rect frame = translate(geometry.frame(), context.translation);
+
+    if (type == typeid(MeasureGeometry)) {
+        auto& measureGeometry = static_cast<const MeasureGeometry&>(geometry);
+        auto& metrics = measureGeometry.metrics();
+        const Point translation = childTranslation(geometry, context.translation);
+        const coord_t width = geometry.size().width;
+        for (std::size_t staff = 1; staff <= metrics.staves(); staff += 1) {
+            for (std::size_t line = 0; line < Metrics::kStaffLineCount; line += 1) {
+                const coord_t y = metrics.staffOrigin(static_cast<int>(staff)) + line * Metrics::kStaffLineSpacing;
+                addLine(geometry, context, translate({0, y}, translation), translate({width, y}, translation), kStaffLineWidth);
+            }
+        }
+        return false;
+    }
+
+    if (type == typeid(NoteGeometry)) {
+        auto& note = static_cast<const NoteGeometry&>(geometry).note();
+        addGlyph(geometry, context, noteheadGlyph(note));
+
+        if (context.metrics && note.pitch) {
+            const coord_t staffY = context.metrics->staffY(note);
+            const coord_t centerY = frame.center().y;
+            const coord_t minX = frame.min().x - kLedgerLineExtension;
+            const coord_t maxX = frame.max().x + kLedgerLineExtension;
+            for (coord_t y = -Metrics::kStaffLineSpacing; y >= staffY; y -= Metrics::kStaffLineSpacing)
+                addLine(geometry, context, {minX, centerY + y - staffY}, {maxX, centerY + y - staffY}, kLedgerLineWidth);
+            for (coord_t y = Metrics::staffHeight() + Metrics::kStaffLineSpacing; y <= staffY; y += Metrics::kStaffLineSpacing)
+                addLine(geometry, context, {minX, centerY + y - staffY}, {maxX, centerY + y - staffY}, kLedgerLineWidth);
+        }
+        return true;
+    }
+
+    if (type == typeid(RestGeometry)) {
+        addGlyph(geometry, context, restGlyph(static_cast<const RestGeometry&>(geometry).note()));
+        return true;
+    }
+
+    if (type == typeid(StemGeometry)) {
+        auto& stem = static_cast<const StemGeometry&>(geometry);
+        Point base;
+        Point tip;
+        if (stem.stemDirection() == dom::Stem::Up) {
+            base.x = tip.x = frame.min().x + NoteGeometry::kQuarterWidth - BeamGeometry::kStemLineWidth/2;
+            base.y = frame.max().y - NoteGeometry::kHeight/2;
+            tip.y = frame.min().y;
+        } else {
+            base.x = tip.x = frame.min().x + BeamGeometry::kStemLineWidth/2;
+            base.y = frame.min().y + NoteGeometry::kHeight/2;
+            tip.y = frame.max().y;
+        }
+        addLine(geometry, context, base, tip, BeamGeometry::kStemLineWidth);
+
+        if (stem.showFlags() && stem.note().type() <= Note::Type::Eighth)
+            addGlyph(geometry, context, flagGlyph(stem.note(), stem.stemDirection()), frame, tip);
+        return true;
+    }
+
+    if (type == typeid(BeamGeometry)) {
+        auto& beam = static_cast<const BeamGeometry&>(geometry);
+        auto& chords = beam.chords();
+        if (chords.size() <= 1)
+            return true;
+
+        const Point translation = childTranslation(geometry, context.translation);
+        const coord_t direction = beam.placement() == dom::Placement::Below ? 1 : -1;
+        const coord_t levelOffset = direction * (BeamGeometry::kBeamLineWidth + BeamGeometry::kBeamLineSpacing);
+
+        // The first beam spans all chords, secondary beams only span consecutive chords that have them
+        addLine(geometry, context, translate(beam.beamBegin(), context.translation), translate(beam.beamEnd(), context.translation), BeamGeometry::kBeamLineWidth);
+        for (std::size_t i = 0; i + 1 < chords.size(); i += 1) {
+            const std::size_t levels = std::min(chords[i]->chord().firstNote()->beams().size(), chords[i + 1]->chord().firstNote()->beams().size());
+            if (levels <= 1 || !chords[i]->stem() || !chords[i + 1]->stem())
+                continue;
+
+            const Point start = translate(beam.stemTip(chords[i]), translation);
+            const Point end = translate(beam.stemTip(chords[i + 1]), translation);
+            for (std::size_t level = 1; level < levels; level += 1) {
+                const coord_t dy = level * levelOffset;
+                addLine(geometry, context, {start.x, start.y + dy}, {end.x, end.y + dy}, BeamGeometry::kBeamLineWidth);
+            }
+        }
+        return true;
+    }
+
+    if (type == typeid(AccidentalGeometry)) {
+        addGlyph(geometry, context, accidentalGlyph(static_cast<const AccidentalGeometry&>(geometry).alter()));
+        return true;
+    }
+
+    if (type == typeid(DotGeometry)) {
+        addGlyph(geometry, context, Glyph::AugmentationDot);
+        return true;
+    }
+
+    if (type == typeid(ArticulationGeometry)) {
+        auto& articulation = static_cast<const ArticulationGeometry&>(geometry);
+        const Glyph glyph = articulationGlyph(articulation.articulation(), articulation.stem());
+        if (glyph != Glyph::None)
+            addGlyph(geometry, context, glyph);
+        return true;
+    }
+
+    if (type == typeid(FermataGeometry)) {
+        auto& fermata = static_cast<const FermataGeometry&>(geometry).fermata();
+        addGlyph(geometry, context, fermata.type() == dom::Fermata::Type::Upright ? Glyph::FermataAbove : Glyph::FermataBelow);
+        return true;
+    }
+
+    if (type == typeid(ClefGeometry)) {
+        addGlyph(geometry, context, clefGlyph(static_cast<const ClefGeometry&>(geometry).clef()));
+        return true;
+    }
+
+    if (type == typeid(KeyGeometry)) {
+        auto& key = static_cast<const KeyGeometry&>(geometry);
+        const int fifths = key.key().fifths();
+        const int count = std::abs(fifths);
+        const Glyph glyph = key.natural() ? Glyph::AccidentalNatural : fifths > 0 ? Glyph::AccidentalSharp : Glyph::AccidentalFlat;
+        const Size size = AccidentalGeometry::Size(key.natural() ? 0 : fifths > 0 ? 1 : -1);
+        const coord_t advance = (fifths > 0 ? AccidentalGeometry::kSharpSize.width : AccidentalGeometry::kFlatSize.width) + KeyGeometry::kSpacing;
+
+        // The key geometry is centered on the staff and keyStaffY is relative to the top staff line
+        const coord_t staffTop = frame.center().y - Metrics::staffHeight()/2;
+        for (int i = 0; i < count; i += 1) {
+            const int fifth = fifths > 0 ? i + 1 : -(i + 1);
+            const Point anchor{frame.min().x + i * advance + size.width/2, staffTop + KeyGeometry::keyStaffY(fifth, key.clef())};
+            const Rect accidentalFrame({anchor.x - size.width/2, anchor.y - size.height/2}, size);
+            addGlyph(geometry, context, glyph, accidentalFrame, anchor);
+        }
+        return true;
+    }
+
+    if (type == typeid(TimeSignatureGeometry)) {
+        auto& time = static_cast<const TimeSignatureGeometry&>(geometry).time();
+        if (time.symbol() == dom::Time::Symbol::Common) {
+            addGlyph(geometry, context, Glyph::TimeSigCommon);
+        } else if (time.symbol() == dom::Time::Symbol::Cut) {
+            addGlyph(geometry, context, Glyph::TimeSigCutCommon);
+        } else if (time.symbol() == dom::Time::Symbol::SingleNumber) {
+            addText(geometry, context, DisplayCommand::Font::Music, std::to_string(time.beats()), frame);
+        } else {
+            const Size half(frame.size.width, frame.size.height/2);
+            addText(geometry, context, DisplayCommand::Font::Music, std::to_string(time.beats()), Rect(frame.origin, half));
+            addText(geometry, context, DisplayCommand::Font::Music, std::to_string(time.beatType()), Rect({frame.min().x, frame.center().y}, half));
+        }
+        return true;
+    }
+
+    if (type == typeid(BarlineGeometry)) {
+        auto& barlineGeometry = static_cast<const BarlineGeometry&>(geometry);
+        auto& barline = barlineGeometry.barline();
+        if (barline.style() == dom::Barline::Style::None)
+            return true;
+
+        const coord_t light = BarlineGeometry::kLightLineWidth;
+        const coord_t heavy = BarlineGeometry::kHeavyLineWidth;
+        std::vector<coord_t> lineWidths;
+        bool dotsFirst = false;
+        if (barline.repeat()) {
+            dotsFirst = barline.repeat()->direction() == dom::Repeat::Direction::Backward;
+            if (dotsFirst)
+                lineWidths = {light, heavy};
+            else
+                lineWidths = {heavy, light};
+        } else {
+            switch (barline.style()) {
+                case dom::Barline::Style::Heavy: lineWidths = {heavy}; break;
+                case dom::Barline::Style::LightLight: lineWidths = {light, light}; break;
+                case dom::Barline::Style::LightHeavy: lineWidths = {light, heavy}; break;
+                case dom::Barline::Style::HeavyLight: lineWidths = {heavy, light}; break;
+                case dom::Barline::Style::HeavyHeavy: lineWidths = {heavy, heavy}; break;
+                default: lineWidths = {light}; break;
+            }
+        }
+
+        coord_t x = frame.min().x;
+        auto addDots = [&]() {
+            const Size dotSize(BarlineGeometry::kDotDiameter, BarlineGeometry::kDotDiameter);
+            const coord_t dotX = x + BarlineGeometry::kDotDiameter/2;
+            for (std::size_t staff = 1; staff <= barlineGeometry.metrics().staves(); staff += 1) {
+                const coord_t staffTop = context.translation.y + barlineGeometry.metrics().staffOrigin(static_cast<int>(staff));
+                for (auto dy : {1.5f * Metrics::kStaffLineSpacing, 2.5f * Metrics::kStaffLineSpacing}) {
+                    const Point anchor{dotX, staffTop + dy};
+                    addGlyph(geometry, context, Glyph::RepeatDot, Rect({anchor.x - dotSize.width/2, anchor.y - dotSize.height/2}, dotSize), anchor);
+                }
+            }
+            x += BarlineGeometry::kDotDiameter + BarlineGeometry::kLineSpacing;
+        };
+
+        // The barline's frame is offset by half a line width, the lines themselves span the staves exactly
+        const coord_t top = context.translation.y;
+        const coord_t bottom = top + frame.size.height;
+        if (barline.repeat() && dotsFirst)
+            addDots();
+        for (auto lineWidth : lineWidths) {
+            addLine(geometry, context, {x + lineWidth/2, top}, {x + lineWidth/2, bottom}, lineWidth);
+            x += lineWidth + BarlineGeometry::kLineSpacing;
+        }
+        if (barline.repeat() && !dotsFirst)
+            addDots();
+        return true;
+    }
+
+    if (type == typeid(TupletGeometry)) {
+        auto& tuplet = static_cast<const TupletGeometry&>(geometry);
+        const bool below = tuplet.placement() == dom::Placement::Below;
+        const coord_t lineY = below ? frame.max().y : frame.min().y;
+        const coord_t hookY = below ? frame.min().y : frame.max().y;
+        if (tuplet.bracket()) {
+            addLine(geometry, context, {frame.min().x, hookY}, {frame.min().x, lineY}, SpanDirectionGeometry::kLineWidth);
+            addLine(geometry, context, {frame.min().x, lineY}, {frame.max().x, lineY}, SpanDirectionGeometry::kLineWidth);
+            addLine(geometry, context, {frame.max().x, lineY}, {frame.max().x, hookY}, SpanDirectionGeometry::kLineWidth);
+        }
+        if (tuplet.displayNumber() > 0)
+            addText(geometry, context, DisplayCommand::Font::Music, std::to_string(tuplet.displayNumber()), frame);
+        return true;
+    }
+
+    if (type == typeid(TieGeometry)) {
+        auto& tie = static_cast<const TieGeometry&>(geometry);
+
+        // Collision resolution moves the tie's location without updating its end points
+        const Point location = tie.location();
+        const Point start = translate(location, context.translation);
+        const Point stop = translate({tie.stopLocation().x + location.x - tie.startLocation().x, tie.stopLocation().y + location.y - tie.startLocation().y}, context.translation);
+
+        const coord_t dx = stop.x - start.x;
+        const coord_t dy = stop.y - start.y;
+        const coord_t length = std::sqrt(dx*dx + dy*dy);
+        if (length == 0)
+            return true;
+
+        // A cubic curve with both control points offset by 4/3 h peaks at h
+        const coord_t height = std::min(TieGeometry::kMaxHeight, std::sqrt(length + TieGeometry::kEndPointLineWidth));
+        const coord_t side = tie.placement().value() == dom::Placement::Above ? -1 : 1;
+        const coord_t nx = -dy / length * side * height * 4 / 3;
+        const coord_t ny = dx / length * side * height * 4 / 3;
+        const Point points[4] = {
+            start,
+            {start.x + dx/4 + nx, start.y + dy/4 + ny},
+            {start.x + 3*dx/4 + nx, start.y + 3*dy/4 + ny},
+            stop
+        };
+        addCurve(geometry, context, points, TieGeometry::kEndPointLineWidth);
+        return true;
+    }
+
+    if (type == typeid(WordsGeometry)) {
+        auto& words = static_cast<const WordsGeometry&>(geometry);
+        if (auto contents = words.contents())
+            addText(geometry, context, words.dynamics() ? DisplayCommand::Font::Dynamics : DisplayCommand::Font::Words, *contents, frame);
+        return true;
+    }
+
+    if (type == typeid(LyricGeometry)) {
+        addText(geometry, context, DisplayCommand::Font::Lyrics, static_cast<const LyricGeometry&>(geometry).lyric().text(), frame);
+        return true;
+    }
+
+    if (type == typeid(LyricConnectorGeometry)) {
+        addLine(geometry, context, {frame.min().x, frame.center().y}, {frame.max().x, frame.center().y}, LyricConnectorGeometry::kLineWidth);
+        return true;
+    }
+
+    if (type == typeid(OrnamentsGeometry)) {
+        const Glyph glyph = ornamentGlyph(static_cast<const OrnamentsGeometry&>(geometry).ornaments());
+        if (glyph != Glyph::None)
+            addGlyph(geometry, context, glyph);
+        return true;
+    }
+
+    if (type == typeid(SegnoGeometry)) {
+        addGlyph(geometry, context, Glyph::Segno);
+        return true;
+    }
+
+    if (type == typeid(CodaGeometry)) {
+        addGlyph(geometry, context, Glyph::Coda);
+        return true;
+    }
+
+    if (type == typeid(EndingGeometry)) {
+        auto& ending = static_cast<const EndingGeometry&>(geometry);
+        addLine(geometry, context, {frame.min().x, frame.max().y}, {frame.min().x, frame.min().y}, SpanDirectionGeometry::kLineWidth);
+        addLine(geometry, context, {frame.min().x, frame.min().y}, {frame.max().x, frame.min().y}, SpanDirectionGeometry::kLineWidth);
+        if (ending.stopEnding().type() == dom::Ending::Type::Stop)
+            addLine(geometry, context, {frame.max().x, frame.min().y}, {frame.max().x, frame.max().y}, SpanDirectionGeometry::kLineWidth);
+
+        const std::string text = endingText(ending.startEnding());
+        if (!text.empty())
+            addText(geometry, context, DisplayCommand::Font::Words, text, Rect(frame.origin, Size(EndingGeometry::kMinWidth, frame.size.height)));
+        return true;
+    }
+
+    if (type == typeid(PedalGeometry)) {
+        auto& pedal = static_cast<const PedalGeometry&>(geometry);
+        auto pedalType = dom::nodeCast<dom::Pedal>(pedal.type());
+        if (!pedalType)
+            return true;
+
+        if (pedalType->line()) {
+            const coord_t y = frame.max().y;
+            if (pedal.startDirection() && !pedal.isContinuation())
+                addLine(geometry, context, {frame.min().x, frame.min().y}, {frame.min().x, y}, SpanDirectionGeometry::kLineWidth);
+            addLine(geometry, context, {frame.min().x, y}, {frame.max().x, y}, SpanDirectionGeometry::kLineWidth);
+            if (pedal.stopDirection())
+                addLine(geometry, context, {frame.max().x, y}, {frame.max().x, frame.min().y}, SpanDirectionGeometry::kLineWidth);
+        } else {
+            if (pedal.startDirection() && !pedal.isContinuation()) {
+                const Rect pedFrame(frame.origin, PedalGeometry::kPedSize);
+                addGlyph(geometry, context, Glyph::KeyboardPedalPed, pedFrame, pedFrame.center());
+            }
+            if (pedal.stopDirection()) {
+                const Rect starFrame({frame.max().x - PedalGeometry::kStarSize.width, frame.min().y}, PedalGeometry::kStarSize);
+                addGlyph(geometry, context, Glyph::KeyboardPedalUp, starFrame, starFrame.center());
+            }
+        }
+        return true;
+    }
+
+    if (type == typeid(OctaveShiftGeometry)) {
+        auto& octave = static_cast<const OctaveShiftGeometry&>(geometry);
+        auto octaveShift = dom::nodeCast<dom::OctaveShift>(octave.type());
+        if (!octaveShift)
+            return true;
+
+        const Rect textFrame(frame.origin, OctaveShiftGeometry::k8vaSize);
+        addText(geometry, context, DisplayCommand::Font::Words, octaveShiftText(*octaveShift, octave.isContinuation()), textFrame);
+
+        const coord_t y = octave.placement() == dom::Placement::Below ? frame.max().y : frame.min().y;
+        addLine(geometry, context, {textFrame.max().x, y}, {frame.max().x, y}, SpanDirectionGeometry::kLineWidth);
+        if (octave.stopDirection())
+            addLine(geometry, context, {frame.max().x, y}, {frame.max().x, frame.center().y}, SpanDirectionGeometry::kLineWidth);
+        return true;
+    }
+
+    if (type == typeid(BracketGeometry)) {
+        auto& bracket = static_cast<const BracketGeometry&>(geometry);
+        const bool below = bracket.placement() == dom::Placement::Below;
+        const coord_t lineY = below ? frame.max().y : frame.min().y;
+        const coord_t hookY = frame.center().y;
+        if (bracket.startDirection() && !bracket.isContinuation())
+            addLine(geometry, context, {frame.min().x, hookY}, {frame.min().x, lineY}, SpanDirectionGeometry::kLineWidth);
+        addLine(geometry, context, {frame.min().x, lineY}, {frame.max().x, lineY}, SpanDirectionGeometry::kLineWidth);
+        if (bracket.stopDirection())
+            addLine(geometry, context, {frame.max().x, lineY}, {frame.max().x, hookY}, SpanDirectionGeometry::kLineWidth);
+        return true;
+    }
+
+    if (type == typeid(SpanDirectionGeometry)) {
+        auto& span = static_cast<const SpanDirectionGeometry&>(geometry);
+        auto wedge = dom::nodeCast<dom::Wedge>(span.type());
+        if (!wedge)
+            return true;
+
+        const coord_t lineWidth = SpanDirectionGeometry::kLineWidth;
+        const Point closed{wedge->type() == dom::Wedge::Type::Diminuendo ? frame.max().x : frame.min().x, frame.center().y};
+        const coord_t openX = wedge->type() == dom::Wedge::Type::Diminuendo ? frame.min().x : frame.max().x;
+        addLine(geometry, context, closed, {openX, frame.min().y + lineWidth}, lineWidth);
+        addLine(geometry, context, closed, {openX, frame.max().y - lineWidth}, lineWidth);
+        return true;
+    }
+
+    return false;
+}
+
+void DisplayListFactory::finish() {
+    auto& commands = _list._commands;
+    std::stable_sort(commands.begin(), commands.end(), [](const DisplayCommand& lhs, const DisplayCommand& rhs) {
+        return lhs.measureIndex < rhs.measureIndex;
+    });
+
+    auto& chunks = _list._chunks;
+    for (std::size_t i = 0; i < commands.size(); i += 1) {
+        auto& command = commands[i];
+        if (chunks.empty() || chunks.back().measureIndex != command.measureIndex) {
+            chunks.push_back(DisplayList::Chunk{command.measureIndex, i, i + 1, command.frame});
+        } else {
+            chunks.back().end = i + 1;
+            chunks.back().bounds = join(chunks.back().bounds, command.frame);
+        }
+    }
+}
+
+void DisplayListFactory::addGlyph(const Geometry& geometry, const Context& context, Glyph glyph) {
+    addGlyph(geometry, context, glyph, translate(geometry.frame(), context.translation), translate(geometry.location(), context.translation));
+}
+
+void DisplayListFactory::addGlyph(const Geometry& geometry, const Context& context, Glyph glyph, const Rect& frame, const Point& anchor) {
+    auto& command = addCommand(geometry, context, DisplayCommand::Type::Glyph);
+    command.glyph = glyph;
+    command.frame = frame;
+    command.points[0] = anchor;
+}
+
+void DisplayListFactory::addLine(const Geometry& geometry, const Context& context, const Point& start, const Point& end, coord_t lineWidth) {
+    auto& command = addCommand(geometry, context, DisplayCommand::Type::Line);
+    command.lineWidth = lineWidth;
+    command.points[0] = start;
+    command.points[1] = end;
+
+    command.frame = Rect(start, end);
+    command.frame.origin.x -= lineWidth/2;
+    command.frame.origin.y -= lineWidth/2;
+    command.frame.size.width += lineWidth;
+    command.frame.size.height += lineWidth;
+}
+
+void DisplayListFactory::addCurve(const Geometry& geometry, const Context& context, const Point (&points)[4], coord_t lineWidth) {
+    auto& command = addCommand(geometry, context, DisplayCommand::Type::Curve);
+    command.lineWidth = lineWidth;
+
+    // The control polygon contains the curve
+    command.frame = Rect(points[0], points[0]);
+    for (int i = 0; i < 4; i += 1) {
+        command.points[i] = points[i];
+        command.frame = join(command.frame, Rect(points[i], points[i]));
+    }
+}
+
+void DisplayListFactory::addText(const Geometry& geometry, const Context& context, DisplayCommand::Font font, const std::string& text, const Rect& frame) {
+    auto& command = addCommand(geometry, context, DisplayCommand::Type::Text);
+    command.font = font;
+    command.textIndex = static_cast<std::uint32_t>(_list._texts.size());
+    command.frame = frame;
+    command.points[0] = frame.center();
+    _list._texts.push_back(text);
+}
+
+DisplayCommand& DisplayListFactory::addCommand(const Geometry& geometry, const Context& context, DisplayCommand::Type type) {
+    DisplayCommand command;
+    command.type = type;
+    command.font = DisplayCommand::Font::Music;
+    command.glyph = Glyph::None;
+    command.active = geometry.isActive();
+    command.partIndex = context.partIndex;
+    command.measureIndex = context.measureIndex;
+    command.textIndex = 0;
+    command.scale = context.scale;
+    command.lineWidth = 0;
+    _list._commands.push_back(command);
+    return _list._commands.back();
+}
+
+} // namespace mxml
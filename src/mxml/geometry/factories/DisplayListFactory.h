@@ -0,0 +1,66 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "DisplayList.h"
+#include "Geometry.h"
+
+#include <cstdint>
+#include <string>
+
+
+namespace mxml {
+
+class Metrics;
+class PageScoreGeometry;
+class PartGeometry;
+class ScrollScoreGeometry;
+
+/**
+ Compiles a score geometry tree into a `DisplayList`. The tree is walked once, accumulating the translation of each
+ geometry into root coordinates, and every drawable geometry is lowered to glyph, line, curve or text commands.
+ Geometries that belong to a part rather than a measure, like ties and directions, are assigned to the measure that
+ contains their left edge.
+ */
+class DisplayListFactory {
+public:
+    static const coord_t kStaffLineWidth;
+    static const coord_t kLedgerLineWidth;
+    static const coord_t kLedgerLineExtension;
+
+public:
+    DisplayList build(const ScrollScoreGeometry& geometry);
+    DisplayList build(const PageScoreGeometry& geometry);
+
+private:
+    struct Context {
+        /// Translation from the parent geometry's coordinates to root coordinates
+        Point translation;
+
+        std::uint32_t partIndex;
+        std::uint32_t measureIndex;
+        const Metrics* metrics;
+        coord_t scale;
+    };
+
+    void buildRoot(const Geometry& geometry);
+    void buildGeometry(const Geometry& geometry, const Context& context);
+    void buildPart(const PartGeometry& geometry, const Context& context);
+    bool buildCommands(const Geometry& geometry, const Context& context);
+    void finish();
+
+    void addGlyph(const Geometry& geometry, const Context& context, Glyph glyph);
+    void addGlyph(const Geometry& geometry, const Context& context, Glyph glyph, const Rect& frame, const Point& anchor);
+    void addLine(const Geometry& geometry, const Context& context, const Point& start, const Point& end, coord_t lineWidth);
+    void addCurve(const Geometry& geometry, const Context& context, const Point (&points)[4], coord_t lineWidth);
+    void addText(const Geometry& geometry, const Context& context, DisplayCommand::Font font, const std::string& text, const Rect& frame);
+    DisplayCommand& addCommand(const Geometry& geometry, const Context& context, DisplayCommand::Type type);
+
+private:
+    DisplayList _list;
+};
+
+} // namespace mxml
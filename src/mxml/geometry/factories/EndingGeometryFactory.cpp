@@ -13,11 +13,13 @@ namespace mxml {
 
 EndingGeometryFactory::EndingGeometryFactory(const std::vector<MeasureGeometry*>& measureGeometries, const Metrics& metrics)
 : _measureGeometries(measureGeometries),
-  _metrics(metrics)
+  _metrics(metrics),
+  _startEnding()
 {}
 
 std::vector<std::unique_ptr<EndingGeometry>> EndingGeometryFactory::build() {
     _geometries.clear();
+    _startEnding = nullptr;
 
     for (auto& measure: _measureGeometries) {
         for (auto& geom : measure->geometries()) {
@@ -36,18 +38,18 @@ void EndingGeometryFactory::buildEndings(const MeasureGeometry& measureGeom, con
 
     auto& ending = barline.ending();
 
-    if ((ending->type() == dom::Ending::Type::Stop || ending->type() == dom::Ending::Type::Discontinue) && _startEnding.isPresent()) {
+    if ((ending->type() == dom::Ending::Type::Stop || ending->type() == dom::Ending::Type::Discontinue) && _startEnding) {
         Point stopLocation;
         stopLocation.x = measureGeom.frame().max().x - 1;
         stopLocation.y = measureGeom.origin().y - measureGeom.contentOffset().y - EndingGeometry::kHeight - 10;
 
-        std::unique_ptr<EndingGeometry> endingGeom(new EndingGeometry(_startEnding, _startEndingLocation, *ending, stopLocation));
+        std::unique_ptr<EndingGeometry> endingGeom(new EndingGeometry(*_startEnding, _startEndingLocation, *ending, stopLocation));
         endingGeom->setLocation(_startEndingLocation);
         _geometries.push_back(std::move(endingGeom));
 
-        _startEnding.reset();
+        _startEnding = nullptr;
     } else if (ending->type() == dom::Ending::Type::Start) {
-        _startEnding.setPresentValue(*ending);
+        _startEnding = ending.get();
         _startEndingLocation = measureGeom.location();
         _startEndingLocation.y = measureGeom.origin().y - measureGeom.contentOffset().y - EndingGeometry::kHeight - 10;
     }
@@ -30,7 +30,7 @@ private:
 
     std::vector<std::unique_ptr<EndingGeometry>> _geometries;
 
-    dom::Optional<dom::Ending> _startEnding;
+    const dom::Ending* _startEnding;
     Point _startEndingLocation;
 };
 
@@ -11,8 +11,29 @@
 
 #include <mxml/Metrics.h>
 
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
 namespace mxml {
 
+const coord_t LyricGeometryFactory::kWordSpacing = 4;
+const coord_t LyricGeometryFactory::kHyphenSpacing = 2;
+
+namespace {
+
+bool continuesWord(const dom::Lyric& lyric) {
+    auto& syllabic = lyric.syllabic();
+    return syllabic && (syllabic->type() == dom::Syllabic::Type::Begin || syllabic->type() == dom::Syllabic::Type::Middle);
+}
+
+bool extends(const dom::Lyric& lyric) {
+    auto& extend = lyric.extend();
+    return extend && *extend != dom::kStop;
+}
+
+} // namespace
+
 LyricGeometryFactory::LyricGeometryFactory(const Geometry& parent, const std::vector<MeasureGeometry*>& measureGeometries, const Metrics& metrics)
 : _parent(parent),
   _measureGeometries(measureGeometries),
@@ -27,46 +48,81 @@ LyricGeometryFactory::LyricGeometryFactory(const Geometry& parent, const std::ve
     _chordsBounds = std::vector<Rect>(metrics.staves(), staffBound);
 }
 
-std::vector<std::unique_ptr<LyricGeometry>> LyricGeometryFactory::build() {
-    _lyricGeometries.clear();
-    computeNotesBounds();
-    
-    for (auto& measure: _measureGeometries) {
-        for (auto& geom : measure->geometries()) {
-            if (const ChordGeometry* chord = dynamic_cast<const ChordGeometry*>(geom.get()))
-                build(*measure, *chord);
+std::vector<std::unique_ptr<PlacementGeometry>> LyricGeometryFactory::build() {
+    _syllables.clear();
+    _syllableChords.clear();
+    _connectors.clear();
+    collectChords();
+
+    for (std::size_t chordIndex = 0; chordIndex < _chords.size(); chordIndex += 1)
+        build(chordIndex);
+
+    // Group the syllables by verse, left to right within a verse
+    std::vector<std::size_t> order(_syllables.size());
+    for (std::size_t i = 0; i < order.size(); i += 1)
+        order[i] = i;
+    auto verse = [this](std::size_t i) {
+        auto& lyric = _syllables[i]->lyric();
+        return std::make_tuple(_syllables[i]->staff(), lyric.placement(), lyric.number());
+    };
+    std::stable_sort(order.begin(), order.end(), [this, &verse](std::size_t a, std::size_t b) {
+        if (verse(a) != verse(b))
+            return verse(a) < verse(b);
+        return _syllables[a]->frame().origin.x < _syllables[b]->frame().origin.x;
+    });
+
+    std::size_t begin = 0;
+    for (std::size_t i = 1; i <= order.size(); i += 1) {
+        if (i == order.size() || verse(order[i]) != verse(order[begin])) {
+            layoutVerse(order, begin, i);
+            begin = i;
         }
     }
 
-    return std::move(_lyricGeometries);
+    std::vector<std::unique_ptr<PlacementGeometry>> geometries;
+    geometries.reserve(_syllables.size() + _connectors.size());
+    for (auto& syllable : _syllables)
+        geometries.push_back(std::move(syllable));
+    for (auto& connector : _connectors)
+        geometries.push_back(std::move(connector));
+    return geometries;
 }
 
-void LyricGeometryFactory::computeNotesBounds() {
+void LyricGeometryFactory::collectChords() {
+    _chordMeasures.clear();
+    _chords.clear();
+    _chordFrames.clear();
+
     // Get the bounding box of all notes on this part to place lyrics below that
     for (auto& measure: _measureGeometries) {
         for (auto& geom : measure->geometries()) {
-            auto chord = dynamic_cast<ChordGeometry*>(geom.get());
+            auto chord = dynamic_cast<const ChordGeometry*>(geom.get());
             if (!chord)
                 continue;
 
             auto staffIndex = chord->staff() - 1;
             _chordsBounds[staffIndex] = join(_chordsBounds[staffIndex], chord->frame());
+
+            _chordMeasures.push_back(measure);
+            _chords.push_back(chord);
+            _chordFrames.push_back(_parent.convertFromGeometry(chord->frame(), measure));
         }
     }
 }
 
-void LyricGeometryFactory::build(const MeasureGeometry& measureGeom, const ChordGeometry& chordGeom) {
-    for (auto& noteGeom : chordGeom.notes()) {
+void LyricGeometryFactory::build(std::size_t chordIndex) {
+    for (auto& noteGeom : _chords[chordIndex]->notes()) {
         for (auto& lyric : noteGeom->note().lyrics()) {
-            build(measureGeom, chordGeom, *lyric);
+            build(chordIndex, *lyric);
         }
     }
 }
 
-void LyricGeometryFactory::build(const MeasureGeometry& measureGeom, const ChordGeometry& chordGeom, const dom::Lyric& lyric) {
+void LyricGeometryFactory::build(std::size_t chordIndex, const dom::Lyric& lyric) {
+    const MeasureGeometry& measureGeom = *_chordMeasures[chordIndex];
+    const ChordGeometry& chordGeom = *_chords[chordIndex];
     const int staff = chordGeom.staff();
     std::unique_ptr<LyricGeometry> geometry(new LyricGeometry(lyric, staff));
-
     auto& spans = measureGeom.spans();
     auto measureIndex = measureGeom.measure().index();
     auto measureOrigin = spans.origin(measureIndex);
@@ -93,7 +149,85 @@ void LyricGeometryFactory::build(const MeasureGeometry& measureGeom, const Chord
 
     geometry->setLocation(location);
 
-    _lyricGeometries.push_back(std::move(geometry));
+    _syllables.push_back(std::move(geometry));
+    _syllableChords.push_back(chordIndex);
+}
+
+void LyricGeometryFactory::layoutVerse(const std::vector<std::size_t>& order, std::size_t begin, std::size_t end) {
+    LyricGeometry* previous = nullptr;
+    std::size_t previousIndex = 0;
+    for (std::size_t i = begin; i < end; i += 1) {
+        LyricGeometry& syllable = *_syllables[order[i]];
+
+        if (previous) {
+            // Keep clear of the previous syllable, with room for a hyphen if it is in the same word
+            const bool hyphen = continuesWord(previous->lyric());
+            coord_t minX = previous->frame().max().x;
+            if (hyphen)
+                minX += LyricConnectorGeometry::kHyphenWidth + 2 * kHyphenSpacing;
+            else
+                minX += kWordSpacing;
+
+            const coord_t dx = minX - syllable.frame().origin.x;
+            if (dx > 0)
+                syllable.setLocation({syllable.location().x + dx, syllable.location().y});
+
+            if (hyphen)
+                buildHyphen(*previous, syllable);
+            else if (extends(previous->lyric()))
+                buildExtender(previousIndex, syllable.frame().origin.x - kWordSpacing);
+        }
+
+        previous = &syllable;
+        previousIndex = order[i];
+    }
+
+    if (previous && !continuesWord(previous->lyric()) && extends(previous->lyric()))
+        buildExtender(previousIndex, std::numeric_limits<coord_t>::max());
+}
+
+void LyricGeometryFactory::buildHyphen(const LyricGeometry& previous, const LyricGeometry& next) {
+    std::unique_ptr<LyricConnectorGeometry> hyphen(new LyricConnectorGeometry(LyricConnectorGeometry::Type::Hyphen, previous));
+
+    Rect frame;
+    frame.size = hyphen->size();
+    frame.origin.x = (previous.frame().max().x + next.frame().min().x - frame.size.width) / 2;
+    frame.origin.y = previous.frame().center().y - frame.size.height / 2;
+    hyphen->setFrame(frame);
+
+    _connectors.push_back(std::move(hyphen));
+}
+
+void LyricGeometryFactory::buildExtender(std::size_t syllable, coord_t maxX) {
+    const LyricGeometry& lyricGeom = *_syllables[syllable];
+    const auto chordIndex = _syllableChords[syllable];
+    const ChordGeometry& chordGeom = *_chords[chordIndex];
+    auto& voice = chordGeom.chord().firstNote()->voice();
+
+    // The extender runs under the following chords in the same voice, up to the next syllable
+    coord_t endX = 0;
+    for (std::size_t i = chordIndex + 1; i < _chords.size(); i += 1) {
+        if (_chords[i]->staff() != chordGeom.staff() || _chords[i]->chord().firstNote()->voice() != voice)
+            continue;
+        if (_chordFrames[i].max().x > maxX)
+            break;
+        endX = _chordFrames[i].max().x;
+    }
+
+    const coord_t startX = lyricGeom.frame().max().x + kHyphenSpacing;
+    if (endX <= startX)
+        return;
+
+    std::unique_ptr<LyricConnectorGeometry> extender(new LyricConnectorGeometry(LyricConnectorGeometry::Type::Extender, lyricGeom));
+
+    Rect frame;
+    frame.origin.x = startX;
+    frame.origin.y = lyricGeom.frame().max().y - LyricConnectorGeometry::kLineWidth;
+    frame.size.width = endX - startX;
+    frame.size.height = LyricConnectorGeometry::kLineWidth;
+    extender->setFrame(frame);
+
+    _connectors.push_back(std::move(extender));
 }
 
 } // namespace mxml
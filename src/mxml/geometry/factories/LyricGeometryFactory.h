@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
+#include <mxml/geometry/LyricConnectorGeometry.h>
 #include <mxml/geometry/LyricGeometry.h>
 
 #include <memory>
@@ -16,23 +17,50 @@ namespace mxml {
 class ChordGeometry;
 class MeasureGeometry;
 
+/**
+ Builds the lyrics of a part. Each verse is laid out as a line: syllables are placed left to right under their notes
+ and moved right when they would overlap the previous syllable, leaving room for hyphens between the syllables of a
+ word. Hyphens and extenders are built along with the syllables.
+ */
 class LyricGeometryFactory {
+public:
+    static const coord_t kWordSpacing;
+    static const coord_t kHyphenSpacing;
+
 public:
     LyricGeometryFactory(const Geometry& parent, const std::vector<MeasureGeometry*>& measureGeometries, const Metrics& metrics);
-    std::vector<std::unique_ptr<LyricGeometry>> build();
+
+    /**
+     Build the syllables of all verses followed by their hyphens and extenders.
+     */
+    std::vector<std::unique_ptr<PlacementGeometry>> build();
 
 protected:
-    void computeNotesBounds();
-    void build(const MeasureGeometry& measureGeom, const ChordGeometry& chordGeom);
-    void build(const MeasureGeometry& measureGeom, const ChordGeometry& chordGeom, const dom::Lyric& lyric);
+    void collectChords();
+    void build(std::size_t chordIndex);
+    void build(std::size_t chordIndex, const dom::Lyric& lyric);
+
+    void layoutVerse(const std::vector<std::size_t>& order, std::size_t begin, std::size_t end);
+    void buildHyphen(const LyricGeometry& previous, const LyricGeometry& next);
+    void buildExtender(std::size_t syllable, coord_t maxX);
     
 private:
     const Geometry& _parent;
     const std::vector<MeasureGeometry*>& _measureGeometries;
     const Metrics& _metrics;
 
-    std::vector<std::unique_ptr<LyricGeometry>> _lyricGeometries;
     std::vector<Rect> _chordsBounds;
+
+    /// The chords of the part in score order, with their frames in the parent's coordinates
+    std::vector<const MeasureGeometry*> _chordMeasures;
+    std::vector<const ChordGeometry*> _chords;
+    std::vector<Rect> _chordFrames;
+
+    /// The syllables in score order and the index of their chord
+    std::vector<std::unique_ptr<LyricGeometry>> _syllables;
+    std::vector<std::size_t> _syllableChords;
+
+    std::vector<std::unique_ptr<LyricConnectorGeometry>> _connectors;
 };
 
 }
@@ -19,6 +19,7 @@
 #include <mxml/geometry/TimeSignatureGeometry.h>
 #include <mxml/geometry/TupletGeometry.h>
 
+#include "BeamSolver.h"
 #include "StemDirectionResolver.h"
 
 
@@ -49,11 +50,11 @@ std::unique_ptr<MeasureGeometry> MeasureGeometryFactory::build(const Measure& me
         _geometry->_showNumber = true;
 
     for (auto& node : measure.nodes()) {
-        if (const Attributes* attributes = dynamic_cast<const Attributes*>(node.get())) {
+        if (const Attributes* attributes = nodeCast<Attributes>(node.get())) {
             buildAttributes(attributes);
-        } else if (const Barline* barline = dynamic_cast<const Barline*>(node.get())) {
+        } else if (const Barline* barline = nodeCast<Barline>(node.get())) {
             buildBarline(barline);
-        } else if (const TimedNode* timedNode = dynamic_cast<const TimedNode*>(node.get())) {
+        } else if (const TimedNode* timedNode = nodeCast<TimedNode>(node.get())) {
             buildTimedNode(timedNode);
         }
     }
@@ -203,13 +204,13 @@ void MeasureGeometryFactory::buildBarline(const Barline* barline) {
 }
 
 void MeasureGeometryFactory::buildTimedNode(const TimedNode* node)  {
-    if (auto forward = dynamic_cast<const Forward*>(node)) {
-        _currentTime += forward->duration();
+    if (node->kind() == Node::Kind::Forward) {
+        _currentTime += node->duration();
         return;
     }
 
-    if (auto backup = dynamic_cast<const Backup*>(node)) {
-        _currentTime -= backup->duration();
+    if (node->kind() == Node::Kind::Backup) {
+        _currentTime -= node->duration();
         if (_currentTime < 0)
             _currentTime = 0;
         return;
@@ -219,9 +220,9 @@ void MeasureGeometryFactory::buildTimedNode(const TimedNode* node)  {
         _currentTime = node->start();
     }
 
-    if (auto chord = dynamic_cast<const Chord*>(node)) {
+    if (auto chord = nodeCast<Chord>(node)) {
         buildChord(chord);
-    } else if (auto note = dynamic_cast<const Note*>(node)) {
+    } else if (auto note = nodeCast<Note>(node)) {
         buildRest(note);
     }
 }
@@ -234,7 +235,7 @@ void MeasureGeometryFactory::buildChord(const Chord* chord) {
     placeChord(geo.get());
 
     for (auto& note : chord->notes()) {
-        auto& notations = note->notations;
+        auto notations = note->notations.get();
         if (!notations)
             continue;
 
@@ -291,7 +292,7 @@ void MeasureGeometryFactory::buildTuplet(const ChordGeometry* chordGeometry, con
 
     if (startTuplet->actual.number.isPresent())
         tupletGeometry->setDisplayNumber(startTuplet->actual.number);
-    else if (auto& timeModification = startChordGeometry->chord().firstNote()->timeModification)
+    else if (auto timeModification = startChordGeometry->chord().firstNote()->timeModification.get())
         tupletGeometry->setDisplayNumber(timeModification->actualNotes);
 
     if (startTuplet->bracket.isPresent())
@@ -367,6 +368,7 @@ void MeasureGeometryFactory::centerWholeRests() {
 
 void MeasureGeometryFactory::buildBeams() {
     std::map<std::string, std::vector<ChordGeometry*>> chordsByVoice;
+    std::vector<std::unique_ptr<BeamGeometry>> beams;
 
     for (std::size_t i = 0; i < _geometry->_geometries.size(); i += 1) {
         auto& geom = _geometry->_geometries[i];
@@ -381,18 +383,27 @@ void MeasureGeometryFactory::buildBeams() {
         auto& chords = chordsByVoice[note->voice()];
         chords.push_back(chordGeom);
         
-        const auto& beam = note->beams().front();
-        if (beam->type() == Beam::Type::Begin) {
-        } else if (beam->type() == Beam::Type::Continue) {
-        } else if (beam->type() == Beam::Type::End) {
-            std::unique_ptr<BeamGeometry> beamGeom(new BeamGeometry(chords));
-            ChordGeometry* firstChordGeom = chords.front();
-            beamGeom->setLocation(firstChordGeom->location());
+        const auto beam = note->beams().front();
+        if (beam.type() == Beam::Type::Begin) {
+        } else if (beam.type() == Beam::Type::Continue) {
+        } else if (beam.type() == Beam::Type::End) {
+            beams.emplace_back(new BeamGeometry(chords, false));
             chords.clear();
-            
-            _geometry->addGeometry(std::move(beamGeom));
         }
     }
+
+    // Lay out all the beams in the measure together
+    std::vector<BeamGeometry*> beamPointers;
+    for (auto& beamGeom : beams)
+        beamPointers.push_back(beamGeom.get());
+    BeamSolver solver;
+    solver.solve(beamPointers);
+
+    for (auto& beamGeom : beams) {
+        ChordGeometry* firstChordGeom = beamGeom->chords().front();
+        beamGeom->setLocation(firstChordGeom->location());
+        _geometry->addGeometry(std::move(beamGeom));
+    }
 }
 
 void MeasureGeometryFactory::adjustBounds(MeasureGeometry* geometry) {
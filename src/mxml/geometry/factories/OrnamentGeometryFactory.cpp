@@ -36,7 +36,7 @@ void OrnamentGeometryFactory::buildOrnaments(const MeasureGeometry& measureGeom,
         if (!note->notations)
             continue;
 
-        auto& notations = note->notations;
+        auto notations = note->notations.get();
         for (auto& ornament : notations->ornaments)
             buildOrnament(measureGeom, chordGeom, *ornament);
     }
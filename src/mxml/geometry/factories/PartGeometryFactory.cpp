@@ -11,7 +11,7 @@
 #include "PartGeometryFactory.h"
 #include "TieGeometryFactory.h"
 
-#include <mxml/geometry/collisions/CollisionHandler.h>
+#include <mxml/geometry/collisions/WindowedCollisionHandler.h>
 
 
 namespace mxml {
@@ -22,7 +22,9 @@ PartGeometryFactory::PartGeometryFactory(const dom::Part& part, const ScorePrope
   _metrics(metrics),
   _spans(spans),
   _partGeometry(),
-  _directionGeometryFactory(directionGeometryFactory)
+  _directionGeometryFactory(directionGeometryFactory),
+  _collisionWindowMeasures(WindowedCollisionHandler::kDefaultWindowMeasures),
+  _collisionThreads(1)
 {
 }
 
@@ -30,6 +32,11 @@ PartGeometryFactory::~PartGeometryFactory() {
     assert(!_partGeometry);
 }
 
+void PartGeometryFactory::setCollisionWindow(std::size_t measures, std::size_t threads) {
+    _collisionWindowMeasures = measures;
+    _collisionThreads = threads;
+}
+
 std::unique_ptr<PartGeometry> PartGeometryFactory::build() {
     return build(0, _scoreProperties.measureCount());
 }
@@ -87,14 +94,14 @@ std::unique_ptr<PartGeometry> PartGeometryFactory::build(std::size_t beginMeasur
     }
 
     TieGeometryFactory factory(*_partGeometry, _metrics);
-    auto ties = factory.buildTieGeometries(_partGeometry->geometries());
+    auto ties = factory.buildTieGeometries(_scoreProperties.tieIndex(), _part.index(), beginMeasure, endMeasure, _partGeometry->measureGeometries());
     for (auto& tie : ties) {
         _partGeometry->_tieGeometries.push_back(tie.get());
         _partGeometry->addGeometry(std::move(tie));
     }
     
-    CollisionHandler collisionHandler(*_partGeometry, _metrics);
-    collisionHandler.resolveCollisions();
+    WindowedCollisionHandler collisionHandler(*_partGeometry, _metrics, _collisionWindowMeasures);
+    collisionHandler.resolveCollisions(_collisionThreads);
 
     // Re-compute bounds after evertyhing is done
     for (auto measure : _partGeometry->measureGeometries())
@@ -31,12 +31,21 @@ public:
      */
     std::unique_ptr<PartGeometry> build(std::size_t beginMeasure, std::size_t endMeasure);
 
+    /**
+     Set how collisions are resolved: in windows of at least `measures` measures using up to `threads` threads. 0
+     measures resolves the whole part at once and 0 threads uses one thread per hardware thread. Parts are usually
+     built in parallel already, so windows are resolved on the calling thread by default.
+     */
+    void setCollisionWindow(std::size_t measures, std::size_t threads = 1);
+
 private:
     const dom::Part& _part;
     const ScoreProperties& _scoreProperties;
     const Metrics& _metrics;
     const SpanCollection& _spans;
     DirectionGeometryFactory& _directionGeometryFactory;
+    std::size_t _collisionWindowMeasures;
+    std::size_t _collisionThreads;
 
     std::unique_ptr<PartGeometry> _partGeometry;
 };
@@ -14,6 +14,9 @@
 
 #include <mxml/Metrics.h>
 
+#include <algorithm>
+#include <cassert>
+
 namespace mxml {
 
 TieGeometryFactory::TieGeometryFactory(const Geometry& parentGeometry, const Metrics& metrics)
@@ -22,115 +25,82 @@ TieGeometryFactory::TieGeometryFactory(const Geometry& parentGeometry, const Met
 {
 }
 
-std::vector<std::unique_ptr<TieGeometry>>&& TieGeometryFactory::buildTieGeometries(const std::vector<std::unique_ptr<Geometry>>& geometries) {
+std::vector<std::unique_ptr<TieGeometry>>&& TieGeometryFactory::buildTieGeometries(const TieIndex& index, std::size_t partIndex, std::size_t beginMeasure, std::size_t endMeasure, const std::vector<MeasureGeometry*>& measureGeometries) {
     _tieGeometries.clear();
-    _tieStartGeometries.clear();
-    _slurStartGeometries.clear();
-    createGeometries(geometries);
-
-    // Finish any ties that started but did not stop
-    for (auto& pair : _tieStartGeometries) {
-        auto tie = pair.second.first;
-        auto startGeom = pair.second.second;
-        auto tieGeom = buildTieGeometryToEdge(startGeom, tie->placement());
-        startGeom->setTieGeometry(tieGeom.get());
-        _tieGeometries.push_back(std::move(tieGeom));
-    }
+    _openEvents.clear();
 
-    // Finish any slurs that started but did not stop
-    for (auto& pair : _slurStartGeometries) {
-        auto slur = pair.second.first;
-        auto startGeom = pair.second.second;
-        auto slurGeom = buildSlurGeometryToEdge(startGeom, slur->placement());
-        startGeom->setTieGeometry(slurGeom.get());
-        _tieGeometries.push_back(std::move(slurGeom));
-    }
+    const auto range = index.range(partIndex, beginMeasure, endMeasure);
+    collectNoteGeometries(index, range.first, range.second, measureGeometries);
 
-    return std::move(_tieGeometries);
-}
+    for (std::size_t event = range.first; event != range.second; event += 1) {
+        if (index.stops()[event])
+            buildStop(index, range.first, event);
 
-void TieGeometryFactory::createGeometries(const std::vector<std::unique_ptr<Geometry>>& geometries) {
-    for (auto& geom : geometries) {
-        if (auto measure = dynamic_cast<MeasureGeometry*>(geom.get())) {
-            createGeometries(measure->geometries());
-        } else if (auto chordGeom = dynamic_cast<ChordGeometry*>(geom.get())) {
-            createGeometriesFromChord(chordGeom);
-        } else if (auto noteGeom = dynamic_cast<NoteGeometry*>(geom.get())) {
-            createGeometryFromNote(noteGeom);
-        }
+        const auto next = index.nexts()[event];
+        if (index.starts()[event] && (next == TieIndex::kNone || next >= range.second))
+            _openEvents.push_back(event);
     }
-}
 
-void TieGeometryFactory::createGeometriesFromChord(ChordGeometry* chord) {
-    for (auto& note : chord->notes()) {
-        createGeometryFromNote(note);
-    }
-}
+    // Finish any ties and then any slurs that started but did not stop
+    std::sort(_openEvents.begin(), _openEvents.end(), [&index](std::size_t a, std::size_t b) {
+        return std::make_pair(index.kinds()[a], index.keys()[a]) < std::make_pair(index.kinds()[b], index.keys()[b]);
+    });
+    for (auto event : _openEvents)
+        buildToEdge(index, range.first, event);
 
-void TieGeometryFactory::createGeometryFromNote(NoteGeometry* noteGeometry) {
-    const dom::Note& note = noteGeometry->note();
-    if (!note.notations)
-        return;
-    
-    const auto& notations = note.notations;
-
-    // Build ties
-    for (auto& tie : notations->ties) {
-        auto key = std::make_pair(note.staff(), note.pitch.get());
-        if (tie->type() == dom::kStart || tie->type() == dom::kContinue) {
-            _tieStartGeometries[key] = {tie.get(), noteGeometry};
-        } else if (tie->type() == dom::kContinue) {
-            buildTieGeometry(key, *noteGeometry, *tie);
-            _tieStartGeometries[key] = {tie.get(), noteGeometry};
-        } else if (tie->type() == dom::kStop) {
-            buildTieGeometry(key, *noteGeometry, *tie);
-        }
-    }
+    return std::move(_tieGeometries);
+}
 
-    // Build slurs
-    for (auto& slur : notations->slurs) {
-        auto key = std::make_pair(note.staff(), slur->number());
-        if (slur->type() == dom::kStart) {
-            _slurStartGeometries[key] = {slur.get(), noteGeometry};
-        } else if (slur->type() == dom::kContinue) {
-            buildSlurGeometry(key, *noteGeometry, *slur);
-            _slurStartGeometries[key] = {slur.get(), noteGeometry};
-        } else if (slur->type() == dom::kStop) {
-            buildSlurGeometry(key, *noteGeometry, *slur);
+void TieGeometryFactory::collectNoteGeometries(const TieIndex& index, std::size_t begin, std::size_t end, const std::vector<MeasureGeometry*>& measureGeometries) {
+    // Chord geometries are in score order, so a single pass matches them with the events
+    _noteGeometries.assign(end - begin, nullptr);
+    std::size_t event = begin;
+    for (auto measure : measureGeometries) {
+        for (auto& geom : measure->geometries()) {
+            auto chordGeom = dynamic_cast<ChordGeometry*>(geom.get());
+            if (!chordGeom)
+                continue;
+
+            for (auto noteGeom : chordGeom->notes()) {
+                while (event != end && index.notes()[event] == &noteGeom->note()) {
+                    _noteGeometries[event - begin] = noteGeom;
+                    event += 1;
+                }
+            }
         }
     }
+    assert(event == end);
 }
 
-void TieGeometryFactory::buildTieGeometry(const PitchKey& key, NoteGeometry& noteGeometry, const dom::Tied& tie) {
-    auto it = _tieStartGeometries.find(key);
-    auto startGeom = it->second.second;
+void TieGeometryFactory::buildStop(const TieIndex& index, std::size_t begin, std::size_t event) {
+    const auto partner = index.partners()[event];
+    const dom::Optional<dom::Placement> placement(index.placements()[event]);
+    const bool slur = index.kinds()[event] == TieIndex::Kind::Slur;
+    NoteGeometry* noteGeometry = _noteGeometries[event - begin];
 
     std::unique_ptr<TieGeometry> tieGeom;
-    if (it == _tieStartGeometries.end()) {
-        tieGeom = buildTieGeometryFromEdge(&noteGeometry, tie.placement());
+    if (partner == TieIndex::kNone || partner < begin) {
+        tieGeom = slur ? buildSlurGeometryFromEdge(noteGeometry, placement) : buildTieGeometryFromEdge(noteGeometry, placement);
     } else {
-        tieGeom = buildTieGeometry(startGeom, &noteGeometry, tie.placement());
+        auto startGeom = _noteGeometries[partner - begin];
+        tieGeom = slur ? buildSlurGeometry(startGeom, noteGeometry, placement) : buildTieGeometry(startGeom, noteGeometry, placement);
         startGeom->setTieGeometry(tieGeom.get());
-        _tieStartGeometries.erase(it);
     }
-    noteGeometry.setTieGeometry(tieGeom.get());
+    noteGeometry->setTieGeometry(tieGeom.get());
     _tieGeometries.push_back(std::move(tieGeom));
 }
 
-void TieGeometryFactory::buildSlurGeometry(const SlurKey& key, NoteGeometry& noteGeometry, const dom::Slur& slur) {
-    auto it = _slurStartGeometries.find(key);
-    auto startGeom = it->second.second;
+void TieGeometryFactory::buildToEdge(const TieIndex& index, std::size_t begin, std::size_t event) {
+    const dom::Optional<dom::Placement> placement(index.placements()[event]);
+    NoteGeometry* startGeom = _noteGeometries[event - begin];
 
-    std::unique_ptr<TieGeometry> slurGeom;
-    if (it == _slurStartGeometries.end()) {
-        slurGeom = buildSlurGeometryFromEdge(&noteGeometry, slur.placement());
-    } else {
-        slurGeom = buildSlurGeometry(startGeom, &noteGeometry, slur.placement());
-        startGeom->setTieGeometry(slurGeom.get());
-        _slurStartGeometries.erase(it);
-    }
-    noteGeometry.setTieGeometry(slurGeom.get());
-    _tieGeometries.push_back(std::move(slurGeom));
+    std::unique_ptr<TieGeometry> tieGeom;
+    if (index.kinds()[event] == TieIndex::Kind::Slur)
+        tieGeom = buildSlurGeometryToEdge(startGeom, placement);
+    else
+        tieGeom = buildTieGeometryToEdge(startGeom, placement);
+    startGeom->setTieGeometry(tieGeom.get());
+    _tieGeometries.push_back(std::move(tieGeom));
 }
 
 std::unique_ptr<TieGeometry> TieGeometryFactory::buildTieGeometry(const NoteGeometry* start, const NoteGeometry* stop, const dom::Optional<dom::Placement>& placement) {
@@ -8,9 +8,9 @@
 #include "Geometry.h"
 #include "TieGeometry.h"
 
+#include <mxml/TieIndex.h>
 #include <mxml/dom/Note.h>
 
-#include <map>
 #include <memory>
 #include <vector>
 
@@ -18,6 +18,7 @@
 namespace mxml {
 
 class ChordGeometry;
+class MeasureGeometry;
 class NoteGeometry;
 class Metrics;
 
@@ -29,22 +30,21 @@ public:
 public:
     explicit TieGeometryFactory(const Geometry& parentGeometry, const Metrics& metrics);
     
-    std::vector<std::unique_ptr<TieGeometry>>&& buildTieGeometries(const std::vector<std::unique_ptr<Geometry>>& geometries);
+    /**
+     Build the ties and slurs of a part in the measures `[beginMeasure, endMeasure)`, using the pairings in the score's
+     tie index. Ties and slurs that cross the range boundaries are drawn to or from the edge.
+     */
+    std::vector<std::unique_ptr<TieGeometry>>&& buildTieGeometries(const TieIndex& index, std::size_t partIndex, std::size_t beginMeasure, std::size_t endMeasure, const std::vector<MeasureGeometry*>& measureGeometries);
     
 private:
-    using SlurKey = std::pair<int, int>;
-    using PitchKey = std::pair<int, const dom::Pitch*>;
+    void collectNoteGeometries(const TieIndex& index, std::size_t begin, std::size_t end, const std::vector<MeasureGeometry*>& measureGeometries);
+    void buildStop(const TieIndex& index, std::size_t begin, std::size_t event);
+    void buildToEdge(const TieIndex& index, std::size_t begin, std::size_t event);
 
-    void createGeometries(const std::vector<std::unique_ptr<Geometry>>& geometries);
-    void createGeometriesFromChord(ChordGeometry* chord);
-    void createGeometryFromNote(NoteGeometry* noteGeometry);
-
-    void buildTieGeometry(const PitchKey& key, NoteGeometry& noteGeometry, const dom::Tied& tie);
     std::unique_ptr<TieGeometry> buildTieGeometry(const NoteGeometry* startGeom, const NoteGeometry* stopGeom, const dom::Optional<dom::Placement>& placement);
     std::unique_ptr<TieGeometry> buildTieGeometryFromEdge(const NoteGeometry* stopGeom, const dom::Optional<dom::Placement>& placement);
     std::unique_ptr<TieGeometry> buildTieGeometryToEdge(const NoteGeometry* startGeom, const dom::Optional<dom::Placement>& placement);
 
-    void buildSlurGeometry(const SlurKey& key, NoteGeometry& noteGeometry, const dom::Slur& slur);
     std::unique_ptr<TieGeometry> buildSlurGeometry(const NoteGeometry* startGeom, const NoteGeometry* stopGeom, const dom::Optional<dom::Placement>& placement);
     std::unique_ptr<TieGeometry> buildSlurGeometryFromEdge(const NoteGeometry* stop, const dom::Optional<dom::Placement>& placement);
     std::unique_ptr<TieGeometry> buildSlurGeometryToEdge(const NoteGeometry* start, const dom::Optional<dom::Placement>& placement);
@@ -54,26 +54,12 @@ private:
     const Metrics& _metrics;
 
     std::vector<std::unique_ptr<TieGeometry>> _tieGeometries;
-    std::map<SlurKey, std::pair<const dom::Slur*, NoteGeometry*>> _slurStartGeometries;
 
-    struct PitchComparator {
-        bool operator()(const PitchKey& a, const PitchKey& b) const {
-            if (a.first < b.first)
-                return true;
-            
-            if (a.first > b.first)
-                return false;
-            
-            if (a.second->step() < b.second->step())
-                return true;
-            
-            if (a.second->step() > b.second->step())
-                return false;
-            
-            return a.second->octave() < b.second->octave();
-        }
-    };
-    std::map<PitchKey, std::pair<const dom::Tied*, NoteGeometry*>, PitchComparator> _tieStartGeometries;
+    /// The note geometry of each event in the range being built
+    std::vector<NoteGeometry*> _noteGeometries;
+
+    /// Ties and slurs that are still open at the end of the range
+    std::vector<std::size_t> _openEvents;
 };
 
 } // namespace mxml
@@ -6,7 +6,6 @@
 
 #include "AppearanceHandler.h"
 
-#include <lxml/DoubleHandler.h>
 #include <mxml/dom/InvalidDataError.h>
 #include <cstring>
 
@@ -34,23 +33,23 @@ lxml::RecursiveHandler* AppearanceHandler::startSubElement(const lxml::QName& qn
 void AppearanceHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
     if (strcmp(qname.localName(), kLineWidthTag) == 0) {
         auto lineWidthNode = _handler.result();
-        auto type = lineTypeFromString(lineWidthNode->attribute("type"));
-        auto value = lxml::DoubleHandler::parseDouble(lineWidthNode->text());
+        auto type = lineTypeFromString(lineWidthNode->attribute("type").value());
+        auto value = parsing::parseDouble(lineWidthNode->text());
         _result.lineWidths[type] = static_cast<dom::tenths_t>(value);
     } else if (strcmp(qname.localName(), kNoteSizeTag) == 0) {
         auto sizeNode = _handler.result();
-        auto type = noteTypeFromString(sizeNode->attribute("type"));
-        auto value = lxml::DoubleHandler::parseDouble(sizeNode->text());
+        auto type = noteTypeFromString(sizeNode->attribute("type").value());
+        auto value = parsing::parseDouble(sizeNode->text());
         _result.noteSizes[type] = static_cast<dom::tenths_t>(value);
     } else if (strcmp(qname.localName(), kDistanceTag) == 0) {
         auto distanceNode = _handler.result();
-        auto type = distanceTypeFromString(distanceNode->attribute("type"));
-        auto value = lxml::DoubleHandler::parseDouble(distanceNode->text());
+        auto type = distanceTypeFromString(distanceNode->attribute("type").value());
+        auto value = parsing::parseDouble(distanceNode->text());
         _result.distances[type] = static_cast<dom::tenths_t>(value);
     }
 }
 
-dom::LineType AppearanceHandler::lineTypeFromString(const std::string& string) {
+dom::LineType AppearanceHandler::lineTypeFromString(parsing::StringView string) {
     if (string == "beam")           return dom::LineType::Beam;
     if (string == "bracket")        return dom::LineType::Bracket;
     if (string == "dashes")         return dom::LineType::Dashes;
@@ -74,7 +73,7 @@ dom::LineType AppearanceHandler::lineTypeFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid halign type " + string);
 }
 
-dom::NoteType AppearanceHandler::noteTypeFromString(const std::string& string) {
+dom::NoteType AppearanceHandler::noteTypeFromString(parsing::StringView string) {
     if (string == "cue")   return dom::NoteType::Cue;
     if (string == "grace") return dom::NoteType::Grace;
     if (string == "large") return dom::NoteType::Large;
@@ -82,7 +81,7 @@ dom::NoteType AppearanceHandler::noteTypeFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid halign type " + string);
 }
 
-dom::DistanceType AppearanceHandler::distanceTypeFromString(const std::string& string) {
+dom::DistanceType AppearanceHandler::distanceTypeFromString(parsing::StringView string) {
     if (string == "beam")   return dom::DistanceType::Beam;
     if (string == "hyphen") return dom::DistanceType::Hyphen;
     
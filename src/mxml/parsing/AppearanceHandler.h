@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "GenericNodeHandler.h"
+#include "StringView.h"
 
 namespace mxml {
 
@@ -19,9 +20,9 @@ public:
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
 
-    static dom::LineType lineTypeFromString(const std::string& string);
-    static dom::NoteType noteTypeFromString(const std::string& string);
-    static dom::DistanceType distanceTypeFromString(const std::string& string);
+    static dom::LineType lineTypeFromString(parsing::StringView string);
+    static dom::NoteType noteTypeFromString(parsing::StringView string);
+    static dom::DistanceType distanceTypeFromString(parsing::StringView string);
     
 private:
     parsing::GenericNodeHandler _handler;
@@ -42,7 +42,7 @@ void ArticulationHandler::startElement(const QName& qname, const AttributeMap& a
         _result->setPlacement(presentOptional(EmptyPlacementHandler::placementFromString(placement->second)));
 }
 
-Articulation::Type ArticulationHandler::typeFromString(const std::string& string) {
+Articulation::Type ArticulationHandler::typeFromString(parsing::StringView string) {
     if (string == "accent") return Articulation::Type::Accent;
     if (string == "breath-mark") return Articulation::Type::BreathMark;
     if (string == "caesura") return Articulation::Type::Caesura;
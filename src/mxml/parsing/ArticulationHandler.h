@@ -11,6 +11,8 @@
 
 #include <string>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class ArticulationHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Articulation>> {
@@ -20,7 +22,7 @@ public:
 public:
     void startElement(const lxml::QName& qname, const lxml::RecursiveHandler::AttributeMap& attributes);
     
-    static dom::Articulation::Type typeFromString(const std::string& string);
+    static dom::Articulation::Type typeFromString(parsing::StringView string);
     
 private:
     EmptyPlacementHandler _emptyPlacementHandler;
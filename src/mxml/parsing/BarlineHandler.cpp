@@ -44,7 +44,7 @@ void BarlineHandler::endSubElement(const QName& qname, RecursiveHandler* parser)
         _result->setRepeat(_repeatHandler.result());
 }
 
-Barline::Style BarlineHandler::styleFromString(const std::string& string) {
+Barline::Style BarlineHandler::styleFromString(parsing::StringView string) {
     if (string == "regular")
         return Barline::Style::Regular;
     else if (string == "dotted")
@@ -70,7 +70,7 @@ Barline::Style BarlineHandler::styleFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid barline style " + string);
 }
 
-Barline::Location BarlineHandler::locationFromString(const std::string& string) {
+Barline::Location BarlineHandler::locationFromString(parsing::StringView string) {
     if (string == "left")
         return Barline::Location::Left;
     else if (string == "middle")
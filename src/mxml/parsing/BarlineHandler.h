@@ -13,6 +13,8 @@
 #include <mxml/dom/Barline.h>
 #include <memory>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class BarlineHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Barline>> {
@@ -21,8 +23,8 @@ public:
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, RecursiveHandler* parser);
     
-    static dom::Barline::Style styleFromString(const std::string& string);
-    static dom::Barline::Location locationFromString(const std::string& string);
+    static dom::Barline::Style styleFromString(parsing::StringView string);
+    static dom::Barline::Location locationFromString(parsing::StringView string);
     
 private:
     lxml::StringHandler _stringHandler;
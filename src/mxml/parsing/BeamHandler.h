@@ -8,14 +8,16 @@
 #include <lxml/BaseRecursiveHandler.h>
 #include <mxml/dom/Beam.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
-class BeamHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Beam>> {
+class BeamHandler : public lxml::BaseRecursiveHandler<dom::Beam> {
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
     
-    static dom::Beam::Type typeFromString(const std::string& string);
+    static dom::Beam::Type typeFromString(parsing::StringView string);
 };
 
 } // namespace mxml
@@ -40,7 +40,7 @@ void ClefHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
         _result->setLine(dom::presentOptional(_integerHandler.result()));
 }
 
-Clef::Sign ClefHandler::signFromString(const std::string& string) {
+Clef::Sign ClefHandler::signFromString(parsing::StringView string) {
     if (string == "none") return Clef::Sign::None;
     if (string == "G") return Clef::Sign::G;
     if (string == "F") return Clef::Sign::F;
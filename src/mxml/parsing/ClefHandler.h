@@ -10,6 +10,8 @@
 #include <lxml/StringHandler.h>
 #include <mxml/dom/Clef.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class ClefHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Clef>> {
@@ -18,7 +20,7 @@ public:
     void endSubElement(const lxml::QName& qname, RecursiveHandler* parser);
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     
-    static dom::Clef::Sign signFromString(const std::string& string);
+    static dom::Clef::Sign signFromString(parsing::StringView string);
     
 private:
     lxml::IntegerHandler _integerHandler;
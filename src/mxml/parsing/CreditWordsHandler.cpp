@@ -50,13 +50,13 @@ void CreditWordsHandler::endElement(const QName& qname, const std::string& conte
     _result->contents = contents;
 }
 
-CreditWords::FontStyle CreditWordsHandler::fontStyleFromString(const std::string& string) {
+CreditWords::FontStyle CreditWordsHandler::fontStyleFromString(StringView string) {
     if (string == "italic")
         return CreditWords::FontStyle::Italic;
     return CreditWords::FontStyle::Normal;
 }
 
-CreditWords::FontWeight CreditWordsHandler::fontWeightFromString(const std::string& string) {
+CreditWords::FontWeight CreditWordsHandler::fontWeightFromString(StringView string) {
     if (string == "bold")
         return CreditWords::FontWeight::Bold;
     return CreditWords::FontWeight::Normal;
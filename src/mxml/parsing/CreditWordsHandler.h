@@ -9,6 +9,8 @@
 
 #include <mxml/dom/CreditWords.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class CreditWordsHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::CreditWords>> {
@@ -16,8 +18,8 @@ public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
     
-    static dom::CreditWords::FontStyle fontStyleFromString(const std::string& string);
-    static dom::CreditWords::FontWeight fontWeightFromString(const std::string& string);
+    static dom::CreditWords::FontStyle fontStyleFromString(parsing::StringView string);
+    static dom::CreditWords::FontWeight fontWeightFromString(parsing::StringView string);
 };
 
 } // namespace mxml
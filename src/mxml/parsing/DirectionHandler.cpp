@@ -52,7 +52,7 @@ void DirectionHandler::endSubElement(const QName& qname, RecursiveHandler* parse
         _result->setSound(_soundHandler.result());
 }
 
-Placement DirectionHandler::placementFromString(const std::string& string) {
+Placement DirectionHandler::placementFromString(parsing::StringView string) {
     if (string == "below")
         return dom::Placement::Below;
     return dom::Placement::Above;
@@ -15,6 +15,8 @@
 
 #include <memory>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class DirectionHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Direction>> {
@@ -24,7 +26,7 @@ public:
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, RecursiveHandler* parser);
     
-    static dom::Placement placementFromString(const std::string& string);
+    static dom::Placement placementFromString(parsing::StringView string);
     
 private:
     lxml::DoubleHandler _doubleHandler;
@@ -106,7 +106,7 @@ void WedgeHandler::startElement(const QName& qname, const AttributeMap& attribut
     }
 }
 
-Wedge::Type WedgeHandler::typeFromString(const std::string& string) {
+Wedge::Type WedgeHandler::typeFromString(StringView string) {
     if (string == "crescendo")
         return Wedge::Type::Crescendo;
     if (string == "diminuendo")
@@ -140,7 +140,7 @@ void PedalHandler::startElement(const lxml::QName& qname, const AttributeMap& at
         _result->setSign(presentOptional(sign->second == "yes"));
 }
 
-dom::StartStopContinue PedalHandler::typeFromString(const std::string& string) {
+dom::StartStopContinue PedalHandler::typeFromString(StringView string) {
     if (string == "start")
         return dom::kStart;
     if (string == "stop")
@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "OctaveShiftHandler.h"
+#include "StringView.h"
 
 
 namespace mxml {
@@ -33,7 +34,7 @@ class WedgeHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Wedg
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     
-    static dom::Wedge::Type typeFromString(const std::string& string);
+    static dom::Wedge::Type typeFromString(parsing::StringView string);
     
 private:
     lxml::IntegerHandler _integerHandler;
@@ -43,7 +44,7 @@ class PedalHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Peda
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
 
-    static dom::StartStopContinue typeFromString(const std::string& string);
+    static dom::StartStopContinue typeFromString(parsing::StringView string);
 };
 
 class WordsHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Words>> {
@@ -69,7 +70,7 @@ public:
 class BracketHandler: public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Bracket>> {
     public:
         void startElement(const lxml::QName& qname, const AttributeMap& attributes);
-        static dom::StartStopContinue typeFromString(const std::string& string);
+        static dom::StartStopContinue typeFromString(parsing::StringView string);
 };
 
 
@@ -23,7 +23,7 @@ void EmptyPlacementHandler::startElement(const QName& qname, const AttributeMap&
         _result->setPlacement(presentOptional(placementFromString(placement->second)));
 }
 
-Placement EmptyPlacementHandler::placementFromString(const std::string& string) {
+Placement EmptyPlacementHandler::placementFromString(parsing::StringView string) {
     if (string == "above")
         return dom::Placement::Above;
     else if (string == "below")
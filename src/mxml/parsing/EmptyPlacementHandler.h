@@ -8,12 +8,14 @@
 #include <lxml/BaseRecursiveHandler.h>
 #include <mxml/dom/EmptyPlacement.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class EmptyPlacementHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::EmptyPlacement>> {
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
-    static dom::Placement placementFromString(const std::string& string);
+    static dom::Placement placementFromString(parsing::StringView string);
 };
 
 } // namespace mxml
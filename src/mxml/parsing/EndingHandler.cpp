@@ -32,7 +32,7 @@ void EndingHandler::endElement(const QName& qname, const std::string& contents)
     _result->setContent(contents);
 }
 
-Ending::Type EndingHandler::typeFromString(const std::string& string) {
+Ending::Type EndingHandler::typeFromString(parsing::StringView string) {
     if (string == "start")
         return Ending::Type::Start;
     else if (string == "stop")
@@ -42,7 +42,7 @@ Ending::Type EndingHandler::typeFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid ending type " + string);
 }
 
-std::set<int> EndingHandler::parseNumberList(const std::string& string) {
+std::set<int> EndingHandler::parseNumberList(parsing::StringView string) {
     std::set<int> set;
     
     std::size_t begin = 0;
@@ -54,7 +54,7 @@ std::set<int> EndingHandler::parseNumberList(const std::string& string) {
         else
             n = end - begin;
         
-        set.insert(lxml::IntegerHandler::parseInteger(string.substr(begin, n)));
+        set.insert(parsing::parseInteger(string.substr(begin, n)));
         begin = end;
         if (end < string.length())
             end = string.find(',', end + 1);
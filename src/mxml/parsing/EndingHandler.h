@@ -9,6 +9,8 @@
 
 #include <mxml/dom/Ending.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class EndingHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Ending>> {
@@ -16,8 +18,8 @@ public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
     
-    static dom::Ending::Type typeFromString(const std::string& string);
-    static std::set<int> parseNumberList(const std::string& string);
+    static dom::Ending::Type typeFromString(parsing::StringView string);
+    static std::set<int> parseNumberList(parsing::StringView string);
 };
 
 } // namespace mxml
@@ -30,7 +30,7 @@ void FermataHandler::endElement(const QName& qname, const std::string& contents)
         _result->setShape(shapeFromString(contents));
 }
 
-Fermata::Type FermataHandler::typeFromString(const std::string& string) {
+Fermata::Type FermataHandler::typeFromString(parsing::StringView string) {
     if (string == "upright")
         return Fermata::Type::Upright;
     else if (string == "inverted")
@@ -38,7 +38,7 @@ Fermata::Type FermataHandler::typeFromString(const std::string& string) {
     throw InvalidDataError("Invalid fermata type " + string);
 }
 
-Fermata::Shape FermataHandler::shapeFromString(const std::string& string) {
+Fermata::Shape FermataHandler::shapeFromString(parsing::StringView string) {
     if (string == "normal")
         return Fermata::Shape::Normal;
     else if (string == "angled")
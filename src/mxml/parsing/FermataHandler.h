@@ -8,6 +8,8 @@
 #include <lxml/BaseRecursiveHandler.h>
 #include <mxml/dom/Fermata.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class FermataHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Fermata>> {
@@ -15,8 +17,8 @@ public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
     
-    static dom::Fermata::Type typeFromString(const std::string& string);
-    static dom::Fermata::Shape shapeFromString(const std::string& string);
+    static dom::Fermata::Type typeFromString(parsing::StringView string);
+    static dom::Fermata::Shape shapeFromString(parsing::StringView string);
 };
 
 } // namespace mxml
@@ -53,21 +53,21 @@ dom::FormattedText FormattedTextHandler::buildFromGenericNode(const parsing::Gen
     result.horizontalAlignment = HAlignFactory::buildFromGenericNode(node);
     result.verticalAlignment = VAlignFactory::buildFromGenericNode(node);
 
-    dom::Optional<std::string> string;
+    dom::Optional<StringView> string;
 
     string = node.attribute(kUnderlineAttribute);
     if (string)
-        result.underline = lxml::IntegerHandler::parseInteger(string) > 0;
+        result.underline = parseInteger(string.value()) > 0;
 
     string = node.attribute(kOverlineAttribute);
     if (string)
-        result.overline = lxml::IntegerHandler::parseInteger(string) > 0;
+        result.overline = parseInteger(string.value()) > 0;
 
     string = node.attribute(kLineThroughAttribute);
     if (string)
-        result.lineThrough = lxml::IntegerHandler::parseInteger(string) > 0;
+        result.lineThrough = parseInteger(string.value()) > 0;
 
-    result.string = lxml::StringHandler::trim(node.text());
+    result.string = node.text().str();
     return result;
 }
 
@@ -9,24 +9,139 @@
 namespace mxml {
 namespace parsing {
 
-dom::Optional<std::string> GenericNode::attribute(const std::string& string) const {
-    auto it = _attributes.find(string);
-    if (it != _attributes.end())
-        return it->second;
-    return dom::Optional<std::string>();
+const std::uint32_t GenericTree::kNone = static_cast<std::uint32_t>(-1);
+
+StringView GenericNode::name() const {
+    return _tree->_names[_name];
+}
+
+bool GenericNode::hasAttribute(StringView name) const {
+    return static_cast<bool>(attribute(name));
+}
+
+dom::Optional<StringView> GenericNode::attribute(StringView name) const {
+    const auto id = _tree->findName(name);
+    if (id == GenericTree::kNone)
+        return dom::Optional<StringView>();
+
+    for (auto i = _attributesBegin; i < _attributesEnd; i += 1) {
+        auto& attribute = _tree->_attributes[i];
+        if (attribute.name == id)
+            return dom::presentOptional(_tree->string(attribute.valueBegin, attribute.valueLength));
+    }
+    return dom::Optional<StringView>();
+}
+
+StringView GenericNode::text() const {
+    return _tree->string(_textBegin, _textLength);
 }
 
-void GenericNode::setAttribute(const std::string& name, const std::string& value) {
-    _attributes[name] = value;
+const GenericNode* GenericNode::parent() const {
+    if (_parent == GenericTree::kNone)
+        return nullptr;
+    return &_tree->_nodes[_parent];
 }
 
-const GenericNode* GenericNode::child(const std::string& name) const {
-    for (auto& child : _children) {
-        if (child->name() == name)
-            return child.get();
+const GenericNode* GenericNode::firstChild() const {
+    if (_firstChild == GenericTree::kNone)
+        return nullptr;
+    return &_tree->_nodes[_firstChild];
+}
+
+const GenericNode* GenericNode::nextSibling() const {
+    if (_nextSibling == GenericTree::kNone)
+        return nullptr;
+    return &_tree->_nodes[_nextSibling];
+}
+
+std::size_t GenericNode::childCount() const {
+    return _childCount;
+}
+
+const GenericNode* GenericNode::child(StringView name) const {
+    const auto id = _tree->findName(name);
+    if (id == GenericTree::kNone)
+        return nullptr;
+
+    for (auto child = firstChild(); child; child = child->nextSibling()) {
+        if (child->_name == id)
+            return child;
     }
     return nullptr;
 }
 
+void GenericTree::clear() {
+    _nodes.clear();
+    _attributes.clear();
+    _strings.clear();
+}
+
+std::uint32_t GenericTree::addNode(StringView name, std::uint32_t parent) {
+    const auto index = static_cast<std::uint32_t>(_nodes.size());
+
+    GenericNode node;
+    node._tree = this;
+    node._name = intern(name);
+    node._parent = parent;
+    node._firstChild = kNone;
+    node._lastChild = kNone;
+    node._nextSibling = kNone;
+    node._childCount = 0;
+    node._attributesBegin = static_cast<std::uint32_t>(_attributes.size());
+    node._attributesEnd = node._attributesBegin;
+    node._textBegin = 0;
+    node._textLength = 0;
+    _nodes.push_back(node);
+
+    if (parent != kNone) {
+        auto& parentNode = _nodes[parent];
+        if (parentNode._lastChild == kNone)
+            parentNode._firstChild = index;
+        else
+            _nodes[parentNode._lastChild]._nextSibling = index;
+        parentNode._lastChild = index;
+        parentNode._childCount += 1;
+    }
+    return index;
+}
+
+void GenericTree::addAttribute(StringView name, StringView value) {
+    Attribute attribute;
+    attribute.name = intern(name);
+    attribute.valueBegin = addString(value);
+    attribute.valueLength = static_cast<std::uint32_t>(value.size());
+    _attributes.push_back(attribute);
+    _nodes.back()._attributesEnd = static_cast<std::uint32_t>(_attributes.size());
+}
+
+void GenericTree::setText(std::uint32_t node, StringView text) {
+    _nodes[node]._textBegin = addString(text);
+    _nodes[node]._textLength = static_cast<std::uint32_t>(text.size());
+}
+
+std::uint32_t GenericTree::findName(StringView name) const {
+    // There are only a handful of distinct names, a linear search beats hashing
+    for (std::size_t i = 0; i < _names.size(); i += 1) {
+        if (name == _names[i])
+            return static_cast<std::uint32_t>(i);
+    }
+    return kNone;
+}
+
+std::uint32_t GenericTree::intern(StringView name) {
+    auto id = findName(name);
+    if (id != kNone)
+        return id;
+
+    _names.push_back(name.str());
+    return static_cast<std::uint32_t>(_names.size() - 1);
+}
+
+std::uint32_t GenericTree::addString(StringView string) {
+    const auto begin = static_cast<std::uint32_t>(_strings.size());
+    _strings.append(string.data(), string.size());
+    return begin;
+}
+
 } // namespace parsing
 } // namespace mxml
@@ -5,56 +5,121 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
-#include <map>
-#include <memory>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include <mxml/dom/Optional.h>
 
+#include "StringView.h"
+
 
 namespace mxml {
 namespace parsing {
 
+class GenericTree;
+
+/**
+ An element of a `GenericTree`. Nodes are owned by their tree and remain valid until the tree is cleared or more nodes
+ are added to it.
+ */
 class GenericNode {
 public:
-    GenericNode() = default;
-    explicit GenericNode(const std::string& name) : _name(name) {}
+    StringView name() const;
 
-    const std::string& name() const { return _name; }
-    void setName(const std::string& name) { _name = name; }
+    bool hasAttribute(StringView name) const;
+    dom::Optional<StringView> attribute(StringView name) const;
 
-    bool hasAttribute(const std::string& string) const;
-    dom::Optional<std::string> attribute(const std::string& string) const;
-    void setAttribute(const std::string& name, const std::string& value);
+    /**
+     The trimmed text content of the element.
+     */
+    StringView text() const;
 
-    const std::string& text() const { return _text; }
-    std::string& text() { return _text; }
-    void setText(const std::string& string) { _text = string; }
+    const GenericNode* parent() const;
+    const GenericNode* firstChild() const;
+    const GenericNode* nextSibling() const;
+    std::size_t childCount() const;
 
-    const GenericNode* parent() const { return _parent; }
-    void setParent(const GenericNode* parent) { _parent = parent; }
+    /**
+     Return the first child with the given name, or nullptr if the child is not found.
+     */
+    const GenericNode* child(StringView name) const;
 
-    const std::vector<std::unique_ptr<GenericNode>>& children() const { return _children; }
-    const std::unique_ptr<GenericNode>& child(std::size_t i) const { return _children[i]; }
-    std::vector<std::unique_ptr<GenericNode>>& children() { return _children; }
-    std::unique_ptr<GenericNode>& child(std::size_t i) { return _children[i]; }
-    void addChild(std::unique_ptr<GenericNode> child) { _children.push_back(std::move(child)); }
+private:
+    friend class GenericTree;
+
+    const GenericTree* _tree;
+    std::uint32_t _name;
+    std::uint32_t _parent;
+    std::uint32_t _firstChild;
+    std::uint32_t _lastChild;
+    std::uint32_t _nextSibling;
+    std::uint32_t _childCount;
+    std::uint32_t _attributesBegin;
+    std::uint32_t _attributesEnd;
+    std::uint32_t _textBegin;
+    std::uint32_t _textLength;
+};
+
+/**
+ Flat storage for a tree of `GenericNode`s. Nodes, attributes and strings live in contiguous arrays indexed by position,
+ and element and attribute names are interned. `clear()` keeps all capacity and the interned names so that a tree can be
+ rebuilt for every element without reallocating.
+ */
+class GenericTree {
+public:
+    static const std::uint32_t kNone;
 
+public:
     /**
-     Return the first child with the given name, or nullptr if the child is not found.
+     Remove all nodes, keeping allocated storage and interned names.
      */
-    const GenericNode* child(const std::string& name) const;
+    void clear();
+
+    std::size_t size() const {
+        return _nodes.size();
+    }
+    const GenericNode& node(std::size_t index) const {
+        return _nodes[index];
+    }
+
+    /**
+     Add a node as the last child of `parent`, or a root node if `parent` is `kNone`. Returns the index of the new node.
+     */
+    std::uint32_t addNode(StringView name, std::uint32_t parent);
+
+    /**
+     Add an attribute to the most recently added node.
+     */
+    void addAttribute(StringView name, StringView value);
+
+    void setText(std::uint32_t node, StringView text);
+
+    /**
+     Return the id of an interned name, or `kNone` if the name was never interned.
+     */
+    std::uint32_t findName(StringView name) const;
+    std::uint32_t intern(StringView name);
 
 private:
-    std::string _name;
+    friend class GenericNode;
 
-    std::map<std::string, std::string> _attributes;
-    std::string _text;
+    struct Attribute {
+        std::uint32_t name;
+        std::uint32_t valueBegin;
+        std::uint32_t valueLength;
+    };
 
-    const GenericNode* _parent;
-    std::vector<std::unique_ptr<GenericNode>> _children;
+    StringView string(std::uint32_t begin, std::uint32_t length) const {
+        return StringView(_strings.data() + begin, length);
+    }
+    std::uint32_t addString(StringView string);
 
+private:
+    std::vector<GenericNode> _nodes;
+    std::vector<Attribute> _attributes;
+    std::string _strings;
+    std::vector<std::string> _names;
 };
 
 } // namespace parsing
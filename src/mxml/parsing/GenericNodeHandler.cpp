@@ -6,31 +6,40 @@
 
 #include "GenericNodeHandler.h"
 
-#include <lxml/StringHandler.h>
-
 
 namespace mxml {
 namespace parsing {
 
 void GenericNodeHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
-    _result.reset(new GenericNode{qname.localName()});
-    for (auto pair : attributes) {
-        _result->setAttribute(pair.first.localName(), pair.second);
+    auto parent = GenericTree::kNone;
+    if (_openNodes.empty()) {
+        _tree.clear();
+        _result = nullptr;
+    } else {
+        parent = _openNodes.back();
+    }
+
+    _openNodes.push_back(_tree.addNode(qname.localName(), parent));
+    for (auto& pair : attributes) {
+        _tree.addAttribute(pair.first.localName(), pair.second);
     }
 }
 
 void GenericNodeHandler::endElement(const lxml::QName& qname, const std::string& contents) {
-    _result->setText(lxml::StringHandler::trim(contents));
+    const auto index = _openNodes.back();
+    _openNodes.pop_back();
+    _tree.setText(index, StringView(contents).trimmed());
+
+    // Node addresses are stable once the root element ends
+    if (_openNodes.empty())
+        _result = &_tree.node(index);
 }
 
 lxml::RecursiveHandler* GenericNodeHandler::startSubElement(const lxml::QName& qname) {
-    if (!_subHandler)
-        _subHandler.reset(new GenericNodeHandler{});
-    return _subHandler.get();
+    return this;
 }
 
 void GenericNodeHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    _result->addChild(_subHandler->result());
 }
 
 } // namespace parsing
@@ -6,7 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
-#include <memory>
+#include <vector>
 
 #include "GenericNode.h"
 
@@ -14,15 +14,24 @@
 namespace mxml {
 namespace parsing {
 
-class GenericNodeHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<GenericNode>> {
+/**
+ Builds a `GenericTree` for an element and all its descendants. The handler handles its own sub-elements and reuses
+ the same tree for every element it parses, so the result is only valid until the next element starts.
+ */
+class GenericNodeHandler : public lxml::BaseRecursiveHandler<const GenericNode*> {
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
-    
+
+    const GenericTree& tree() const {
+        return _tree;
+    }
+
 private:
-    std::unique_ptr<GenericNodeHandler> _subHandler;
+    GenericTree _tree;
+    std::vector<std::uint32_t> _openNodes;
 };
 
 } // namespace parsing
@@ -49,7 +49,7 @@ void KeyHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
         _result->setMode(modeFromString(_stringHandler.result()));
 }
 
-Key::Mode KeyHandler::modeFromString(const std::string& string) {
+Key::Mode KeyHandler::modeFromString(parsing::StringView string) {
     if (string == "major")
         return Key::Mode::Major;
     else if (string == "minor")
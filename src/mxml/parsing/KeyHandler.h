@@ -11,6 +11,8 @@
 
 #include <mxml/dom/Key.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class KeyHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Key>> {
@@ -19,7 +21,7 @@ public:
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, RecursiveHandler* parser);
     
-    static dom::Key::Mode modeFromString(const std::string& string);
+    static dom::Key::Mode modeFromString(parsing::StringView string);
     
 private:
     lxml::IntegerHandler _integerHandler;
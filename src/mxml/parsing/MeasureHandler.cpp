@@ -24,6 +24,11 @@ static const char* kBarlineTag = "barline";
 
 static const char* kNumberAttribute = "number";
 
+void MeasureHandler::setProfile(const ParseProfile& profile) {
+    _profile = profile;
+    _noteHandler.setProfile(profile);
+}
+
 void MeasureHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     endChord();
     
@@ -49,25 +54,25 @@ void MeasureHandler::endElement(const QName& qname, const std::string& contents)
 }
 
 lxml::RecursiveHandler* MeasureHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kNoteTag) == 0)
+    if (_profile.notes && strcmp(qname.localName(), kNoteTag) == 0)
         return &_noteHandler;
     else if (strcmp(qname.localName(), kBackupTag) == 0)
         return &_backupHandler;
     else if (strcmp(qname.localName(), kForwardTag) == 0)
         return &_forwardHandler;
-    else if (strcmp(qname.localName(), kAttributesTag) == 0)
+    else if (_profile.attributes && strcmp(qname.localName(), kAttributesTag) == 0)
         return &_attributesHandler;
-    else if (strcmp(qname.localName(), kDirectionTag) == 0)
+    else if (_profile.directions && strcmp(qname.localName(), kDirectionTag) == 0)
         return &_directionHandler;
-    else if (strcmp(qname.localName(), kPrintTag) == 0)
+    else if (_profile.prints && strcmp(qname.localName(), kPrintTag) == 0)
         return &_printHandler;
-    else if (strcmp(qname.localName(), kBarlineTag) == 0)
+    else if (_profile.barlines && strcmp(qname.localName(), kBarlineTag) == 0)
         return &_barlineHandler;
     return 0;
 }
 
 void MeasureHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kNoteTag) == 0) {
+    if (_profile.notes && strcmp(qname.localName(), kNoteTag) == 0) {
         handleNote(_noteHandler.result());
     } else if(strcmp(qname.localName(), kForwardTag) == 0) {
         std::unique_ptr<dom::Forward> forward = _forwardHandler.result();
@@ -77,18 +82,18 @@ void MeasureHandler::endSubElement(const QName& qname, RecursiveHandler* parser)
         std::unique_ptr<dom::Backup> backup = _backupHandler.result();
         _time -= backup->duration();
         _result->addNode(std::move(backup));
-    } else if (strcmp(qname.localName(), kAttributesTag) == 0) {
+    } else if (_profile.attributes && strcmp(qname.localName(), kAttributesTag) == 0) {
         auto attributes = _attributesHandler.result();
         attributes->setStart(_time);
         attributes->setParent(_result.get());
         _result->addNode(std::move(attributes));
-    } else if (strcmp(qname.localName(), kDirectionTag) == 0) {
+    } else if (_profile.directions && strcmp(qname.localName(), kDirectionTag) == 0) {
         std::unique_ptr<dom::Direction> direction = _directionHandler.result();
         direction->setStart(_time);
         _result->addNode(std::move(direction));
-    } else if (strcmp(qname.localName(), kPrintTag) == 0) {
+    } else if (_profile.prints && strcmp(qname.localName(), kPrintTag) == 0) {
         _result->addNode(_printHandler.result());
-    } else if (strcmp(qname.localName(), kBarlineTag) == 0) {
+    } else if (_profile.barlines && strcmp(qname.localName(), kBarlineTag) == 0) {
         _result->addNode(_barlineHandler.result());
     }
 }
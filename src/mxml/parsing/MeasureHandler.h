@@ -12,6 +12,7 @@
 #include "DirectionHandler.h"
 #include "ForwardHandler.h"
 #include "NoteHandler.h"
+#include "ParseProfile.h"
 #include "PrintHandler.h"
 
 #include <mxml/dom/Chord.h>
@@ -24,6 +25,11 @@ namespace parsing {
 class MeasureHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Measure>> {
 public:
     MeasureHandler() : _lastTime(), _time() {}
+
+    void setProfile(const ParseProfile& profile);
+    void setVoices(dom::VoiceTable* voices) {
+        _noteHandler.setVoices(voices);
+    }
     
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endElement(const lxml::QName& qname, const std::string& contents);
@@ -37,6 +43,7 @@ private:
     void endChord();
     
 private:
+    ParseProfile _profile;
     AttributesHandler _attributesHandler;
     NoteHandler _noteHandler;
     BackupHandler _backupHandler;
@@ -44,7 +44,6 @@ static const char* kVoiceTag = "voice";
 void NoteHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     using dom::presentOptional;
     using lxml::DoubleHandler;
-    using lxml::IntegerHandler;
 
     _result.reset(new Note());
     _result->position = PositionFactory::buildFromAttributes(attributes);
@@ -60,15 +59,15 @@ void NoteHandler::startElement(const QName& qname, const AttributeMap& attribute
 
     auto attack = attributes.find(kAttackAttribute);
     if (attack != attributes.end())
-        _result->setAttack(IntegerHandler::parseInteger(attack->second));
+        _result->setAttack(parseInteger(attack->second));
 
     auto release = attributes.find(kReleaseAttribute);
     if (release != attributes.end())
-        _result->setRelease(IntegerHandler::parseInteger(release->second));
+        _result->setRelease(parseInteger(release->second));
 }
 
 void NoteHandler::endElement(const lxml::QName& qname, const std::string& contents) {
-    auto& pitch = _result->pitch;
+    auto pitch = _result->pitch.get();
     if (pitch) {
         // Avoid alter values outside of the range [-2..2]
         if (pitch->alter() >= 3) {
@@ -86,13 +85,13 @@ lxml::RecursiveHandler* NoteHandler::startSubElement(const QName& qname) {
     if (strcmp(qname.localName(), kDurationTag) == 0)
         return &_integerHandler;
     else if (strcmp(qname.localName(), kTypeTag) == 0)
-        return &_stringHandler;
+        return &_typeHandler;
     else if (strcmp(qname.localName(), kChordTag) == 0)
         return &_presenceHandler;
     else if (strcmp(qname.localName(), kGraceTag) == 0)
         return &_presenceHandler;
     else if (strcmp(qname.localName(), kStemTag) == 0)
-        return &_stringHandler;
+        return &_stemHandler;
     else if (strcmp(qname.localName(), kStaffTag) == 0)
         return &_integerHandler;
     else if (strcmp(qname.localName(), kVoiceTag) == 0)
@@ -109,11 +108,11 @@ lxml::RecursiveHandler* NoteHandler::startSubElement(const QName& qname) {
         return &_emptyPlacementHandler;
     else if (strcmp(qname.localName(), kTieTag) == 0)
         return &_tieHandler;
-    else if (strcmp(qname.localName(), kNotationsTag) == 0)
+    else if (_profile.notations && strcmp(qname.localName(), kNotationsTag) == 0)
         return &_notationsHandler;
-    else if (strcmp(qname.localName(), kBeamTag) == 0)
+    else if (_profile.beams && strcmp(qname.localName(), kBeamTag) == 0)
         return &_beamHandler;
-    else if (strcmp(qname.localName(), kLyricTag) == 0)
+    else if (_profile.lyrics && strcmp(qname.localName(), kLyricTag) == 0)
         return &_lyricHandler;
     else if (strcmp(qname.localName(), kTimeModificationTag) == 0)
         return &_timeModificationHandler;
@@ -126,21 +125,24 @@ void NoteHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     if (strcmp(qname.localName(), kDurationTag) == 0)
         _result->setDuration(presentOptional(_integerHandler.result()));
     else if (strcmp(qname.localName(), kTypeTag) == 0)
-        _result->setType(presentOptional(typeFromString(_stringHandler.result())));
+        _result->setType(presentOptional(_typeHandler.result()));
     else if (strcmp(qname.localName(), kChordTag) == 0)
         _result->setChord(_presenceHandler.result());
     else if (strcmp(qname.localName(), kGraceTag) == 0)
         _result->setGrace(_presenceHandler.result());
     else if (strcmp(qname.localName(), kStemTag) == 0)
-        _result->setStem(presentOptional(stemFromString(_stringHandler.result())));
+        _result->setStem(presentOptional(_stemHandler.result()));
     else if (strcmp(qname.localName(), kStaffTag) == 0)
         _result->setStaff(_integerHandler.result());
-    else if (strcmp(qname.localName(), kVoiceTag) == 0)
-        _result->setVoice(_stringHandler.result());
+    else if (strcmp(qname.localName(), kVoiceTag) == 0) {
+        if (_voices)
+            _result->setVoice(_stringHandler.result(), *_voices);
+        else
+            _result->setVoice(_stringHandler.result());
+    }
     else if (strcmp(qname.localName(), kPitchTag) == 0) {
-        auto pitch = _pitchHandler.result();
-        pitch->setParent(_result.get());
-        _result->pitch = std::move(pitch);
+        _result->pitch = _pitchHandler.result();
+        _result->pitch->setParent(_result.get());
     } else if (strcmp(qname.localName(), kRestTag) == 0) {
         auto rest = _restHandler.result();
         rest->setParent(_result.get());
@@ -148,7 +150,7 @@ void NoteHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     } else if (strcmp(qname.localName(), kUnpitchedTag) == 0) {
         auto unpitched = _unpitchedHandler.result();
         unpitched->setParent(_result.get());
-        _result->unpitched = _unpitchedHandler.result();
+        _result->unpitched = std::move(unpitched);
     } else if (strcmp(qname.localName(), kAccidentalTag) == 0) {
         auto accidental = std::unique_ptr<dom::Accidental>(new dom::Accidental(accidentalTypeFromString(_stringHandler.result())));
         accidental->setParent(_result.get());
@@ -161,15 +163,13 @@ void NoteHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
         auto tie = _tieHandler.result();
         tie->setParent(_result.get());
         _result->tie = std::move(tie);
-    } else if (strcmp(qname.localName(), kNotationsTag) == 0) {
+    } else if (_profile.notations && strcmp(qname.localName(), kNotationsTag) == 0) {
         auto notations = _notationsHandler.result();
         notations->setParent(_result.get());
         _result->notations = std::move(notations);
-    } else if (strcmp(qname.localName(), kBeamTag) == 0) {
-        auto beam = _beamHandler.result();
-        beam->setParent(_result.get());
-        _result->addBeam(std::move(beam));
-    } else if (strcmp(qname.localName(), kLyricTag) == 0) {
+    } else if (_profile.beams && strcmp(qname.localName(), kBeamTag) == 0) {
+        _result->addBeam(_beamHandler.result());
+    } else if (_profile.lyrics && strcmp(qname.localName(), kLyricTag) == 0) {
         auto lyric = _lyricHandler.result();
         lyric->setParent(_result.get());
         _result->addLyric(std::move(lyric));
@@ -180,7 +180,7 @@ void NoteHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     }
 }
 
-Note::Type NoteHandler::typeFromString(const std::string& string) {
+Note::Type NoteHandler::typeFromString(StringView string) {
     if (string == "1024th") return Note::Type::_1024th;
     if (string == "512th") return Note::Type::_512th;
     if (string == "256th") return Note::Type::_256th;
@@ -198,7 +198,7 @@ Note::Type NoteHandler::typeFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid note type " + string);
 }
 
-dom::Stem NoteHandler::stemFromString(const std::string& string) {
+dom::Stem NoteHandler::stemFromString(StringView string) {
     if (string == "none") return dom::Stem::None;
     if (string == "up") return dom::Stem::Up;
     if (string == "down") return dom::Stem::Down;
@@ -206,8 +206,8 @@ dom::Stem NoteHandler::stemFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid note stem " + string);
 }
 
-dom::Accidental::Type NoteHandler::accidentalTypeFromString(const std::string& string) {
-    auto type = dom::Accidental::Type::byName(string.c_str());
+dom::Accidental::Type NoteHandler::accidentalTypeFromString(StringView string) {
+    auto type = dom::Accidental::Type::byName(string.data(), string.size());
     if (!type)
         throw dom::InvalidDataError("Invalid accidental type " + string);
     return *type;
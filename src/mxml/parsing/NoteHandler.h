@@ -6,7 +6,6 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
-#include <lxml/IntegerHandler.h>
 #include <lxml/PresenceHandler.h>
 #include <lxml/StringHandler.h>
 
@@ -17,11 +16,14 @@
 #include "EmptyPlacementHandler.h"
 #include "LyricHandler.h"
 #include "NotationsHandler.h"
+#include "ParseProfile.h"
 #include "PitchHandler.h"
 #include "RestHandler.h"
 #include "TieHandler.h"
 #include "TimeModificationHandler.h"
 #include "UnpitchedHandler.h"
+#include "ValueHandler.h"
+#include "StringView.h"
 
 
 namespace mxml {
@@ -29,15 +31,26 @@ namespace parsing {
 
 class NoteHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Note>> {
 public:
+    void setProfile(const ParseProfile& profile) {
+        _profile = profile;
+    }
+
+    /**
+     Set the table where voice names are stored. Without a table every note keeps its own copy of its voice name.
+     */
+    void setVoices(dom::VoiceTable* voices) {
+        _voices = voices;
+    }
+
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
 
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
-    static dom::Note::Type typeFromString(const std::string& string);
-    static dom::Stem stemFromString(const std::string& string);
-    static dom::Accidental::Type accidentalTypeFromString(const std::string& string);
+    static dom::Note::Type typeFromString(StringView string);
+    static dom::Stem stemFromString(StringView string);
+    static dom::Accidental::Type accidentalTypeFromString(StringView string);
 
 protected:
     /**
@@ -51,8 +64,12 @@ protected:
     void decreasePitch(dom::Pitch& pitch);
 
 private:
-    lxml::IntegerHandler _integerHandler;
+    ParseProfile _profile;
+    dom::VoiceTable* _voices = nullptr;
+    parsing::IntegerHandler _integerHandler;
     lxml::StringHandler _stringHandler;
+    parsing::ValueHandler<dom::Note::Type, &NoteHandler::typeFromString> _typeHandler;
+    parsing::ValueHandler<dom::Stem, &NoteHandler::stemFromString> _stemHandler;
     lxml::PresenceHandler _presenceHandler;
 
     PitchHandler _pitchHandler;
@@ -33,7 +33,7 @@ void OctaveShiftHandler::startElement(const lxml::QName& qname, const AttributeM
     
 }
 
-OctaveShift::Type OctaveShiftHandler::typeFromString(const std::string& string) {
+OctaveShift::Type OctaveShiftHandler::typeFromString(parsing::StringView string) {
     if (string == "up")
         return OctaveShift::Type::Up;
     else if (string == "down")
@@ -11,12 +11,14 @@
 #include <mxml/dom/OctaveShift.h>
 #include <memory>
 
+#include "StringView.h"
+
 namespace mxml {
     class OctaveShiftHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::OctaveShift>> {
     public:
         void startElement(const lxml::QName& qname, const AttributeMap& attributes);
 
-        static dom::OctaveShift::Type typeFromString(const std::string& string);
+        static dom::OctaveShift::Type typeFromString(parsing::StringView string);
 
     private:
         lxml::IntegerHandler _integerHandler;
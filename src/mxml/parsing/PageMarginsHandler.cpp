@@ -52,7 +52,7 @@ void PageMarginsHandler::endSubElement(const lxml::QName& qname, RecursiveHandle
     }
 }
 
-dom::PageMargins::MarginType PageMarginsHandler::marginTypeFromString(const std::string& string) {
+dom::PageMargins::MarginType PageMarginsHandler::marginTypeFromString(parsing::StringView string) {
     if (string == "odd")
         return dom::PageMargins::MarginType::Odd;
     if (string == "even")
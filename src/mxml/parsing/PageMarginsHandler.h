@@ -10,6 +10,8 @@
 
 #include <mxml/dom/PageMargins.h>
 
+#include "StringView.h"
+
 
 namespace mxml {
 
@@ -19,7 +21,7 @@ public:
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
 
-    static dom::PageMargins::MarginType marginTypeFromString(const std::string& string);
+    static dom::PageMargins::MarginType marginTypeFromString(parsing::StringView string);
 
 private:
     lxml::DoubleHandler _doubleHandler;
@@ -0,0 +1,42 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ParseProfile.h"
+
+
+namespace mxml {
+namespace parsing {
+
+const std::size_t ParseProfile::kNoMeasureLimit;
+
+ParseProfile ParseProfile::full() {
+    return ParseProfile();
+}
+
+ParseProfile ParseProfile::metadata() {
+    ParseProfile profile;
+    profile.defaults = false;
+    profile.parts = false;
+    return profile;
+}
+
+ParseProfile ParseProfile::playback() {
+    ParseProfile profile;
+    profile.defaults = false;
+    profile.credits = false;
+    profile.prints = false;
+    profile.lyrics = false;
+    return profile;
+}
+
+ParseProfile ParseProfile::thumbnail(std::size_t measureCount) {
+    ParseProfile profile;
+    profile.measureLimit = measureCount;
+    return profile;
+}
+
+} // namespace parsing
+} // namespace mxml
@@ -0,0 +1,67 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <cstddef>
+#include <limits>
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Selects the parts of a MusicXML document that the score handlers build. Skipped elements are ignored as a whole
+ subtree: the handlers don't descend into them and no DOM nodes are created for them.
+ */
+struct ParseProfile {
+    static const std::size_t kNoMeasureLimit = std::numeric_limits<std::size_t>::max();
+
+    /// Score header elements
+    bool identification = true;
+    bool defaults = true;
+    bool credits = true;
+
+    /// Whether to parse parts at all
+    bool parts = true;
+
+    /// Measure elements
+    bool attributes = true;
+    bool notes = true;
+    bool directions = true;
+    bool prints = true;
+    bool barlines = true;
+
+    /// Note elements
+    bool beams = true;
+    bool notations = true;
+    bool lyrics = true;
+
+    /// The number of measures to parse in every part, later measures are skipped
+    std::size_t measureLimit = kNoMeasureLimit;
+
+    /**
+     Everything in the document.
+     */
+    static ParseProfile full();
+
+    /**
+     Only the identification and credits, for indexing score metadata.
+     */
+    static ParseProfile metadata();
+
+    /**
+     Notes, attributes, directions with their sounds and barlines for repeats; no lyrics, credits or print layout.
+     */
+    static ParseProfile playback();
+
+    /**
+     Everything in the first `measureCount` measures of every part.
+     */
+    static ParseProfile thumbnail(std::size_t measureCount);
+};
+
+} // namespace parsing
+} // namespace mxml
@@ -0,0 +1,87 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ParserContext.h"
+
+#include <lxml/lxml.h>
+#include <mxml/dom/InvalidDataError.h>
+
+#include <fstream>
+#include <streambuf>
+
+
+namespace mxml {
+namespace parsing {
+
+namespace {
+
+/**
+ Read-only stream buffer over memory owned by someone else.
+ */
+class MemoryBuffer : public std::streambuf {
+public:
+    explicit MemoryBuffer(StringView data) {
+        auto begin = const_cast<char*>(data.data());
+        setg(begin, begin, begin + data.size());
+    }
+};
+
+} // namespace
+
+ParserContext::ParserContext() : ParserContext(ParseProfile::full()) {}
+
+ParserContext::ParserContext(const ParseProfile& profile)
+: _handler(new ScoreHandler(profile)),
+  _buffer(),
+  _documentCount(0),
+  _interrupted(false)
+{}
+
+void ParserContext::setProfile(const ParseProfile& profile) {
+    _handler->setProfile(profile);
+}
+
+std::unique_ptr<dom::Score> ParserContext::parse(std::istream& is, const std::string& filename) {
+    if (_interrupted)
+        reset();
+
+    _interrupted = true;
+    lxml::parse(is, filename, *_handler);
+    _interrupted = false;
+
+    _documentCount += 1;
+    return _handler->result();
+}
+
+std::unique_ptr<dom::Score> ParserContext::parse(StringView document, const std::string& filename) {
+    MemoryBuffer buffer(document);
+    std::istream is(&buffer);
+    return parse(is, filename);
+}
+
+std::unique_ptr<dom::Score> ParserContext::parseFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+        throw dom::InvalidDataError("Could not open " + filename);
+
+    file.seekg(0, std::ios::end);
+    _buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(&_buffer[0], _buffer.size());
+    return parse(StringView(_buffer), filename);
+}
+
+void ParserContext::reset() {
+    if (_interrupted) {
+        // Handlers may hold state from the middle of a document
+        const auto profile = _handler->profile();
+        _handler.reset(new ScoreHandler(profile));
+        _interrupted = false;
+    }
+}
+
+} // namespace parsing
+} // namespace mxml
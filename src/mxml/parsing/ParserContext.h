@@ -0,0 +1,76 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/dom/Score.h>
+
+#include "ParseProfile.h"
+#include "ScoreHandler.h"
+#include "StringView.h"
+
+#include <istream>
+#include <memory>
+#include <string>
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Parses a sequence of documents reusing the same handler graph and input buffer. Constructing a `ScoreHandler`
+ constructs every nested handler along with its members, a context only does that once. Files are read into a buffer
+ that is kept between documents, and in-memory documents are parsed in place.
+
+ Reusing a context does not reduce the number of allocations per document by much: nearly all of them are the DOM
+ nodes of the returned score and the element attributes and text built by lxml.
+
+ A context is not thread safe, use one context per thread.
+ */
+class ParserContext {
+public:
+    ParserContext();
+    explicit ParserContext(const ParseProfile& profile);
+
+    const ParseProfile& profile() const {
+        return _handler->profile();
+    }
+    void setProfile(const ParseProfile& profile);
+
+    /**
+     Parse a document. Throws on invalid data, after which the context should be `reset()`.
+     */
+    std::unique_ptr<dom::Score> parse(std::istream& is, const std::string& filename);
+
+    /**
+     Parse an in-memory document without copying it.
+     */
+    std::unique_ptr<dom::Score> parse(StringView document, const std::string& filename);
+
+    /**
+     Read a file into the context's input buffer and parse it.
+     */
+    std::unique_ptr<dom::Score> parseFile(const std::string& filename);
+
+    /**
+     Prepare the context for a new document. Handlers are kept unless the previous parse was interrupted, in which case
+     their intermediate state is discarded.
+     */
+    void reset();
+
+    /// The number of documents parsed successfully since construction
+    std::size_t documentCount() const {
+        return _documentCount;
+    }
+
+private:
+    std::unique_ptr<ScoreHandler> _handler;
+    std::string _buffer;
+    std::size_t _documentCount;
+    bool _interrupted;
+};
+
+} // namespace parsing
+} // namespace mxml
@@ -16,6 +16,11 @@ using lxml::QName;
 static const char* kIdTag = "id";
 static const char* kMeasureTag = "measure";
 
+void PartHandler::setProfile(const ParseProfile& profile) {
+    _profile = profile;
+    _measureHandler.setProfile(profile);
+}
+
 void PartHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Part());
     _measureIndex = 0;
@@ -26,13 +31,16 @@ void PartHandler::startElement(const QName& qname, const AttributeMap& attribute
 }
 
 lxml::RecursiveHandler* PartHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kMeasureTag) == 0)
+    if (strcmp(qname.localName(), kMeasureTag) == 0) {
+        if (_measureIndex >= _profile.measureLimit)
+            return 0;
         return &_measureHandler;
+    }
     return 0;
 }
 
 void PartHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kMeasureTag) == 0) {
+    if (strcmp(qname.localName(), kMeasureTag) == 0 && _measureIndex < _profile.measureLimit) {
         auto measure = _measureHandler.result();
         measure->setIndex(_measureIndex++);
         measure->setParent(_result.get());
@@ -7,6 +7,7 @@
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
 #include "MeasureHandler.h"
+#include "ParseProfile.h"
 
 #include <mxml/dom/Part.h>
 
@@ -17,12 +18,18 @@ namespace parsing {
 
 class PartHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Part>> {
 public:
+    void setProfile(const ParseProfile& profile);
+    void setVoices(dom::VoiceTable* voices) {
+        _measureHandler.setVoices(voices);
+    }
+
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
 private:
+    ParseProfile _profile;
     MeasureHandler _measureHandler;
     std::size_t _measureIndex;
 };
@@ -18,12 +18,12 @@ static const char* kAlterTag = "alter";
 static const char* kOctaveTag = "octave";
 
 void PitchHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
-    _result.reset(new Pitch());
+    _result = Pitch();
 }
 
 lxml::RecursiveHandler* PitchHandler::startSubElement(const QName& qname) {
     if (strcmp(qname.localName(), kStepTag) == 0)
-        return &_stringHandler;
+        return &_stepHandler;
     else if (strcmp(qname.localName(), kAlterTag) == 0)
         return &_integerHandler;
     else if (strcmp(qname.localName(), kOctaveTag) == 0)
@@ -33,14 +33,14 @@ lxml::RecursiveHandler* PitchHandler::startSubElement(const QName& qname) {
 
 void PitchHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     if (strcmp(qname.localName(), kStepTag) == 0)
-        _result->setStep(stepFromString(_stringHandler.result()));
+        _result.setStep(_stepHandler.result());
     else if (strcmp(qname.localName(), kAlterTag) == 0)
-        _result->setAlter(_integerHandler.result());
+        _result.setAlter(_integerHandler.result());
     else if (strcmp(qname.localName(), kOctaveTag) == 0)
-        _result->setOctave(_integerHandler.result());
+        _result.setOctave(_integerHandler.result());
 }
 
-Pitch::Step PitchHandler::stepFromString(const std::string& string) {
+Pitch::Step PitchHandler::stepFromString(parsing::StringView string) {
     char c = string[0];
     switch (c) {
         case 'C':
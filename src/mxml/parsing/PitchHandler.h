@@ -7,25 +7,26 @@
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
 #include <lxml/DoubleHandler.h>
-#include <lxml/IntegerHandler.h>
-#include <lxml/StringHandler.h>
 
 #include <mxml/dom/Pitch.h>
 
+#include "StringView.h"
+#include "ValueHandler.h"
+
 namespace mxml {
 
-class PitchHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Pitch>> {
+class PitchHandler : public lxml::BaseRecursiveHandler<dom::Pitch> {
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
-    static dom::Pitch::Step stepFromString(const std::string& string);
+    static dom::Pitch::Step stepFromString(parsing::StringView string);
     
 private:
     lxml::DoubleHandler _doubleHandler;
-    lxml::IntegerHandler _integerHandler;
-    lxml::StringHandler _stringHandler;
+    parsing::IntegerHandler _integerHandler;
+    parsing::ValueHandler<dom::Pitch::Step, &PitchHandler::stepFromString> _stepHandler;
 };
 
 } // namespace mxml
@@ -43,7 +43,7 @@ dom::Position PositionFactory::buildFromAttributes(const lxml::RecursiveHandler:
 
 dom::Position PositionFactory::buildFromGenericNode(const GenericNode& node) {
     dom::Position position;
-    dom::Optional<std::string> string;
+    dom::Optional<StringView> string;
 
     string = node.attribute(kDefaultXAttribute);
     if (string)
@@ -68,8 +68,8 @@ dom::Position PositionFactory::buildFromGenericNode(const GenericNode& node) {
     return position;
 }
 
-dom::Optional<dom::tenths_t> PositionFactory::value(const std::string& string) {
-    auto value = static_cast<dom::tenths_t>(lxml::DoubleHandler::parseDouble(string));
+dom::Optional<dom::tenths_t> PositionFactory::value(StringView string) {
+    auto value = static_cast<dom::tenths_t>(parseDouble(string));
     return dom::presentOptional(value);
 }
 
@@ -9,6 +9,8 @@
 #include "TypeFactories.h"
 #include <mxml/dom/Position.h>
 
+#include "StringView.h"
+
 
 namespace mxml {
 namespace parsing {
@@ -19,7 +21,7 @@ public:
     static dom::Position buildFromGenericNode(const GenericNode& node);
 
 protected:
-    static dom::Optional<dom::tenths_t> value(const std::string& string);
+    static dom::Optional<dom::tenths_t> value(StringView string);
 };
 
 } // namespace parsing
@@ -7,7 +7,6 @@
 #include "PrintHandler.h"
 #include "TypeFactories.h"
 
-#include <lxml/DoubleHandler.h>
 #include <lxml/IntegerHandler.h>
 
 
@@ -57,10 +56,6 @@ lxml::RecursiveHandler* PrintHandler::startSubElement(const lxml::QName& qname)
         return &_systemLayoutHandler;
     else if (strcmp(qname.localName(), kStaffLayoutTag) == 0)
         return &_staffLayoutHandler;
-    else if (strcmp(qname.localName(), kPartNameDisplayTag) == 0)
-        return &_formattedTextHandler;
-    else if (strcmp(qname.localName(), kPartAbbreviationDisplayTag) == 0)
-        return &_formattedTextHandler;
 
     return &_genericNodeHandler;
 }
@@ -74,9 +69,11 @@ void PrintHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* par
         auto staffLayout = _staffLayoutHandler.result();
         _result->staffDistances[staffLayout.number] = staffLayout.staffDistance;
     } else if (strcmp(qname.localName(), kMeasureLayoutTag) == 0) {
-        auto node = _genericNodeHandler.result();
-        auto value = static_cast<dom::tenths_t>(lxml::DoubleHandler::parseDouble(node->text()));
-        _result->measureDistance = dom::presentOptional(value);
+        auto node = _genericNodeHandler.result()->child("measure-distance");
+        if (node) {
+            auto value = static_cast<dom::tenths_t>(parseDouble(node->text()));
+            _result->measureDistance = dom::presentOptional(value);
+        }
     } else if (strcmp(qname.localName(), kMeasureNumberingTag) == 0) {
         // Not supported
     } else if (strcmp(qname.localName(), kPartNameDisplayTag) == 0) {
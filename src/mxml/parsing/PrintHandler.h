@@ -26,7 +26,6 @@ public:
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
 private:
-    FormattedTextHandler _formattedTextHandler;
     PageLayoutHandler _pageLayoutHandler;
     SystemLayoutHandler _systemLayoutHandler;
     StaffLayoutHandler _staffLayoutHandler;
@@ -28,7 +28,7 @@ void RepeatHandler::startElement(const QName& qname, const AttributeMap& attribu
         _result->setTimes(lxml::IntegerHandler::parseInteger(times->second));
 }
 
-Repeat::Direction RepeatHandler::directionFromString(const std::string& string) {
+Repeat::Direction RepeatHandler::directionFromString(parsing::StringView string) {
     if (string == "forward")
         return Repeat::Direction::Forward;
     else if (string == "backward")
@@ -9,13 +9,15 @@
 
 #include <mxml/dom/Repeat.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class RepeatHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Repeat>> {
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     
-    static dom::Repeat::Direction directionFromString(const std::string& string);
+    static dom::Repeat::Direction directionFromString(parsing::StringView string);
 };
 
 } // namespace mxml
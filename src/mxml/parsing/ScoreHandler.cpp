@@ -20,31 +20,43 @@ static const char* kDefaultsTag = "defaults";
 static const char* kCreditTag = "credit";
 static const char* kPartTag = "part";
 
+ScoreHandler::ScoreHandler(const ParseProfile& profile) {
+    setProfile(profile);
+}
+
+void ScoreHandler::setProfile(const ParseProfile& profile) {
+    _profile = profile;
+    _partHandler.setProfile(profile);
+}
+
 void ScoreHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Score());
     _partIndex = 0;
+
+    // Notes share the voice names stored in their score
+    _partHandler.setVoices(&_result->voices());
 }
 
 RecursiveHandler* ScoreHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kIdentificationTag) == 0)
+    if (_profile.identification && strcmp(qname.localName(), kIdentificationTag) == 0)
         return &_identificationHandler;
-    else if (strcmp(qname.localName(), kDefaultsTag) == 0)
+    else if (_profile.defaults && strcmp(qname.localName(), kDefaultsTag) == 0)
         return &_defaultsHandler;
-    else if (strcmp(qname.localName(), kCreditTag) == 0)
+    else if (_profile.credits && strcmp(qname.localName(), kCreditTag) == 0)
         return &_creditHandler;
-    else if (strcmp(qname.localName(), kPartTag) == 0)
+    else if (_profile.parts && strcmp(qname.localName(), kPartTag) == 0)
         return &_partHandler;
     return 0;
 }
 
 void ScoreHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kIdentificationTag) == 0)
+    if (_profile.identification && strcmp(qname.localName(), kIdentificationTag) == 0)
         _result->setIdentification(_identificationHandler.result());
-    else if (strcmp(qname.localName(), kDefaultsTag) == 0)
+    else if (_profile.defaults && strcmp(qname.localName(), kDefaultsTag) == 0)
         _result->setDefaults(_defaultsHandler.result());
-    else if (strcmp(qname.localName(), kCreditTag) == 0)
+    else if (_profile.credits && strcmp(qname.localName(), kCreditTag) == 0)
         _result->addCredit(_creditHandler.result());
-    else if (strcmp(qname.localName(), kPartTag) == 0) {
+    else if (_profile.parts && strcmp(qname.localName(), kPartTag) == 0) {
         auto part = _partHandler.result();
         part->setParent(_result.get());
         part->setIndex(_partIndex++);
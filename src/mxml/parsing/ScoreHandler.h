@@ -9,6 +9,7 @@
 #include "CreditHandler.h"
 #include "DefaultsHandler.h"
 #include "IdentificationHandler.h"
+#include "ParseProfile.h"
 #include "PartHandler.h"
 #include <mxml/dom/Score.h>
 
@@ -19,11 +20,23 @@ namespace parsing {
 
 class ScoreHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Score>> {
 public:
+    ScoreHandler() = default;
+    explicit ScoreHandler(const ParseProfile& profile);
+
+    /**
+     The profile selecting which elements to parse, everything by default.
+     */
+    const ParseProfile& profile() const {
+        return _profile;
+    }
+    void setProfile(const ParseProfile& profile);
+
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
 private:
+    ParseProfile _profile;
     IdentificationHandler _identificationHandler;
     CreditHandler _creditHandler;
     DefaultsHandler _defaultsHandler;
@@ -0,0 +1,460 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ScoreProbe.h"
+#include "KeyHandler.h"
+
+#include <mxml/dom/InvalidDataError.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+
+namespace mxml {
+namespace parsing {
+
+namespace {
+
+const char* kScorePartwiseTag = "score-partwise";
+const char* kScoreTimewiseTag = "score-timewise";
+const char* kWorkTitleTag = "work-title";
+const char* kMovementTitleTag = "movement-title";
+const char* kIdentificationTag = "identification";
+const char* kCreatorTag = "creator";
+const char* kPartListTag = "part-list";
+const char* kScorePartTag = "score-part";
+const char* kPartNameTag = "part-name";
+const char* kPartTag = "part";
+const char* kMeasureTag = "measure";
+const char* kAttributesTag = "attributes";
+const char* kDivisionsTag = "divisions";
+const char* kKeyTag = "key";
+const char* kFifthsTag = "fifths";
+const char* kModeTag = "mode";
+const char* kTimeTag = "time";
+const char* kBeatsTag = "beats";
+const char* kBeatTypeTag = "beat-type";
+
+const char* kIdAttribute = "id";
+const char* kTypeAttribute = "type";
+
+const char* kComposerType = "composer";
+
+struct Tag {
+    StringView name;
+    StringView attributes;
+    bool end;
+    bool selfClosing;
+};
+
+/**
+ Minimal forward scanner over the tags of an XML document. Comments, processing instructions, CDATA sections and the
+ document type declaration are skipped.
+ */
+class TagScanner {
+public:
+    explicit TagScanner(StringView document) : _it(document.begin()), _end(document.end()), _textBegin(_it) {}
+
+    bool next(Tag& tag);
+
+    /**
+     The text between the previous tag and the current one.
+     */
+    StringView text() const {
+        return _text;
+    }
+
+private:
+    bool skipPast(const char* terminator);
+    void skipDoctype();
+
+private:
+    const char* _it;
+    const char* _end;
+    const char* _textBegin;
+    StringView _text;
+};
+
+bool TagScanner::skipPast(const char* terminator) {
+    const auto length = std::strlen(terminator);
+    while (_it != _end) {
+        auto found = static_cast<const char*>(std::memchr(_it, terminator[0], _end - _it));
+        if (!found || static_cast<std::size_t>(_end - found) < length) {
+            _it = _end;
+            return false;
+        }
+        _it = found + 1;
+        if (std::memcmp(found, terminator, length) == 0) {
+            _it = found + length;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TagScanner::skipDoctype() {
+    // The internal subset can contain '>' inside brackets
+    int depth = 0;
+    for (; _it != _end; ++_it) {
+        if (*_it == '[') {
+            depth += 1;
+        } else if (*_it == ']') {
+            depth -= 1;
+        } else if (*_it == '>' && depth <= 0) {
+            ++_it;
+            return;
+        }
+    }
+}
+
+bool TagScanner::next(Tag& tag) {
+    while (_it != _end) {
+        auto open = static_cast<const char*>(std::memchr(_it, '<', _end - _it));
+        if (!open) {
+            _it = _end;
+            return false;
+        }
+
+        _text = StringView(_textBegin, open - _textBegin);
+        _it = open + 1;
+        if (_it == _end)
+            return false;
+
+        // Comments and processing instructions are not part of the text
+        if (*_it == '?') {
+            skipPast("?>");
+            _textBegin = _it;
+            continue;
+        }
+        if (*_it == '!') {
+            if (_end - _it >= 3 && _it[1] == '-' && _it[2] == '-') {
+                skipPast("-->");
+                _textBegin = _it;
+            } else if (_end - _it >= 8 && std::memcmp(_it, "![CDATA[", 8) == 0) {
+                skipPast("]]>");
+            } else {
+                skipDoctype();
+                _textBegin = _it;
+            }
+            continue;
+        }
+
+        tag.end = *_it == '/';
+        if (tag.end)
+            ++_it;
+
+        auto nameBegin = _it;
+        while (_it != _end && *_it != '>' && *_it != '/' && *_it != ' ' && *_it != '\t' && *_it != '\n' && *_it != '\r')
+            ++_it;
+        tag.name = StringView(nameBegin, _it - nameBegin);
+
+        // Attribute values can contain '>' when quoted
+        auto attributesBegin = _it;
+        char quote = 0;
+        for (; _it != _end; ++_it) {
+            if (quote) {
+                if (*_it == quote)
+                    quote = 0;
+            } else if (*_it == '"' || *_it == '\'') {
+                quote = *_it;
+            } else if (*_it == '>') {
+                break;
+            }
+        }
+        if (_it == _end)
+            return false;
+
+        tag.selfClosing = _it != attributesBegin && *(_it - 1) == '/';
+        tag.attributes = StringView(attributesBegin, _it - attributesBegin - (tag.selfClosing ? 1 : 0));
+        ++_it;
+        _textBegin = _it;
+        return true;
+    }
+    return false;
+}
+
+StringView attributeValue(StringView attributes, const char* name) {
+    const auto nameLength = std::strlen(name);
+    auto it = attributes.begin();
+    const auto end = attributes.end();
+    while (it != end) {
+        while (it != end && (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r'))
+            ++it;
+        auto nameBegin = it;
+        while (it != end && *it != '=' && *it != ' ')
+            ++it;
+        const auto attributeName = StringView(nameBegin, it - nameBegin);
+        while (it != end && *it != '"' && *it != '\'')
+            ++it;
+        if (it == end)
+            break;
+
+        const char quote = *it++;
+        auto valueBegin = it;
+        while (it != end && *it != quote)
+            ++it;
+        if (attributeName == StringView(name, nameLength))
+            return StringView(valueBegin, it - valueBegin);
+        if (it != end)
+            ++it;
+    }
+    return StringView();
+}
+
+void appendUTF8(std::string& result, unsigned long code) {
+    if (code < 0x80) {
+        result.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        result.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        result.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+/**
+ Convert UTF-16 to UTF-8. Unpaired surrogates become U+FFFD and a trailing odd byte is ignored.
+ */
+std::string decodeUTF16(StringView document, bool bigEndian) {
+    const auto data = reinterpret_cast<const unsigned char*>(document.data());
+    const auto unitCount = document.size() / 2;
+    auto unit = [data, bigEndian](std::size_t index) -> unsigned long {
+        const unsigned long first = data[2 * index];
+        const unsigned long second = data[2 * index + 1];
+        return bigEndian ? (first << 8 | second) : (second << 8 | first);
+    };
+
+    std::string result;
+    result.reserve(unitCount);
+    for (std::size_t i = 0; i < unitCount; i += 1) {
+        auto code = unit(i);
+        if (code >= 0xD800 && code < 0xDC00 && i + 1 < unitCount && unit(i + 1) >= 0xDC00 && unit(i + 1) < 0xE000) {
+            code = 0x10000 + ((code - 0xD800) << 10) + (unit(i + 1) - 0xDC00);
+            i += 1;
+        } else if (code >= 0xD800 && code < 0xE000) {
+            code = 0xFFFD;
+        }
+        appendUTF8(result, code);
+    }
+    return result;
+}
+
+/**
+ Get the document as UTF-8 without a byte order mark. UTF-16 documents, detected by their byte order mark or by the
+ encoding of the first '<', are converted into `buffer`.
+ */
+StringView utf8Document(StringView document, std::string& buffer) {
+    const auto data = reinterpret_cast<const unsigned char*>(document.data());
+    const auto size = document.size();
+    if (size >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF)
+        return document.substr(3);
+
+    if (size >= 2 && ((data[0] == 0xFE && data[1] == 0xFF) || (data[0] == 0 && data[1] == '<'))) {
+        const auto begin = data[0] == 0xFE ? 2 : 0;
+        buffer = decodeUTF16(document.substr(begin), true);
+        return StringView(buffer);
+    }
+    if (size >= 2 && ((data[0] == 0xFF && data[1] == 0xFE) || (data[0] == '<' && data[1] == 0))) {
+        const auto begin = data[0] == 0xFF ? 2 : 0;
+        buffer = decodeUTF16(document.substr(begin), false);
+        return StringView(buffer);
+    }
+    return document;
+}
+
+/**
+ Copy text content replacing the predefined entities and character references.
+ */
+std::string decodeText(StringView text) {
+    text = text.trimmed();
+
+    std::string result;
+    result.reserve(text.size());
+    for (std::size_t i = 0; i < text.size(); i += 1) {
+        if (text[i] != '&') {
+            result.push_back(text[i]);
+            continue;
+        }
+
+        const auto semicolon = text.find(';', i);
+        if (semicolon == StringView::npos) {
+            result.push_back(text[i]);
+            continue;
+        }
+
+        const auto entity = text.substr(i + 1, semicolon - i - 1);
+        if (entity == "amp") {
+            result.push_back('&');
+        } else if (entity == "lt") {
+            result.push_back('<');
+        } else if (entity == "gt") {
+            result.push_back('>');
+        } else if (entity == "quot") {
+            result.push_back('"');
+        } else if (entity == "apos") {
+            result.push_back('\'');
+        } else if (!entity.empty() && entity[0] == '#') {
+            unsigned long code = entity.size() > 1 && (entity[1] == 'x' || entity[1] == 'X') ?
+                std::strtoul(entity.substr(2).str().c_str(), nullptr, 16) :
+                std::strtoul(entity.substr(1).str().c_str(), nullptr, 10);
+
+            appendUTF8(result, code);
+        } else {
+            result.append(text.data() + i, semicolon - i + 1);
+        }
+        i = semicolon;
+    }
+    return result;
+}
+
+std::size_t partIndex(ScoreSummary& summary, StringView id) {
+    for (std::size_t index = 0; index < summary.parts.size(); index += 1) {
+        if (summary.parts[index].id == id.str())
+            return index;
+    }
+
+    // Part not declared in the part list
+    summary.parts.push_back(ScoreSummary::Part());
+    summary.parts.back().id = id.str();
+    return summary.parts.size() - 1;
+}
+
+} // namespace
+
+ScoreSummary ScoreProbe::probe(StringView document) {
+    std::string buffer;
+    document = utf8Document(document, buffer);
+
+    ScoreSummary summary;
+    TagScanner scanner(document);
+
+    Tag tag;
+    bool root = false;
+    bool timewise = false;
+    bool identification = false;
+    bool partList = false;
+    bool composer = false;
+    bool attributes = false;
+    bool key = false;
+    bool time = false;
+
+    const std::size_t kNoPart = static_cast<std::size_t>(-1);
+    std::size_t currentPart = kNoPart;
+    std::size_t firstPart = kNoPart;
+    std::size_t measureCount = 0;
+
+    while (scanner.next(tag)) {
+        if (!root) {
+            if (tag.end)
+                continue;
+            timewise = tag.name == kScoreTimewiseTag;
+            if (!timewise && tag.name != kScorePartwiseTag)
+                throw dom::InvalidDataError("Not a MusicXML score: " + tag.name);
+            root = true;
+            continue;
+        }
+
+        if (tag.end) {
+            // Leaf elements are read when they end
+            if (tag.name == kWorkTitleTag) {
+                summary.workTitle = decodeText(scanner.text());
+            } else if (tag.name == kMovementTitleTag) {
+                summary.movementTitle = decodeText(scanner.text());
+            } else if (tag.name == kCreatorTag) {
+                if (composer && summary.composer.empty())
+                    summary.composer = decodeText(scanner.text());
+                composer = false;
+            } else if (tag.name == kPartNameTag) {
+                if (partList && !summary.parts.empty())
+                    summary.parts.back().name = decodeText(scanner.text());
+            } else if (attributes) {
+                if (tag.name == kAttributesTag) {
+                    attributes = false;
+                } else if (tag.name == kDivisionsTag && summary.divisions == 0) {
+                    summary.divisions = parseInteger(scanner.text().trimmed());
+                } else if (key && tag.name == kFifthsTag) {
+                    summary.fifths = parseInteger(scanner.text().trimmed());
+                } else if (key && tag.name == kModeTag) {
+                    try {
+                        summary.mode = KeyHandler::modeFromString(scanner.text().trimmed());
+                    } catch (dom::InvalidDataError&) {
+                        // Keep the default mode
+                    }
+                } else if (key && tag.name == kKeyTag) {
+                    key = false;
+                } else if (time && tag.name == kBeatsTag) {
+                    summary.beats = parseInteger(scanner.text().trimmed());
+                } else if (time && tag.name == kBeatTypeTag) {
+                    summary.beatType = parseInteger(scanner.text().trimmed());
+                } else if (time && tag.name == kTimeTag) {
+                    time = false;
+                }
+            } else if (tag.name == kIdentificationTag) {
+                identification = false;
+            } else if (tag.name == kPartListTag) {
+                partList = false;
+            }
+            continue;
+        }
+
+        if (tag.name == kMeasureTag) {
+            if (timewise) {
+                measureCount += 1;
+            } else if (currentPart != kNoPart) {
+                summary.parts[currentPart].measureCount += 1;
+            }
+        } else if (tag.name == kPartTag) {
+            currentPart = partIndex(summary, attributeValue(tag.attributes, kIdAttribute));
+            if (firstPart == kNoPart)
+                firstPart = currentPart;
+            if (timewise)
+                summary.parts[currentPart].measureCount = measureCount;
+        } else if (tag.name == kAttributesTag) {
+            // Only the attributes of the first measure of the first part are read
+            const bool firstMeasure = currentPart == firstPart && (timewise ? measureCount == 1 : summary.parts[currentPart].measureCount == 1);
+            attributes = !tag.selfClosing && currentPart != kNoPart && firstMeasure;
+        } else if (attributes && tag.name == kKeyTag && !summary.hasKey) {
+            summary.hasKey = true;
+            key = !tag.selfClosing;
+        } else if (attributes && tag.name == kTimeTag && !summary.hasTime) {
+            summary.hasTime = true;
+            time = !tag.selfClosing;
+        } else if (tag.name == kIdentificationTag) {
+            identification = true;
+        } else if (identification && tag.name == kCreatorTag) {
+            composer = attributeValue(tag.attributes, kTypeAttribute) == kComposerType;
+        } else if (tag.name == kPartListTag) {
+            partList = true;
+        } else if (partList && tag.name == kScorePartTag) {
+            summary.parts.push_back(ScoreSummary::Part());
+            summary.parts.back().id = attributeValue(tag.attributes, kIdAttribute).str();
+        }
+    }
+
+    if (!root)
+        throw dom::InvalidDataError("Not a MusicXML score");
+
+    for (auto& part : summary.parts)
+        summary.measureCount = std::max(summary.measureCount, part.measureCount);
+    return summary;
+}
+
+ScoreSummary ScoreProbe::probe(std::istream& is) {
+    std::string document((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    return probe(StringView(document));
+}
+
+} // namespace parsing
+} // namespace mxml
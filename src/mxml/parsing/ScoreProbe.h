@@ -0,0 +1,67 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/dom/Key.h>
+
+#include "StringView.h"
+
+#include <istream>
+#include <string>
+#include <vector>
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Metadata of a MusicXML score, as read by `ScoreProbe`.
+ */
+struct ScoreSummary {
+    struct Part {
+        std::string id;
+        std::string name;
+        std::size_t measureCount = 0;
+    };
+
+    std::string workTitle;
+    std::string movementTitle;
+    std::string composer;
+
+    /// Parts in part-list order
+    std::vector<Part> parts;
+
+    /// The largest measure count of all parts
+    std::size_t measureCount = 0;
+
+    /// Attributes of the first measure of the first part
+    int divisions = 0;
+
+    bool hasKey = false;
+    int fifths = 0;
+    dom::Key::Mode mode = dom::Key::Mode::Major;
+
+    bool hasTime = false;
+    int beats = 0;
+    int beatType = 0;
+};
+
+/**
+ Reads the metadata of a MusicXML score without building a DOM. The document is scanned for tags once, without a full
+ XML parse: only the identification, the part list and the attributes of the first measure are read, later measures
+ are only counted. UTF-16 documents are converted to UTF-8 first. Compressed (.mxl) files are not supported.
+ */
+class ScoreProbe {
+public:
+    /**
+     Probe an uncompressed MusicXML document. Throws `dom::InvalidDataError` if the root element is not a score.
+     */
+    static ScoreSummary probe(StringView document);
+    static ScoreSummary probe(std::istream& is);
+};
+
+} // namespace parsing
+} // namespace mxml
@@ -38,7 +38,7 @@ void SlurHandler::startElement(const QName& qname, const AttributeMap& attribute
         _result->setOrientation(orientationFromString(orientation->second));
 }
 
-dom::StartStopContinue SlurHandler::typeFromString(const std::string& string) {
+dom::StartStopContinue SlurHandler::typeFromString(parsing::StringView string) {
     if (string == "start")
         return dom::kStart;
     else if (string == "continue")
@@ -48,7 +48,7 @@ dom::StartStopContinue SlurHandler::typeFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid slur type " + string);
 }
 
-dom::Placement SlurHandler::placementFromString(const std::string& string) {
+dom::Placement SlurHandler::placementFromString(parsing::StringView string) {
     if (string == "above")
         return dom::Placement::Above;
     else if (string == "below")
@@ -56,7 +56,7 @@ dom::Placement SlurHandler::placementFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid slur placement " + string);
 }
 
-dom::Orientation SlurHandler::orientationFromString(const std::string& string) {
+dom::Orientation SlurHandler::orientationFromString(parsing::StringView string) {
     if (string == "over")
         return dom::Orientation::Over;
     else if (string == "under")
@@ -8,15 +8,17 @@
 #include <lxml/BaseRecursiveHandler.h>
 #include <mxml/dom/Slur.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class SlurHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Slur>> {
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     
-    static dom::StartStopContinue typeFromString(const std::string& string);
-    static dom::Placement placementFromString(const std::string& string);
-    static dom::Orientation orientationFromString(const std::string& string);
+    static dom::StartStopContinue typeFromString(parsing::StringView string);
+    static dom::Placement placementFromString(parsing::StringView string);
+    static dom::Orientation orientationFromString(parsing::StringView string);
 };
 
 } // namespace mxml
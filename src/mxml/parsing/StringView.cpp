@@ -0,0 +1,91 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "StringView.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+
+namespace mxml {
+namespace parsing {
+
+const std::size_t StringView::npos;
+
+namespace {
+
+bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/// Numbers longer than this are parsed from a temporary string
+const std::size_t kMaxNumberLength = 63;
+
+}
+
+StringView StringView::substr(std::size_t pos, std::size_t count) const {
+    pos = std::min(pos, _size);
+    return StringView(_data + pos, std::min(count, _size - pos));
+}
+
+std::size_t StringView::find(char c, std::size_t pos) const {
+    if (pos >= _size)
+        return npos;
+
+    auto found = static_cast<const char*>(std::memchr(_data + pos, c, _size - pos));
+    if (!found)
+        return npos;
+    return static_cast<std::size_t>(found - _data);
+}
+
+StringView StringView::trimmed() const {
+    auto first = begin();
+    auto last = end();
+    while (first != last && isWhitespace(*first))
+        ++first;
+    while (last != first && isWhitespace(*(last - 1)))
+        --last;
+    return StringView(first, static_cast<std::size_t>(last - first));
+}
+
+int parseInteger(StringView string) {
+    auto it = string.begin();
+    const auto end = string.end();
+    while (it != end && isWhitespace(*it))
+        ++it;
+
+    bool negative = false;
+    if (it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    // Stop accumulating once past the limit so that long runs of digits can't overflow
+    const long long limit = negative ? -static_cast<long long>(std::numeric_limits<int>::min()) : std::numeric_limits<int>::max();
+    long long value = 0;
+    for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+        if (value <= limit)
+            value = value * 10 + (*it - '0');
+    }
+    value = std::min(value, limit);
+    return static_cast<int>(negative ? -value : value);
+}
+
+double parseDouble(StringView string) {
+    string = string.trimmed();
+    if (string.size() > kMaxNumberLength)
+        return std::strtod(string.str().c_str(), nullptr);
+
+    // strtod needs a null-terminated string, copy to the stack to avoid allocating
+    char buffer[kMaxNumberLength + 1];
+    std::memcpy(buffer, string.data(), string.size());
+    buffer[string.size()] = 0;
+    return std::strtod(buffer, nullptr);
+}
+
+} // namespace parsing
+} // namespace mxml
@@ -0,0 +1,104 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <cstring>
+#include <string>
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Non-owning view of a sequence of characters, such as an attribute value or the text of an element. The characters are
+ not necessarily null-terminated and have to outlive the view.
+
+ lxml still hands attribute values and element text to the handlers as `std::string`s that it allocates for every
+ element, so views are taken over those strings. Converting through a view saves the copies that the handlers and
+ converters used to make on top of that, not lxml's own allocations.
+ */
+class StringView {
+public:
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+    StringView() : _data(""), _size(0) {}
+    StringView(const char* data, std::size_t size) : _data(data), _size(size) {}
+    StringView(const char* string) : _data(string), _size(std::strlen(string)) {}
+    StringView(const std::string& string) : _data(string.data()), _size(string.size()) {}
+
+    const char* data() const {
+        return _data;
+    }
+    std::size_t size() const {
+        return _size;
+    }
+    std::size_t length() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    const char* begin() const {
+        return _data;
+    }
+    const char* end() const {
+        return _data + _size;
+    }
+
+    char operator[](std::size_t index) const {
+        return _data[index];
+    }
+
+    /**
+     Create a copy of the characters.
+     */
+    std::string str() const {
+        return std::string(_data, _size);
+    }
+
+    StringView substr(std::size_t pos, std::size_t count = npos) const;
+    std::size_t find(char c, std::size_t pos = 0) const;
+
+    /**
+     Get the view without leading and trailing XML whitespace.
+     */
+    StringView trimmed() const;
+
+    bool operator==(StringView rhs) const {
+        return _size == rhs._size && std::memcmp(_data, rhs._data, _size) == 0;
+    }
+    bool operator!=(StringView rhs) const {
+        return !operator==(rhs);
+    }
+
+private:
+    const char* _data;
+    std::size_t _size;
+};
+
+inline std::string operator+(const std::string& lhs, StringView rhs) {
+    return lhs + rhs.str();
+}
+inline std::string operator+(const char* lhs, StringView rhs) {
+    return std::string(lhs) + rhs.str();
+}
+
+/**
+ Parse a decimal integer, ignoring leading whitespace and anything after the digits. Returns 0 if there are no digits.
+ Values that don't fit in an int are clamped to the closest int.
+ */
+int parseInteger(StringView string);
+
+/**
+ Parse a floating point number, ignoring leading whitespace and anything after the number. Returns 0 if there is no
+ number.
+ */
+double parseDouble(StringView string);
+
+} // namespace parsing
+} // namespace mxml
@@ -19,7 +19,7 @@ void SyllabicHandler::endElement(const lxml::QName& qname, const std::string& co
     _result->setType(typeFromString(contents));
 }
 
-dom::Syllabic::Type SyllabicHandler::typeFromString(const std::string& string) {
+dom::Syllabic::Type SyllabicHandler::typeFromString(parsing::StringView string) {
     if (string == "single")
         return dom::Syllabic::Type::Single;
     else if (string == "begin")
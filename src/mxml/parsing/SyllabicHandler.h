@@ -8,13 +8,15 @@
 #include <lxml/BaseRecursiveHandler.h>
 #include <mxml/dom/Syllabic.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class SyllabicHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Syllabic>> {
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
-    static dom::Syllabic::Type typeFromString(const std::string& string);
+    static dom::Syllabic::Type typeFromString(parsing::StringView string);
 };
 
 } // namespace
@@ -22,7 +22,7 @@ void TieHandler::startElement(const QName& qname, const AttributeMap& attributes
         _result->setType(typeFromString(type->second));
 }
 
-dom::StartStopContinue TieHandler::typeFromString(const std::string& string) {
+dom::StartStopContinue TieHandler::typeFromString(parsing::StringView string) {
     if (string == "start")
         return dom::kStart;
     else if (string == "stop")
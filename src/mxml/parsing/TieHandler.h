@@ -8,12 +8,14 @@
 #include <lxml/BaseRecursiveHandler.h>
 #include <mxml/dom/Tie.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class TieHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Tie>> {
 public:
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
-    static dom::StartStopContinue typeFromString(const std::string& string);
+    static dom::StartStopContinue typeFromString(parsing::StringView string);
 };
 
 } // namespace mxml
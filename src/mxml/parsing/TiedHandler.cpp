@@ -38,7 +38,7 @@ void TiedHandler::startElement(const QName& qname, const AttributeMap& attribute
         _result->setOrientation(orientationFromString(orientation->second));
 }
 
-dom::StartStopContinue TiedHandler::typeFromString(const std::string& string) {
+dom::StartStopContinue TiedHandler::typeFromString(parsing::StringView string) {
     if (string == "start")
         return dom::kStart;
     else if (string == "continue")
@@ -48,7 +48,7 @@ dom::StartStopContinue TiedHandler::typeFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid slur type " + string);
 }
 
-dom::Placement TiedHandler::placementFromString(const std::string& string) {
+dom::Placement TiedHandler::placementFromString(parsing::StringView string) {
     if (string == "above")
         return dom::Placement::Above;
     else if (string == "below")
@@ -56,7 +56,7 @@ dom::Placement TiedHandler::placementFromString(const std::string& string) {
     throw dom::InvalidDataError("Invalid slur placement " + string);
 }
 
-dom::Orientation TiedHandler::orientationFromString(const std::string& string) {
+dom::Orientation TiedHandler::orientationFromString(parsing::StringView string) {
     if (string == "over")
         return dom::Orientation::Over;
     else if (string == "under")
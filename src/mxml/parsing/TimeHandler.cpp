@@ -54,7 +54,7 @@ void TimeHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
         _result->setSenzaMisura(presentOptional(_stringHandler.result()));
 }
 
-Time::Symbol TimeHandler::symbolFromString(const std::string& string) {
+Time::Symbol TimeHandler::symbolFromString(parsing::StringView string) {
     if (string == "common")
         return Time::Symbol::Common;
     if (string == "cut")
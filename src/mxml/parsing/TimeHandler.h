@@ -11,6 +11,8 @@
 
 #include <mxml/dom/Time.h>
 
+#include "StringView.h"
+
 namespace mxml {
 
 class TimeHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Time>> {
@@ -19,7 +21,7 @@ public:
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
-    static dom::Time::Symbol symbolFromString(const std::string& string);
+    static dom::Time::Symbol symbolFromString(parsing::StringView string);
     
 private:
     lxml::IntegerHandler _integerHandler;
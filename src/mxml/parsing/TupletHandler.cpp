@@ -69,7 +69,7 @@ void TupletHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* pa
         auto node = _genericNodeHandler.result();
         auto number = node->child("tuplet-number");
         if (number)
-            _result->actual.number = dom::presentOptional(lxml::IntegerHandler::parseInteger(number->text()));
+            _result->actual.number = dom::presentOptional(parseInteger(number->text()));
         auto type = node->child("tuplet-type");
         if (type)
             _result->actual.type = dom::presentOptional(NoteHandler::typeFromString(type->text()));
@@ -77,14 +77,14 @@ void TupletHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* pa
         auto node = _genericNodeHandler.result();
         auto number = node->child("tuplet-number");
         if (number)
-            _result->normal.number = dom::presentOptional(lxml::IntegerHandler::parseInteger(number->text()));
+            _result->normal.number = dom::presentOptional(parseInteger(number->text()));
         auto type = node->child("tuplet-type");
         if (type)
             _result->normal.type = dom::presentOptional(NoteHandler::typeFromString(type->text()));
     }
 }
 
-dom::Tuplet::Type TupletHandler::typeFromString(const std::string& string) {
+dom::Tuplet::Type TupletHandler::typeFromString(StringView string) {
     if (string == "start")
         return dom::Tuplet::Type::Start;
     if (string == "stop")
@@ -92,7 +92,7 @@ dom::Tuplet::Type TupletHandler::typeFromString(const std::string& string) {
     return dom::Tuplet::Type::Start;
 }
 
-dom::Tuplet::Show TupletHandler::showFromString(const std::string& string) {
+dom::Tuplet::Show TupletHandler::showFromString(StringView string) {
     if (string == "actual")
         return dom::Tuplet::Show::Actual;
     if (string == "both")
@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "GenericNodeHandler.h"
+#include "StringView.h"
 
 
 namespace mxml {
@@ -23,8 +24,8 @@ public:
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
 
-    static dom::Tuplet::Type typeFromString(const std::string& string);
-    static dom::Tuplet::Show showFromString(const std::string& string);
+    static dom::Tuplet::Type typeFromString(StringView string);
+    static dom::Tuplet::Show showFromString(StringView string);
     
 private:
     lxml::IntegerHandler _integerHandler;
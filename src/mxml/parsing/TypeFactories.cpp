@@ -14,7 +14,7 @@
 namespace mxml {
 namespace parsing {
 
-bool Factory::yesNoValue(const std::string& string) {
+bool Factory::yesNoValue(StringView string) {
     if (string == "yes")
         return true;
     if (string == "no")
@@ -23,8 +23,8 @@ bool Factory::yesNoValue(const std::string& string) {
     throw dom::InvalidDataError("Invalid print-object value " + string);
 }
 
-dom::tenths_t Factory::tenthsValue(const std::string& string) {
-    return static_cast<dom::tenths_t>(lxml::DoubleHandler::parseDouble(string));
+dom::tenths_t Factory::tenthsValue(StringView string) {
+    return static_cast<dom::tenths_t>(parseDouble(string));
 }
 
 dom::Optional<dom::Justify> JustifyFactory::buildFromAttributes(const AttributeMap& attributes) {
@@ -43,7 +43,7 @@ dom::Optional<dom::Justify> JustifyFactory::buildFromGenericNode(const GenericNo
     return dom::absentOptional(dom::Justify::Left);
 }
 
-dom::Optional<dom::Justify> JustifyFactory::value(const std::string& string) {
+dom::Optional<dom::Justify> JustifyFactory::value(StringView string) {
     if (string == "left")
         return dom::Justify::Left;
     else if (string == "center")
@@ -70,7 +70,7 @@ dom::Optional<dom::HAlign> HAlignFactory::buildFromGenericNode(const GenericNode
     return dom::absentOptional(dom::HAlign::Left);
 }
 
-dom::Optional<dom::HAlign> HAlignFactory::value(const std::string& string) {
+dom::Optional<dom::HAlign> HAlignFactory::value(StringView string) {
     if (string == "left")
         return dom::HAlign::Left;
     else if (string == "center")
@@ -97,7 +97,7 @@ dom::Optional<dom::VAlign> VAlignFactory::buildFromGenericNode(const GenericNode
     return dom::absentOptional(dom::VAlign::Top);
 }
 
-dom::Optional<dom::VAlign> VAlignFactory::value(const std::string& string) {
+dom::Optional<dom::VAlign> VAlignFactory::value(StringView string) {
     if (string == "top")
         return dom::VAlign::Top;
     else if (string == "middle")
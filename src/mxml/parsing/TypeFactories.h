@@ -10,6 +10,7 @@
 #include <mxml/dom/Types.h>
 
 #include "GenericNode.h"
+#include "StringView.h"
 
 
 namespace mxml {
@@ -21,8 +22,8 @@ public:
     using Iterator = AttributeMap::const_iterator;
 
 public:
-    static bool yesNoValue(const std::string& string);
-    static dom::tenths_t tenthsValue(const std::string& string);
+    static bool yesNoValue(StringView string);
+    static dom::tenths_t tenthsValue(StringView string);
 };
 
 class JustifyFactory : public Factory {
@@ -31,7 +32,7 @@ public:
     static dom::Optional<dom::Justify> buildFromGenericNode(const GenericNode& node);
 
 protected:
-    static dom::Optional<dom::Justify> value(const std::string& string);
+    static dom::Optional<dom::Justify> value(StringView string);
 };
 
 class HAlignFactory : public Factory {
@@ -40,7 +41,7 @@ public:
     static dom::Optional<dom::HAlign> buildFromGenericNode(const GenericNode& node);
 
 protected:
-    static dom::Optional<dom::HAlign> value(const std::string& string);
+    static dom::Optional<dom::HAlign> value(StringView string);
 };
 
 class VAlignFactory : public Factory {
@@ -49,7 +50,7 @@ public:
     static dom::Optional<dom::VAlign> buildFromGenericNode(const GenericNode& node);
 
 protected:
-    static dom::Optional<dom::VAlign> value(const std::string& string);
+    static dom::Optional<dom::VAlign> value(StringView string);
 };
 
 class PrintObjectFactory : public Factory {
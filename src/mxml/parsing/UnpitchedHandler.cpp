@@ -22,7 +22,7 @@ void UnpitchedHandler::startElement(const lxml::QName& qname, const AttributeMap
 
 lxml::RecursiveHandler* UnpitchedHandler::startSubElement(const QName& qname) {
     if (strcmp(qname.localName(), kDisplayStepTag) == 0)
-        return &_stringHandler;
+        return &_stepHandler;
     else if (strcmp(qname.localName(), kDisplayOctaveTag) == 0)
         return &_integerHandler;
     return 0;
@@ -30,7 +30,7 @@ lxml::RecursiveHandler* UnpitchedHandler::startSubElement(const QName& qname) {
 
 void UnpitchedHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     if (strcmp(qname.localName(), kDisplayStepTag) == 0)
-        _result->setDisplayStep(PitchHandler::stepFromString(_stringHandler.result()));
+        _result->setDisplayStep(_stepHandler.result());
     else if (strcmp(qname.localName(), kDisplayOctaveTag) == 0)
         _result->setDisplayOctave(_integerHandler.result());
 }
@@ -6,11 +6,11 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
-#include <lxml/IntegerHandler.h>
-#include <lxml/StringHandler.h>
 
 #include <mxml/dom/Unpitched.h>
 
+#include "PitchHandler.h"
+
 namespace mxml {
 
 class UnpitchedHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Unpitched>> {
@@ -20,8 +20,8 @@ public:
     virtual void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
 private:
-    lxml::IntegerHandler _integerHandler;
-    lxml::StringHandler _stringHandler;
+    parsing::IntegerHandler _integerHandler;
+    parsing::ValueHandler<dom::Pitch::Step, &PitchHandler::stepFromString> _stepHandler;
 };
 
 } // namespace mxml
@@ -0,0 +1,34 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <lxml/BaseRecursiveHandler.h>
+
+#include "StringView.h"
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Handler for a leaf element whose text is converted to a value, for instance an enumeration. The text that lxml passes
+ to `endElement` is converted through a view instead of being copied to a result string first.
+ */
+template <typename T, T (*Convert)(StringView)>
+class ValueHandler : public lxml::BaseRecursiveHandler<T> {
+public:
+    void endElement(const lxml::QName& qname, const std::string& contents) {
+        this->_result = Convert(StringView(contents).trimmed());
+    }
+};
+
+/**
+ Handler for integer elements such as <duration>, <staff> or <octave>.
+ */
+using IntegerHandler = ValueHandler<int, &parseInteger>;
+
+} // namespace parsing
+} // namespace mxml
@@ -0,0 +1,104 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <lxml/lxml.h>
+#include <mxml/parsing/ScoreHandler.h>
+#include <mxml/BatchParser.h>
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+using namespace mxml;
+
+namespace {
+
+const char* kFileNames[] = {"moonlight.xml", "events.xml", "events_complex_1.xml", "events_complex_2.xml", "events_ds_al_coda.xml",
+    "events_repeat.xml", "events_repeat_last_measure.xml", "loops.xml", "repeats.xml"};
+
+std::size_t serialMeasureCount(const char* fileName) {
+    parsing::ScoreHandler handler;
+    std::ifstream is(fileName);
+    lxml::parse(is, fileName, handler);
+    return ScoreProperties(*handler.result()).measureCount();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(batchParserCorpus) {
+    BatchParser::Options options;
+    options.threads = 4;
+    options.maxPendingResults = 2;
+
+    BatchParser parser(options);
+    for (auto fileName : kFileNames)
+        parser.addFile(fileName);
+
+    std::set<std::size_t> indices;
+    parser.run([&](BatchParser::Result& result) {
+        BOOST_REQUIRE(!result.error);
+        BOOST_REQUIRE(result.score);
+        BOOST_REQUIRE(result.properties);
+        BOOST_CHECK_EQUAL(result.name, kFileNames[result.index]);
+        BOOST_CHECK_EQUAL(result.properties->measureCount(), serialMeasureCount(kFileNames[result.index]));
+        indices.insert(result.index);
+    });
+    BOOST_CHECK_EQUAL(indices.size(), parser.size());
+}
+
+BOOST_AUTO_TEST_CASE(batchParserMemoryBudget) {
+    std::vector<std::string> documents;
+    std::size_t largest = 0;
+    for (auto fileName : kFileNames) {
+        std::ifstream is(fileName);
+        documents.emplace_back(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+        largest = std::max(largest, documents.back().size());
+    }
+
+    BatchParser::Options options;
+    options.threads = 4;
+    options.expansionFactor = 1;
+    options.memoryBudget = largest;
+
+    BatchParser parser(options);
+    for (std::size_t i = 0; i < documents.size(); i += 1)
+        parser.addBuffer(kFileNames[i], documents[i]);
+
+    std::size_t count = 0;
+    parser.run([&](BatchParser::Result& result) {
+        BOOST_CHECK(!result.error);
+        count += 1;
+    });
+    BOOST_CHECK_EQUAL(count, documents.size());
+    BOOST_CHECK_GT(parser.peakMemory(), 0);
+    BOOST_CHECK_LE(parser.peakMemory(), largest);
+}
+
+BOOST_AUTO_TEST_CASE(batchParserErrors) {
+    BatchParser parser;
+    parser.addBuffer("invalid.xml", parsing::StringView("<score-partwise><part><measure><note><pitch><step>X</step></pitch></note></measure></part></score-partwise>"));
+    parser.addFile("does-not-exist.xml");
+    parser.addFile("events.xml");
+
+    std::size_t errors = 0;
+    std::size_t scores = 0;
+    parser.run([&](BatchParser::Result& result) {
+        if (result.error) {
+            BOOST_CHECK(!result.score);
+            errors += 1;
+        } else {
+            BOOST_CHECK_EQUAL(result.name, "events.xml");
+            scores += 1;
+        }
+    });
+    BOOST_CHECK_EQUAL(errors, 2);
+    BOOST_CHECK_EQUAL(scores, 1);
+
+    BOOST_CHECK_THROW(parser.run([](BatchParser::Result& result) {
+        throw std::runtime_error("stop");
+    }), std::runtime_error);
+}
@@ -0,0 +1,242 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/geometry/factories/BeamSolver.h>
+#include <mxml/geometry/factories/ChordGeometryFactory.h>
+#include <mxml/geometry/NoteGeometry.h>
+#include <mxml/ScoreBuilder.h>
+#include <mxml/ScrollMetrics.h>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+
+using namespace mxml;
+
+namespace {
+
+struct ChordSpec {
+    dom::Pitch::Step step;
+    int octave;
+    dom::Stem stem;
+};
+
+struct BeamLine {
+    Point begin;
+    Point end;
+};
+
+const std::vector<ChordSpec> kFlat = {
+    {dom::Pitch::Step::G, 4, dom::Stem::Up},
+    {dom::Pitch::Step::G, 4, dom::Stem::Up},
+    {dom::Pitch::Step::G, 4, dom::Stem::Up},
+    {dom::Pitch::Step::G, 4, dom::Stem::Up},
+};
+
+const std::vector<ChordSpec> kRising = {
+    {dom::Pitch::Step::C, 4, dom::Stem::Up},
+    {dom::Pitch::Step::E, 4, dom::Stem::Up},
+    {dom::Pitch::Step::G, 4, dom::Stem::Up},
+    {dom::Pitch::Step::C, 6, dom::Stem::Up},
+};
+
+const std::vector<ChordSpec> kFalling = {
+    {dom::Pitch::Step::A, 5, dom::Stem::Down},
+    {dom::Pitch::Step::F, 5, dom::Stem::Down},
+    {dom::Pitch::Step::D, 5, dom::Stem::Down},
+    {dom::Pitch::Step::B, 4, dom::Stem::Down},
+};
+
+const std::vector<ChordSpec> kMixed = {
+    {dom::Pitch::Step::C, 4, dom::Stem::Up},
+    {dom::Pitch::Step::A, 5, dom::Stem::Down},
+    {dom::Pitch::Step::D, 4, dom::Stem::Up},
+    {dom::Pitch::Step::B, 5, dom::Stem::Down},
+};
+
+/// Add a group of beamed sixteenths to a measure
+std::vector<dom::Chord*> addGroup(ScoreBuilder& builder, dom::Measure* measure, const std::vector<ChordSpec>& specs) {
+    std::vector<dom::Chord*> chords;
+    for (std::size_t i = 0; i < specs.size(); i += 1) {
+        auto chord = builder.addChord(measure);
+        auto note = builder.addNote(chord, dom::Note::Type::_16th, static_cast<dom::time_t>(i), 1);
+        builder.setPitch(note, specs[i].step, specs[i].octave);
+        note->setStem(dom::presentOptional(specs[i].stem));
+
+        auto type = dom::Beam::Type::Continue;
+        if (i == 0)
+            type = dom::Beam::Type::Begin;
+        else if (i == specs.size() - 1)
+            type = dom::Beam::Type::End;
+        note->addBeam(dom::Beam(1, type));
+        note->addBeam(dom::Beam(2, type));
+        chords.push_back(chord);
+    }
+    return chords;
+}
+
+std::vector<std::unique_ptr<ChordGeometry>> buildChords(ChordGeometryFactory& factory, const std::vector<dom::Chord*>& chords) {
+    std::vector<std::unique_ptr<ChordGeometry>> geometries;
+    for (std::size_t i = 0; i < chords.size(); i += 1) {
+        auto geometry = factory.build(*chords[i]);
+
+        // Anchor the chord at its reference note like MeasureGeometryFactory does
+        const Point refLocation = geometry->refNoteLocation();
+        const Point offset = geometry->contentOffset();
+        if (geometry->stem()->stemDirection() == dom::Stem::Up) {
+            geometry->setHorizontalAnchorPointValues(0, refLocation.x - offset.x);
+            geometry->setVerticalAnchorPointValues(1, -(geometry->size().height - (refLocation.y - offset.y)));
+        } else {
+            geometry->setHorizontalAnchorPointValues(1, -(geometry->size().width - (refLocation.x - offset.x)));
+            geometry->setVerticalAnchorPointValues(0, refLocation.y - offset.y);
+        }
+        geometry->setLocation({static_cast<coord_t>(30 * i), refLocation.y});
+        geometries.push_back(std::move(geometry));
+    }
+    return geometries;
+}
+
+std::vector<ChordGeometry*> pointers(const std::vector<std::unique_ptr<ChordGeometry>>& geometries) {
+    std::vector<ChordGeometry*> result;
+    for (auto& geometry : geometries)
+        result.push_back(geometry.get());
+    return result;
+}
+
+/// Lay out one beam the way BeamGeometry did before beams were solved in batches
+BeamLine referenceLayout(const std::vector<ChordGeometry*>& chords) {
+    const ChordGeometry* first = chords.front();
+    const ChordGeometry* last = chords.back();
+
+    auto stemDirection = dom::Stem::Up;
+    if (first->stem())
+        stemDirection = first->stem()->stemDirection();
+
+    const Point firstLocation = first->convertToGeometry(first->refNoteLocation(), first->parentGeometry());
+    const Point lastLocation = last->convertToGeometry(last->refNoteLocation(), last->parentGeometry());
+    for (ChordGeometry* chordGeom : chords)
+        chordGeom->setShowFlags(false);
+
+    BeamLine line;
+    if (stemDirection == dom::Stem::Up) {
+        line.begin.x = firstLocation.x + NoteGeometry::kQuarterWidth/2 - BeamGeometry::kStemLineWidth;
+        line.begin.y = first->frame().min().y;
+    } else {
+        line.begin.x = firstLocation.x - NoteGeometry::kQuarterWidth/2;
+        line.begin.y = first->frame().max().y;
+    }
+
+    if (last->stem()->stemDirection() == dom::Stem::Up) {
+        line.end.x = lastLocation.x + NoteGeometry::kQuarterWidth/2;
+        line.end.y = last->frame().min().y;
+    } else {
+        line.end.x = lastLocation.x - NoteGeometry::kQuarterWidth/2 + BeamGeometry::kStemLineWidth;
+        line.end.y = last->frame().max().y;
+    }
+
+    const Point midPoint = {(line.end.x + line.begin.x)/2, (line.end.y + line.begin.y)/2};
+    coord_t s = (line.end.y - line.begin.y) / (line.end.x - line.begin.x);
+    s = std::max(-BeamGeometry::kMaxSlope, std::min(BeamGeometry::kMaxSlope, s));
+    line.begin.y = midPoint.y - s * (midPoint.x - line.begin.x);
+    line.end.y = midPoint.y - s * (midPoint.x - line.end.x);
+
+    coord_t dy = 0;
+    for (ChordGeometry* chordGeom : chords) {
+        const coord_t beamsWidth = chordGeom->chord().firstNote()->beams().size() * (BeamGeometry::kBeamLineWidth + BeamGeometry::kBeamLineSpacing);
+        if (chordGeom->stem()->stemDirection() == dom::Stem::Up) {
+            const coord_t beamx = chordGeom->frame().origin.x + chordGeom->size().width - BeamGeometry::kStemLineWidth/2;
+            const coord_t beamy = line.end.y - s * (line.end.x - beamx) - BeamGeometry::kBeamLineWidth/2;
+            const coord_t maxy = chordGeom->notesFrame().min().y - BeamGeometry::kMinStem - beamsWidth;
+            if (beamy > maxy)
+                dy = std::min(dy, maxy - beamy);
+        } else {
+            const coord_t beamx = chordGeom->frame().origin.x + BeamGeometry::kStemLineWidth/2;
+            const coord_t beamy = line.end.y - s * (line.end.x - beamx) + BeamGeometry::kBeamLineWidth/2;
+            const coord_t miny = chordGeom->notesFrame().max().y + BeamGeometry::kMinStem + beamsWidth;
+            if (beamy < miny)
+                dy = std::max(dy, miny - beamy);
+        }
+    }
+    line.begin.y += dy;
+    line.end.y += dy;
+
+    for (ChordGeometry* chordGeom : chords) {
+        const coord_t innerWidth = (chordGeom->chord().firstNote()->beams().size() - 1) * (BeamGeometry::kBeamLineWidth + BeamGeometry::kBeamLineSpacing);
+
+        coord_t beamx;
+        coord_t beamy = 0;
+        if (chordGeom->stem()->stemDirection() == dom::Stem::Up) {
+            beamx = chordGeom->location().x + NoteGeometry::kQuarterWidth/2 - BeamGeometry::kStemLineWidth/2;
+            if (stemDirection != dom::Stem::Up)
+                beamy = -innerWidth;
+        } else {
+            beamx = chordGeom->location().x - NoteGeometry::kQuarterWidth/2 + BeamGeometry::kStemLineWidth/2;
+            if (stemDirection == dom::Stem::Up)
+                beamy = innerWidth;
+        }
+        chordGeom->extendStem(beamy + line.end.y - s * (line.end.x - beamx));
+    }
+
+    return line;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(beamSolverMatchesSingleBeamLayout) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+    auto measure = builder.addMeasure(part);
+    auto attributes = builder.addAttributes(measure);
+    builder.setTime(attributes);
+    builder.setTrebleClef(attributes);
+
+    const std::vector<std::vector<ChordSpec>> specs = {kFlat, kRising, kFalling, kMixed};
+    std::vector<std::vector<dom::Chord*>> groups;
+    for (auto& group : specs)
+        groups.push_back(addGroup(builder, measure, group));
+    auto score = builder.build();
+
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Scroll);
+    ScrollMetrics metrics(*score, scoreProperties, 0);
+    ChordGeometryFactory factory(scoreProperties, metrics);
+
+    // Solve all groups in one batch and compare each one with the layout of the group on its own
+    std::vector<std::vector<std::unique_ptr<ChordGeometry>>> expected;
+    std::vector<std::vector<std::unique_ptr<ChordGeometry>>> solved;
+    std::vector<std::unique_ptr<BeamGeometry>> beams;
+    std::vector<BeamGeometry*> beamPointers;
+    for (auto& group : groups) {
+        expected.push_back(buildChords(factory, group));
+        solved.push_back(buildChords(factory, group));
+        beams.emplace_back(new BeamGeometry(pointers(solved.back()), false));
+        beamPointers.push_back(beams.back().get());
+    }
+
+    BeamSolver solver;
+    solver.solve(beamPointers);
+
+    for (std::size_t g = 0; g < groups.size(); g += 1) {
+        const BeamLine line = referenceLayout(pointers(expected[g]));
+        BOOST_CHECK_CLOSE(beams[g]->beamBegin().x, line.begin.x, 1e-4);
+        BOOST_CHECK_CLOSE(beams[g]->beamBegin().y, line.begin.y, 1e-4);
+        BOOST_CHECK_CLOSE(beams[g]->beamEnd().x, line.end.x, 1e-4);
+        BOOST_CHECK_CLOSE(beams[g]->beamEnd().y, line.end.y, 1e-4);
+
+        for (std::size_t i = 0; i < groups[g].size(); i += 1) {
+            const Rect stemFrame = solved[g][i]->stem()->frame();
+            const Rect expectedStemFrame = expected[g][i]->stem()->frame();
+            BOOST_CHECK_CLOSE(stemFrame.origin.y, expectedStemFrame.origin.y, 1e-4);
+            BOOST_CHECK_CLOSE(stemFrame.size.height, expectedStemFrame.size.height, 1e-4);
+            BOOST_CHECK(solved[g][i]->frame() == expected[g][i]->frame());
+        }
+    }
+
+    // The rising group is steep enough to hit the slope cap, the flat one is level
+    BOOST_CHECK_CLOSE(beams[1]->slope(), -BeamGeometry::kMaxSlope, 1e-4);
+    BOOST_CHECK_SMALL(beams[0]->slope(), coord_t(1e-6));
+    BOOST_CHECK(beams[3]->placement() == dom::Placement::Below);
+    BOOST_CHECK(beams[2]->placement() == dom::Placement::Above);
+}
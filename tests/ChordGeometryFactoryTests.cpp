@@ -0,0 +1,74 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/geometry/factories/ChordGeometryFactory.h>
+#include <mxml/parsing/ParserContext.h>
+#include <mxml/ScrollMetrics.h>
+#include <boost/test/unit_test.hpp>
+
+#include <typeinfo>
+
+using namespace mxml;
+
+namespace {
+
+void checkSameLayout(const ChordGeometry& geometry, const ChordGeometry& expected) {
+    BOOST_CHECK(geometry.frame() == expected.frame());
+    BOOST_CHECK(geometry.refNoteLocation() == expected.refNoteLocation());
+    BOOST_REQUIRE_EQUAL(geometry.geometries().size(), expected.geometries().size());
+    for (std::size_t i = 0; i < geometry.geometries().size(); i += 1) {
+        auto& geom = *geometry.geometries()[i];
+        auto& expectedGeom = *expected.geometries()[i];
+        BOOST_CHECK(typeid(geom) == typeid(expectedGeom));
+        BOOST_CHECK(geom.frame() == expectedGeom.frame());
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(chordLayoutCache) {
+    parsing::ParserContext context;
+    auto score = context.parseFile("moonlight.xml");
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Scroll);
+
+    for (std::size_t partIndex = 0; partIndex < score->parts().size(); partIndex += 1) {
+        ScrollMetrics metrics(*score, scoreProperties, partIndex);
+        ChordGeometryFactory factory(scoreProperties, metrics);
+
+        for (auto& measure : score->parts()[partIndex]->measures()) {
+            for (auto& node : measure->nodes()) {
+                auto chord = dom::nodeCast<dom::Chord>(node.get());
+                if (!chord)
+                    continue;
+
+                // A new factory always computes the layout from scratch
+                ChordGeometryFactory uncachedFactory(scoreProperties, metrics);
+                auto expected = uncachedFactory.build(*chord);
+                auto geometry = factory.build(*chord);
+                BOOST_REQUIRE_EQUAL(static_cast<bool>(geometry), static_cast<bool>(expected));
+                if (!geometry)
+                    continue;
+                checkSameLayout(*geometry, *expected);
+
+                if (!geometry->stem())
+                    continue;
+
+                // Flip the stem like the stem direction resolver would
+                auto direction = geometry->stem()->stemDirection() == dom::Stem::Up ? dom::Stem::Down : dom::Stem::Up;
+                geometry->stem()->setStemDirection(direction);
+                expected->stem()->setStemDirection(direction);
+                factory.resetForStem(geometry.get());
+                uncachedFactory.resetForStem(expected.get());
+                checkSameLayout(*geometry, *expected);
+            }
+        }
+
+        // The sonata repeats the same few chord shapes
+        BOOST_CHECK_GT(factory.buildStatistics().hits, 0);
+        BOOST_CHECK_GT(factory.buildStatistics().hitRate(), 0.5);
+        BOOST_CHECK_GT(factory.stemStatistics().hits, 0);
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/geometry/collisions/WindowedCollisionHandler.h>
+#include <mxml/geometry/factories/PartGeometryFactory.h>
+#include <mxml/parsing/ParserContext.h>
+#include <mxml/ScrollMetrics.h>
+#include <mxml/SpanFactory.h>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <typeinfo>
+
+using namespace mxml;
+
+namespace {
+
+void checkSameLayout(const Geometry& geometry, const Geometry& expected) {
+    BOOST_CHECK(typeid(geometry) == typeid(expected));
+    BOOST_CHECK(geometry.frame() == expected.frame());
+    BOOST_REQUIRE_EQUAL(geometry.geometries().size(), expected.geometries().size());
+    for (std::size_t i = 0; i < geometry.geometries().size(); i += 1)
+        checkSameLayout(*geometry.geometries()[i], *expected.geometries()[i]);
+}
+
+/// A single staff with a pedal line and a wedge that cross a few measures each
+std::string spanningMusicXML() {
+    std::string xml =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<score-partwise version=\"3.0\">\n"
+        "  <part-list><score-part id=\"P1\"><part-name>Piano</part-name></score-part></part-list>\n"
+        "  <part id=\"P1\">\n";
+    for (int measure = 1; measure <= 16; measure += 1) {
+        xml += "    <measure number=\"" + std::to_string(measure) + "\">\n";
+        if (measure == 1)
+            xml += "      <attributes><divisions>1</divisions><time><beats>2</beats><beat-type>4</beat-type></time>"
+                   "<clef><sign>G</sign><line>2</line></clef></attributes>\n";
+        if (measure == 3)
+            xml += "      <direction placement=\"below\"><direction-type><pedal type=\"start\" line=\"yes\"/></direction-type></direction>\n";
+        if (measure == 9)
+            xml += "      <direction placement=\"below\"><direction-type><wedge type=\"crescendo\"/></direction-type></direction>\n";
+        for (int note = 0; note < 2; note += 1)
+            xml += "      <note><pitch><step>C</step><octave>4</octave></pitch><duration>1</duration><type>quarter</type></note>\n";
+        if (measure == 5)
+            xml += "      <direction placement=\"below\"><direction-type><pedal type=\"stop\" line=\"yes\"/></direction-type></direction>\n";
+        if (measure == 10)
+            xml += "      <direction placement=\"below\"><direction-type><wedge type=\"stop\"/></direction-type></direction>\n";
+        xml += "    </measure>\n";
+    }
+    xml += "  </part>\n</score-partwise>\n";
+    return xml;
+}
+
+void checkWindowedCollisions(const dom::Score* score) {
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Scroll);
+    SpanFactory spanFactory(*score, scoreProperties);
+    auto spans = spanFactory.build();
+
+    for (std::size_t partIndex = 0; partIndex < score->parts().size(); partIndex += 1) {
+        auto& part = *score->parts()[partIndex];
+        ScrollMetrics metrics(*score, scoreProperties, partIndex);
+
+        DirectionGeometryFactory globalDirections;
+        PartGeometryFactory globalFactory(part, scoreProperties, metrics, *spans, globalDirections);
+        globalFactory.setCollisionWindow(0);
+        auto expected = globalFactory.build();
+
+        for (std::size_t measures : {1, 4}) {
+            DirectionGeometryFactory directions;
+            PartGeometryFactory factory(part, scoreProperties, metrics, *spans, directions);
+            factory.setCollisionWindow(measures, 4);
+            auto geometry = factory.build();
+            checkSameLayout(*geometry, *expected);
+
+            // Every collision geometry ends up in exactly one window, except for spanning geometries crossing windows
+            WindowedCollisionHandler handler(*geometry, metrics, measures);
+            auto& spanning = handler.spanningGeometries();
+            std::size_t verticalCount = 0;
+            std::size_t horizontalCount = 0;
+            for (auto& window : handler.windows()) {
+                for (auto geom : window.verticalGeometries) {
+                    if (std::find(spanning.begin(), spanning.end(), geom) == spanning.end())
+                        verticalCount += 1;
+                }
+                horizontalCount += window.horizontalGeometries.size();
+            }
+            BOOST_CHECK_EQUAL(verticalCount + spanning.size(), VerticalResolver::collectGeometries(*geometry).size());
+            BOOST_CHECK_EQUAL(horizontalCount, HorizontalResolver::collectGeometries(*geometry).size());
+            if (geometry->measureGeometries().size() > 2 * measures)
+                BOOST_CHECK_GT(handler.windows().size(), 1);
+
+            // The second pass covers the windows crossed by spanning geometries and nothing else
+            auto& spanningWindowGeometries = handler.spanningWindowGeometries();
+            for (auto geom : spanning)
+                BOOST_CHECK(std::find(spanningWindowGeometries.begin(), spanningWindowGeometries.end(), geom) != spanningWindowGeometries.end());
+            if (spanning.empty())
+                BOOST_CHECK(spanningWindowGeometries.empty());
+        }
+    }
+}
+
+void checkWindowedCollisions(const std::string& fileName) {
+    parsing::ParserContext context;
+    auto score = context.parseFile(fileName);
+    checkWindowedCollisions(score.get());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(windowedCollisionsMoonlight) {
+    checkWindowedCollisions("moonlight.xml");
+}
+
+BOOST_AUTO_TEST_CASE(windowedCollisionsEvents) {
+    checkWindowedCollisions("events_complex_1.xml");
+}
+
+BOOST_AUTO_TEST_CASE(windowedCollisionsSpanning) {
+    parsing::ParserContext context;
+    std::istringstream is(spanningMusicXML());
+    auto score = context.parse(is, "spanning.xml");
+    checkWindowedCollisions(score.get());
+
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Scroll);
+    SpanFactory spanFactory(*score, scoreProperties);
+    auto spans = spanFactory.build();
+    ScrollMetrics metrics(*score, scoreProperties, 0);
+    DirectionGeometryFactory directions;
+    PartGeometryFactory factory(*score->parts().front(), scoreProperties, metrics, *spans, directions);
+    auto geometry = factory.build();
+
+    // Only the windows around the pedal and the wedge take part in the second pass
+    WindowedCollisionHandler handler(*geometry, metrics, 1);
+    BOOST_CHECK_EQUAL(handler.spanningGeometries().size(), 2);
+    BOOST_CHECK_GT(handler.spanningWindowGeometries().size(), handler.spanningGeometries().size());
+    BOOST_CHECK_LT(handler.spanningWindowGeometries().size(), VerticalResolver::collectGeometries(*geometry).size() / 2);
+}
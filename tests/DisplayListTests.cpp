@@ -0,0 +1,120 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/geometry/NoteGeometry.h>
+#include <mxml/geometry/PageScoreGeometry.h>
+#include <mxml/geometry/ScrollScoreGeometry.h>
+#include <mxml/geometry/factories/DisplayListFactory.h>
+#include <mxml/ScoreBuilder.h>
+#include <mxml/StreamOperators.h>
+#include <boost/test/unit_test.hpp>
+
+#include <typeindex>
+
+using namespace mxml;
+
+namespace {
+
+std::unique_ptr<dom::Score> buildScore() {
+    ScoreBuilder builder;
+    for (int p = 0; p < 2; p += 1) {
+        auto part = builder.addPart();
+        for (int m = 0; m < 4; m += 1) {
+            auto measure = builder.addMeasure(part);
+            if (m == 0) {
+                auto attributes = builder.addAttributes(measure);
+                builder.setTime(attributes);
+                builder.setTrebleClef(attributes);
+            }
+            for (int n = 0; n < 4; n += 1) {
+                auto note = builder.addNote(measure, dom::Note::Type::Quarter, n, 1);
+                builder.setPitch(note, dom::Pitch::Step::C, 4 + n);
+            }
+        }
+    }
+    return builder.build();
+}
+
+void checkChunks(const DisplayList& list, std::size_t measureCount) {
+    auto& commands = list.commands();
+    auto& chunks = list.chunks();
+    BOOST_REQUIRE_EQUAL(chunks.size(), measureCount);
+
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < chunks.size(); i += 1) {
+        auto& chunk = chunks[i];
+        BOOST_CHECK_EQUAL(chunk.measureIndex, i);
+        BOOST_CHECK_EQUAL(chunk.begin, begin);
+        BOOST_CHECK(chunk.end > chunk.begin);
+        BOOST_CHECK_EQUAL(list.chunkIndex(i), i);
+        for (std::size_t c = chunk.begin; c < chunk.end; c += 1)
+            BOOST_CHECK_EQUAL(commands[c].measureIndex, i);
+        begin = chunk.end;
+    }
+    BOOST_CHECK_EQUAL(begin, commands.size());
+    BOOST_CHECK_EQUAL(list.chunkIndex(measureCount), DisplayList::kNoChunk);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(displayListScroll) {
+    auto score = buildScore();
+    ScrollScoreGeometry geometry(*score);
+    geometry.setActiveRange(1, 4);
+
+    DisplayListFactory factory;
+    auto list = factory.build(geometry);
+    checkChunks(list, 4);
+
+    // Every note head is drawn at its geometry's location in root coordinates
+    std::vector<Point> anchors;
+    for (auto& command : list.commands()) {
+        if (command.type == DisplayCommand::Type::Glyph && command.glyph == Glyph::NoteheadBlack)
+            anchors.push_back(command.points[0]);
+    }
+    BOOST_CHECK_EQUAL(anchors.size(), 2 * 4 * 4);
+
+    std::size_t noteCount = 0;
+    geometry.lookUpGeometriesWithTypes({typeid(NoteGeometry)}, [&](const Geometry* note) {
+        const Point anchor = note->parentGeometry()->convertToRoot(note->location());
+        BOOST_CHECK(std::find(anchors.begin(), anchors.end(), anchor) != anchors.end());
+        noteCount += 1;
+    });
+    BOOST_CHECK_EQUAL(noteCount, anchors.size());
+
+    // Five staff lines per measure and part, plus ledger lines for the notes above the staff
+    std::size_t lineCount = 0;
+    for (auto& command : list.commands()) {
+        if (command.type == DisplayCommand::Type::Line && command.points[0].y == command.points[1].y)
+            lineCount += 1;
+    }
+    BOOST_CHECK(lineCount > 2 * 4 * 5);
+
+    for (auto& command : list.commands()) {
+        if (command.glyph == Glyph::GClef)
+            BOOST_CHECK_EQUAL(command.measureIndex, 0);
+        if (command.measureIndex == 3)
+            BOOST_CHECK(command.active);
+    }
+
+    auto& lastChunk = list.chunks().back();
+    auto visible = list.visibleChunks(lastChunk.bounds);
+    BOOST_CHECK(std::find(visible.begin(), visible.end(), 3) != visible.end());
+    BOOST_CHECK(std::find(visible.begin(), visible.end(), 0) == visible.end());
+}
+
+BOOST_AUTO_TEST_CASE(displayListPage) {
+    auto score = buildScore();
+    PageScoreGeometry geometry(*score, 400);
+
+    DisplayListFactory factory;
+    auto list = factory.build(geometry);
+    checkChunks(list, 4);
+
+    for (auto& command : list.commands())
+        BOOST_CHECK(command.partIndex < 2);
+    BOOST_CHECK_EQUAL(std::string(glyphName(Glyph::NoteheadBlack)), "noteheadBlack");
+}
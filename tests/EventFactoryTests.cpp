@@ -398,3 +398,211 @@ BOOST_AUTO_TEST_CASE(event_order_complex_2) {
     
     BOOST_CHECK_EQUAL(index, event_order.size());
 }
+
+BOOST_AUTO_TEST_CASE(concurrent_moonlight) {
+    ScoreHandler handler;
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+
+    EventFactory serialFactory(score, scoreProperties);
+    auto serialEvents = serialFactory.build();
+
+    EventFactory concurrentFactory(score, scoreProperties);
+    concurrentFactory.setConcurrent(true);
+    auto concurrentEvents = concurrentFactory.build();
+
+    BOOST_REQUIRE_EQUAL(concurrentEvents->events().size(), serialEvents->events().size());
+    for (std::size_t i = 0; i < serialEvents->events().size(); i += 1) {
+        auto& serialEvent = serialEvents->events()[i];
+        auto& concurrentEvent = concurrentEvents->events()[i];
+        BOOST_CHECK_EQUAL(concurrentEvent.absoluteTime(), serialEvent.absoluteTime());
+        BOOST_CHECK(concurrentEvent.measureLocation() == serialEvent.measureLocation());
+        BOOST_CHECK_EQUAL(concurrentEvent.isBeatMark(), serialEvent.isBeatMark());
+        BOOST_CHECK_EQUAL(concurrentEvent.onNotes().size(), serialEvent.onNotes().size());
+        BOOST_CHECK_EQUAL(concurrentEvent.offNotes().size(), serialEvent.offNotes().size());
+        BOOST_CHECK_CLOSE(concurrentEvent.wallTime(), serialEvent.wallTime(), 0.0001);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parts) {
+    ScoreBuilder builder;
+    auto part1 = builder.addPart();
+    auto part2 = builder.addPart();
+
+    auto measure1 = builder.addMeasure(part1);
+    auto attributes1 = builder.addAttributes(measure1);
+    attributes1->setDivisions(dom::presentOptional(1));
+    auto time = builder.setTime(attributes1);
+    time->setBeats(4);
+    time->setBeatType(4);
+
+    auto measure2 = builder.addMeasure(part2);
+    auto attributes2 = builder.addAttributes(measure2);
+    attributes2->setDivisions(dom::presentOptional(1));
+
+    builder.addNote(measure1, dom::Note::Type::Half, 0, 2);
+    builder.addNote(measure1, dom::Note::Type::Half, 2, 2);
+    builder.addNote(measure2, dom::Note::Type::Quarter, 1, 1);
+
+    auto score = builder.build();
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Scroll);
+
+    EventFactory factory(*score, scoreProperties);
+    auto serialEvents = factory.build();
+    auto partEvents = factory.buildParts();
+    BOOST_REQUIRE_EQUAL(partEvents.size(), 2);
+
+    // Each part has its own notes and all the beat marks
+    for (std::size_t partIndex = 0; partIndex < partEvents.size(); partIndex += 1) {
+        std::size_t beatCount = 0;
+        for (auto& event : *partEvents[partIndex]) {
+            for (auto note : event.onNotes())
+                BOOST_CHECK_EQUAL(note->measure()->part()->index(), partIndex);
+            if (event.isBeatMark())
+                beatCount += 1;
+        }
+        BOOST_CHECK_EQUAL(beatCount, 4);
+    }
+
+    auto& secondPartEvent = *partEvents[1]->find(1);
+    BOOST_CHECK_EQUAL(secondPartEvent.onNotes().size(), 1);
+    BOOST_CHECK_CLOSE(secondPartEvent.wallTime(), serialEvents->find(1)->wallTime(), 0.0001);
+
+    auto mergedEvents = factory.merge({partEvents[0].get(), partEvents[1].get()});
+    BOOST_REQUIRE_EQUAL(mergedEvents->events().size(), serialEvents->events().size());
+    for (std::size_t i = 0; i < serialEvents->events().size(); i += 1) {
+        BOOST_CHECK_EQUAL(mergedEvents->events()[i].absoluteTime(), serialEvents->events()[i].absoluteTime());
+        BOOST_CHECK_EQUAL(mergedEvents->events()[i].onNotes().size(), serialEvents->events()[i].onNotes().size());
+    }
+
+    // Muting the first part leaves only the second part notes
+    auto mutedEvents = factory.merge({partEvents[1].get()});
+    std::size_t onCount = 0;
+    for (auto& event : *mutedEvents)
+        onCount += event.onNotes().size();
+    BOOST_CHECK_EQUAL(onCount, 1);
+}
+
+BOOST_AUTO_TEST_CASE(tied_moonlight) {
+    ScoreHandler handler;
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+
+    EventFactory factory(score, scoreProperties);
+    auto events = factory.build();
+
+    std::size_t tiedCount = 0;
+    std::size_t unresolvedCount = 0;
+    for (std::size_t i = 0; i < events->events().size(); i += 1) {
+        auto& event = events->events()[i];
+        BOOST_REQUIRE_EQUAL(event.onNoteSpans().size(), event.onNotes().size());
+
+        dom::time_t maxDuration = 0;
+        for (std::size_t noteIndex = 0; noteIndex < event.onNotes().size(); noteIndex += 1) {
+            auto note = event.onNotes()[noteIndex];
+            auto& span = event.onNoteSpans()[noteIndex];
+            BOOST_CHECK_GE(span.duration, note->duration());
+            if (span.duration > note->duration())
+                tiedCount += 1;
+            maxDuration = std::max(maxDuration, span.duration);
+
+            if (span.offEventIndex == NoteSpan::kNoEvent) {
+                // A few ties in the score are never stopped
+                unresolvedCount += 1;
+                continue;
+            }
+            BOOST_REQUIRE_LT(span.offEventIndex, events->events().size());
+            BOOST_CHECK_GE(span.offEventIndex, i);
+            auto& offEvent = events->events()[span.offEventIndex];
+            BOOST_CHECK_EQUAL(offEvent.absoluteTime() - event.absoluteTime(), span.duration);
+        }
+        BOOST_CHECK_EQUAL(event.maxDuration(), maxDuration);
+    }
+    BOOST_CHECK_GT(tiedCount, 0);
+    BOOST_CHECK_LT(unresolvedCount, 5);
+
+    // Merging part sequences remaps the off events
+    EventFactory concurrentFactory(score, scoreProperties);
+    concurrentFactory.setConcurrent(true);
+    auto concurrentEvents = concurrentFactory.build();
+    BOOST_REQUIRE_EQUAL(concurrentEvents->events().size(), events->events().size());
+    for (std::size_t i = 0; i < events->events().size(); i += 1) {
+        auto& event = events->events()[i];
+        auto& concurrentEvent = concurrentEvents->events()[i];
+        BOOST_CHECK_EQUAL(concurrentEvent.maxDuration(), event.maxDuration());
+        for (auto& span : concurrentEvent.onNoteSpans()) {
+            if (span.offEventIndex == NoteSpan::kNoEvent)
+                continue;
+            BOOST_REQUIRE_LT(span.offEventIndex, concurrentEvents->events().size());
+            auto& offEvent = concurrentEvents->events()[span.offEventIndex];
+            BOOST_CHECK_EQUAL(offEvent.absoluteTime() - concurrentEvent.absoluteTime(), span.duration);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(slice) {
+    for (auto fileName : {kMoonlightFileName, kEventsRepeatFileName, kEventsDSAlCodaFileName, kEventsComplex1FileName, kEventsComplex2FileName}) {
+        ScoreHandler handler;
+        std::ifstream is(fileName);
+        lxml::parse(is, fileName, handler);
+
+        const dom::Score& score = *handler.result();
+        ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+        const auto measureCount = score.parts().front()->measures().size();
+
+        EventFactory factory(score, scoreProperties);
+        factory.build();
+
+        // Every range, including ones starting or ending inside loops, matches a full build of the range
+        const std::size_t step = std::max<std::size_t>(measureCount / 7, 1);
+        for (std::size_t start = 0; start < measureCount; start += step) {
+            for (std::size_t end = start + 1; end <= measureCount; end += step) {
+                auto slicedEvents = factory.slice(start, end);
+
+                EventFactory rangeFactory(score, scoreProperties);
+                auto rangeEvents = rangeFactory.build(0, start, end);
+
+                BOOST_REQUIRE_EQUAL(slicedEvents->events().size(), rangeEvents->events().size());
+                for (std::size_t i = 0; i < rangeEvents->events().size(); i += 1) {
+                    auto& slicedEvent = slicedEvents->events()[i];
+                    auto& rangeEvent = rangeEvents->events()[i];
+                    BOOST_CHECK_EQUAL(slicedEvent.absoluteTime(), rangeEvent.absoluteTime());
+                    BOOST_CHECK(slicedEvent.measureLocation() == rangeEvent.measureLocation());
+                    BOOST_CHECK_EQUAL(slicedEvent.isBeatMark(), rangeEvent.isBeatMark());
+                    BOOST_CHECK_EQUAL(slicedEvent.onNotes().size(), rangeEvent.onNotes().size());
+                    BOOST_CHECK_EQUAL(slicedEvent.offNotes().size(), rangeEvent.offNotes().size());
+                    BOOST_CHECK_EQUAL(slicedEvent.maxDuration(), rangeEvent.maxDuration());
+                    BOOST_CHECK_CLOSE(slicedEvent.wallTime(), rangeEvent.wallTime(), 0.0001);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(slice_unprepared) {
+    ScoreHandler handler;
+    std::ifstream is(kEventsRepeatFileName);
+    lxml::parse(is, kEventsRepeatFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+
+    // Slicing without a previous build processes the whole score first
+    EventFactory factory(score, scoreProperties);
+    auto slicedEvents = factory.slice(0, 2);
+    auto rangeEvents = factory.build(0, 0, 2);
+    BOOST_REQUIRE_EQUAL(slicedEvents->events().size(), rangeEvents->events().size());
+    for (std::size_t i = 0; i < rangeEvents->events().size(); i += 1)
+        BOOST_CHECK_EQUAL(slicedEvents->events()[i].absoluteTime(), rangeEvents->events()[i].absoluteTime());
+
+    // A partial build can't be sliced, the next slice processes the whole score again
+    auto fullEvents = factory.slice(0, score.parts().front()->measures().size());
+    EventFactory fullFactory(score, scoreProperties);
+    BOOST_CHECK_EQUAL(fullEvents->events().size(), fullFactory.build()->events().size());
+}
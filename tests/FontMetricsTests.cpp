@@ -0,0 +1,179 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/dom/InvalidDataError.h>
+#include <mxml/geometry/FontMetrics.h>
+#include <mxml/geometry/LyricGeometry.h>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+
+using namespace mxml;
+
+namespace {
+
+void appendUInt16(std::string& data, std::uint16_t value) {
+    data.push_back(static_cast<char>(value >> 8));
+    data.push_back(static_cast<char>(value & 0xFF));
+}
+
+void appendUInt32(std::string& data, std::uint32_t value) {
+    appendUInt16(data, static_cast<std::uint16_t>(value >> 16));
+    appendUInt16(data, static_cast<std::uint16_t>(value & 0xFFFF));
+}
+
+/**
+ Build a font with 1000 units per em and three glyphs: 'A' (600 units), U+6B4C (1000 units) and U+8A5E (1000 units,
+ past the last long horizontal metric).
+ */
+std::string buildFont() {
+    std::string head(54, '\0');
+    head[18] = static_cast<char>(1000 >> 8);
+    head[19] = static_cast<char>(1000 & 0xFF);
+
+    std::string hhea(36, '\0');
+    hhea[34] = 0;
+    hhea[35] = 3;
+
+    std::string hmtx;
+    for (std::uint16_t advance : {500, 600, 1000}) {
+        appendUInt16(hmtx, advance);
+        appendUInt16(hmtx, 0);
+    }
+
+    // A format 4 subtable with segments for 'A', U+6B4C-U+6B4C, U+8A5E and the final 0xFFFF segment
+    std::string cmap;
+    appendUInt16(cmap, 0);
+    appendUInt16(cmap, 1);
+    appendUInt16(cmap, 3);
+    appendUInt16(cmap, 1);
+    appendUInt32(cmap, 12);
+
+    const std::uint16_t starts[] = {0x41, 0x6B4C, 0x8A5E, 0xFFFF};
+    const std::uint16_t glyphs[] = {1, 2, 3, 0};
+    appendUInt16(cmap, 4);
+    appendUInt16(cmap, 16 + 4 * 8);
+    appendUInt16(cmap, 0);
+    appendUInt16(cmap, 4 * 2);
+    appendUInt16(cmap, 0);
+    appendUInt16(cmap, 0);
+    appendUInt16(cmap, 0);
+    for (auto code : starts)
+        appendUInt16(cmap, code);
+    appendUInt16(cmap, 0);
+    for (auto code : starts)
+        appendUInt16(cmap, code);
+    for (std::size_t i = 0; i < 4; i += 1)
+        appendUInt16(cmap, static_cast<std::uint16_t>(glyphs[i] - starts[i] + (i == 3 ? 1 : 0)));
+    for (std::size_t i = 0; i < 4; i += 1)
+        appendUInt16(cmap, 0);
+
+    const std::pair<const char*, const std::string*> tables[] = {
+        {"cmap", &cmap},
+        {"head", &head},
+        {"hhea", &hhea},
+        {"hmtx", &hmtx},
+    };
+
+    std::string font;
+    appendUInt32(font, 0x00010000);
+    appendUInt16(font, 4);
+    appendUInt16(font, 0);
+    appendUInt16(font, 0);
+    appendUInt16(font, 0);
+
+    std::uint32_t offset = 12 + 4 * 16;
+    for (auto& table : tables) {
+        font.append(table.first, 4);
+        appendUInt32(font, 0);
+        appendUInt32(font, offset);
+        appendUInt32(font, static_cast<std::uint32_t>(table.second->size()));
+        offset += static_cast<std::uint32_t>(table.second->size());
+    }
+    for (auto& table : tables)
+        font += *table.second;
+    return font;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(builtinFontMetrics) {
+    BuiltinFontMetrics metrics;
+    BOOST_CHECK_EQUAL(metrics.advance(TextFont::Words, BuiltinFontMetrics::kWordsFontSize, 'A'), 14);
+    BOOST_CHECK_EQUAL(metrics.advance(TextFont::Dynamics, BuiltinFontMetrics::kDynamicsFontSize, 'f'), 9);
+    BOOST_CHECK_EQUAL(metrics.advance(TextFont::Lyrics, BuiltinFontMetrics::kLyricsFontSize, 'a'), 9);
+    BOOST_CHECK_EQUAL(metrics.advance(TextFont::Lyrics, 2 * BuiltinFontMetrics::kLyricsFontSize, 'a'), 18);
+
+    // CJK characters are one em wide, other characters outside Latin-1 get the default width
+    BOOST_CHECK(BuiltinFontMetrics::isWide(0x6B4C));
+    BOOST_CHECK(!BuiltinFontMetrics::isWide(0x201C));
+    BOOST_CHECK_EQUAL(metrics.advance(TextFont::Lyrics, BuiltinFontMetrics::kLyricsFontSize, 0x6B4C), BuiltinFontMetrics::kLyricsFontSize);
+    BOOST_CHECK_EQUAL(metrics.advance(TextFont::Lyrics, BuiltinFontMetrics::kLyricsFontSize, 0x201C), 18);
+}
+
+BOOST_AUTO_TEST_CASE(glyphAdvanceCacheMeasure) {
+    GlyphAdvanceCache cache;
+    const std::string word = "la";
+    const std::string cjk = "\xE6\xAD\x8C\xE8\xA9\x9E"; // U+6B4C U+8A5E
+    const std::string emoji = "\xF0\x9F\x8E\xB5"; // U+1F3B5
+
+    BOOST_CHECK_EQUAL(cache.measure(TextFont::Lyrics, 21, word), 14);
+    BOOST_CHECK_EQUAL(cache.measure(TextFont::Lyrics, 21, cjk), 42);
+    BOOST_CHECK_EQUAL(cache.measure(TextFont::Lyrics, 21, emoji), 18);
+    BOOST_CHECK_EQUAL(cache.size(), 5);
+
+    auto widths = cache.measure(TextFont::Lyrics, 21, {&word, &cjk, &word});
+    BOOST_REQUIRE_EQUAL(widths.size(), 3);
+    BOOST_CHECK_EQUAL(widths[0], 14);
+    BOOST_CHECK_EQUAL(widths[1], 42);
+    BOOST_CHECK_EQUAL(widths[2], 14);
+    BOOST_CHECK_EQUAL(cache.size(), 5);
+
+    // Sizes are cached separately
+    BOOST_CHECK_EQUAL(cache.measure(TextFont::Lyrics, 42, word), 28);
+    BOOST_CHECK_EQUAL(cache.size(), 7);
+
+    // Truncated sequences end the text
+    BOOST_CHECK_EQUAL(cache.measure(TextFont::Lyrics, 21, word + "\xE6\xAD"), 14);
+}
+
+BOOST_AUTO_TEST_CASE(trueTypeFontMetrics) {
+    const auto font = buildFont();
+    TrueTypeFontMetrics metrics;
+    BOOST_CHECK(!metrics.loaded(TextFont::Lyrics));
+    metrics.load(TextFont::Lyrics, font.data(), font.size());
+    BOOST_CHECK(metrics.loaded(TextFont::Lyrics));
+
+    BOOST_CHECK_CLOSE(metrics.advance(TextFont::Lyrics, 20, 'A'), 12, 0.001);
+    BOOST_CHECK_CLOSE(metrics.advance(TextFont::Lyrics, 20, 0x6B4C), 20, 0.001);
+    BOOST_CHECK_CLOSE(metrics.advance(TextFont::Lyrics, 20, 0x8A5E), 20, 0.001);
+
+    // Missing glyphs and fonts that are not loaded use the fallback
+    BOOST_CHECK_EQUAL(metrics.advance(TextFont::Lyrics, BuiltinFontMetrics::kLyricsFontSize, 'a'), 9);
+    BOOST_CHECK_EQUAL(metrics.advance(TextFont::Words, BuiltinFontMetrics::kWordsFontSize, 'A'), 14);
+
+    BOOST_CHECK_THROW(metrics.load(TextFont::Words, font.data(), 40), dom::InvalidDataError);
+    BOOST_CHECK_THROW(metrics.loadFile(TextFont::Words, "missing.ttf"), dom::InvalidDataError);
+    BOOST_CHECK(!metrics.loaded(TextFont::Words));
+}
+
+BOOST_AUTO_TEST_CASE(lyricWidthWithFontMetrics) {
+    const auto font = buildFont();
+    auto metrics = std::make_shared<TrueTypeFontMetrics>();
+    metrics->load(TextFont::Lyrics, font.data(), font.size());
+
+    dom::Lyric lyric;
+    lyric.setText(" A\xE6\xAD\x8C ");
+    const auto builtinWidth = LyricGeometry::width(lyric);
+
+    GlyphAdvanceCache::shared().setMetrics(metrics);
+    const auto width = LyricGeometry::width(lyric);
+    GlyphAdvanceCache::shared().setMetrics(std::make_shared<BuiltinFontMetrics>());
+
+    BOOST_CHECK_EQUAL(builtinWidth, 13 + 21 + 2);
+    BOOST_CHECK_CLOSE(width, 12.6 + 21 + 2, 0.001);
+    BOOST_CHECK_EQUAL(LyricGeometry::widths({&lyric, &lyric}).size(), 2);
+}
@@ -5,6 +5,8 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include <mxml/geometry/Geometry.h>
+#include <mxml/geometry/ScrollScoreGeometry.h>
+#include <mxml/ScoreBuilder.h>
 #include <mxml/StreamOperators.h>
 #include <boost/test/unit_test.hpp>
 
@@ -170,3 +172,37 @@ BOOST_AUTO_TEST_CASE(convertPointToGeometrySibling) {
     Point result = child1->convertToGeometry({0, 0}, child2);
     BOOST_CHECK_EQUAL(result, Point(-90, 0));
 }
+
+BOOST_AUTO_TEST_CASE(scrollScoreConcurrentParts) {
+    ScoreBuilder builder;
+    for (int p = 0; p < 3; p += 1) {
+        auto part = builder.addPart();
+        for (int m = 0; m < 4; m += 1) {
+            auto measure = builder.addMeasure(part);
+            if (m == 0) {
+                auto attributes = builder.addAttributes(measure);
+                builder.setTime(attributes);
+                builder.setTrebleClef(attributes);
+            }
+            for (int n = 0; n < 4; n += 1) {
+                auto note = builder.addNote(measure, dom::Note::Type::Quarter, n, 1);
+                builder.setPitch(note, dom::Pitch::Step::C, 4 + p);
+            }
+        }
+    }
+    auto score = builder.build();
+
+    ScrollScoreGeometry serial(*score, true, 1);
+    ScrollScoreGeometry concurrent(*score, true, 3);
+
+    BOOST_REQUIRE_EQUAL(serial.partGeometries().size(), 3);
+    BOOST_REQUIRE_EQUAL(concurrent.partGeometries().size(), 3);
+    for (std::size_t i = 0; i < 3; i += 1) {
+        auto serialPart = serial.partGeometries()[i];
+        auto concurrentPart = concurrent.partGeometries()[i];
+        BOOST_CHECK_EQUAL(serialPart->frame(), concurrentPart->frame());
+        BOOST_CHECK_EQUAL(serialPart->geometries().size(), concurrentPart->geometries().size());
+    }
+    BOOST_CHECK(serial.partGeometries()[0]->frame().origin.y < serial.partGeometries()[1]->frame().origin.y);
+    BOOST_CHECK_EQUAL(serial.frame(), concurrent.frame());
+}
@@ -8,6 +8,7 @@
 #include <mxml/EventFactory.h>
 #include <mxml/JumpFactory.h>
 #include <mxml/LoopFactory.h>
+#include <mxml/ScoreBuilder.h>
 #include <mxml/parsing/ScoreHandler.h>
 
 #include <boost/test/unit_test.hpp>
@@ -66,3 +67,31 @@ BOOST_AUTO_TEST_CASE(repeats) {
     BOOST_CHECK_EQUAL(jumps[1].from, 5);
     BOOST_CHECK_EQUAL(jumps[1].to, 0);
 }
+
+BOOST_AUTO_TEST_CASE(measureNumberIndex) {
+    ScoreBuilder builder;
+    auto part1 = builder.addPart();
+    auto part2 = builder.addPart();
+    for (auto& number : {"0", "1", "2", "2", "X1"}) {
+        builder.addMeasure(part1)->setNumber(number);
+        builder.addMeasure(part2)->setNumber(number);
+    }
+    builder.addMeasure(part2)->setNumber("coda");
+    auto score = builder.build();
+
+    auto& part = *score->parts().front();
+    BOOST_CHECK_EQUAL(part.measureWithNumber("1"), part.measures()[1].get());
+    BOOST_CHECK_EQUAL(part.measureWithNumber("2"), part.measures()[2].get());
+    BOOST_CHECK_EQUAL(part.measureWithNumber("X1"), part.measures()[4].get());
+    BOOST_CHECK(part.measureWithNumber("7") == nullptr);
+
+    BOOST_CHECK_EQUAL(score->measureIndex("0"), 0);
+    BOOST_CHECK_EQUAL(score->measureIndex("2"), 2);
+    BOOST_CHECK_EQUAL(score->measureIndex("coda"), 5);
+    BOOST_CHECK_EQUAL(score->measureIndex("7"), dom::Score::kNoMeasure);
+    BOOST_CHECK_EQUAL(score->measureWithNumber(1, "coda"), score->parts()[1]->measures()[5].get());
+
+    // Adding a measure discards the index
+    builder.addMeasure(part1)->setNumber("7");
+    BOOST_CHECK_EQUAL(part.measureWithNumber("7"), part.measures()[5].get());
+}
@@ -0,0 +1,119 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/geometry/LyricConnectorGeometry.h>
+#include <mxml/geometry/ScrollScoreGeometry.h>
+#include <mxml/geometry/WordsGeometry.h>
+#include <mxml/geometry/factories/LyricGeometryFactory.h>
+#include <mxml/ScoreBuilder.h>
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+using namespace mxml;
+
+namespace {
+
+std::unique_ptr<dom::Score> buildScore() {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+    auto measure = builder.addMeasure(part);
+    auto attributes = builder.addAttributes(measure);
+    builder.setTime(attributes);
+    builder.setTrebleClef(attributes);
+
+    std::vector<dom::Note*> notes;
+    for (int n = 0; n < 4; n += 1) {
+        auto note = builder.addNote(measure, dom::Note::Type::Eighth, n, 1);
+        builder.setPitch(note, dom::Pitch::Step::C, 5);
+        notes.push_back(note);
+    }
+
+    // The first verse is a single word, the second one has syllables that are too wide for their notes
+    builder.addLyric(notes[0], "Hal", dom::Syllabic::Type::Begin);
+    builder.addLyric(notes[1], "le", dom::Syllabic::Type::Middle);
+    builder.addLyric(notes[2], "lu", dom::Syllabic::Type::Middle);
+    builder.addLyric(notes[3], "jah", dom::Syllabic::Type::End);
+
+    builder.addLyric(notes[0], "Wonderful", dom::Syllabic::Type::Single, 2);
+    auto held = builder.addLyric(notes[1], "day", dom::Syllabic::Type::Single, 2);
+    held->setExtend(std::unique_ptr<dom::StartStopContinue>(new dom::StartStopContinue(dom::kStart)));
+
+    return builder.build();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(lyricLines) {
+    auto score = buildScore();
+    ScrollScoreGeometry geometry(*score);
+    BOOST_REQUIRE_EQUAL(geometry.partGeometries().size(), 1);
+
+    std::vector<const LyricGeometry*> verses[2];
+    std::vector<const LyricConnectorGeometry*> hyphens;
+    std::vector<const LyricConnectorGeometry*> extenders;
+    for (auto geom : geometry.partGeometries().front()->directionGeometries()) {
+        if (auto lyric = dynamic_cast<const LyricGeometry*>(geom)) {
+            verses[lyric->lyric().number() - 1].push_back(lyric);
+        } else if (auto connector = dynamic_cast<const LyricConnectorGeometry*>(geom)) {
+            if (connector->type() == LyricConnectorGeometry::Type::Hyphen)
+                hyphens.push_back(connector);
+            else
+                extenders.push_back(connector);
+        }
+    }
+    BOOST_REQUIRE_EQUAL(verses[0].size(), 4);
+    BOOST_REQUIRE_EQUAL(verses[1].size(), 2);
+
+    // Syllables of a verse don't overlap and a hyphen fits between the syllables of a word
+    BOOST_REQUIRE_EQUAL(hyphens.size(), 3);
+    for (std::size_t i = 0; i < 3; i += 1) {
+        BOOST_CHECK_LE(verses[0][i]->frame().max().x, hyphens[i]->frame().min().x);
+        BOOST_CHECK_LE(hyphens[i]->frame().max().x, verses[0][i + 1]->frame().min().x);
+        BOOST_CHECK(&hyphens[i]->lyricGeometry() == verses[0][i]);
+    }
+    BOOST_CHECK_LE(verses[1][0]->frame().max().x + LyricGeometryFactory::kWordSpacing, verses[1][1]->frame().min().x);
+
+    // The held syllable extends under the last note
+    BOOST_REQUIRE_EQUAL(extenders.size(), 1);
+    BOOST_CHECK(&extenders[0]->lyricGeometry() == verses[1][1]);
+    BOOST_CHECK_GT(extenders[0]->frame().min().x, verses[1][1]->frame().max().x);
+    BOOST_CHECK_GT(extenders[0]->size().width, 0);
+}
+
+BOOST_AUTO_TEST_CASE(dynamicsAvoidLyrics) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+    auto measure = builder.addMeasure(part);
+    auto attributes = builder.addAttributes(measure);
+    builder.setTime(attributes);
+    builder.setTrebleClef(attributes);
+    builder.addDynamics(measure, "ff");
+
+    auto note = builder.addNote(measure, dom::Note::Type::Quarter, 0, 1);
+    builder.setPitch(note, dom::Pitch::Step::C, 5);
+    builder.addLyric(note, "Sing");
+
+    auto score = builder.build();
+    ScrollScoreGeometry geometry(*score);
+    BOOST_REQUIRE_EQUAL(geometry.partGeometries().size(), 1);
+
+    const LyricGeometry* lyric = nullptr;
+    const WordsGeometry* dynamics = nullptr;
+    for (auto geom : geometry.partGeometries().front()->directionGeometries()) {
+        if (auto lyricGeom = dynamic_cast<const LyricGeometry*>(geom))
+            lyric = lyricGeom;
+        else if (auto wordsGeom = dynamic_cast<const WordsGeometry*>(geom))
+            dynamics = wordsGeom;
+    }
+    BOOST_REQUIRE(lyric);
+    BOOST_REQUIRE(dynamics);
+
+    // Both go below the staff at the start of the measure, the dynamics move out of the way of the lyric
+    BOOST_CHECK(dynamics->placement() == dom::Placement::Below);
+    BOOST_CHECK(!intersect(dynamics->frame(), lyric->frame()));
+    BOOST_CHECK_GT(dynamics->frame().min().y, lyric->frame().max().y);
+}
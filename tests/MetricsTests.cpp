@@ -4,6 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include <mxml/PageMetrics.h>
 #include <mxml/ScoreBuilder.h>
 #include <mxml/ScrollMetrics.h>
 
@@ -102,3 +103,45 @@ BOOST_AUTO_TEST_CASE(noteY) {
     note.pitch = std::unique_ptr<Pitch>(new Pitch(Pitch::Step::F, 0, 3));
     BOOST_CHECK_EQUAL(metrics.noteY(note), Metrics::staffHeight() + 65 + 10);
 }
+
+BOOST_AUTO_TEST_CASE(pageMetricsFromPrints) {
+    ScoreBuilder builder;
+    auto part1 = builder.addPart();
+    auto part2 = builder.addPart();
+    std::vector<Measure*> measures1;
+    std::vector<Measure*> measures2;
+    for (int i = 0; i < 3; i += 1) {
+        measures1.push_back(builder.addMeasure(part1));
+        measures2.push_back(builder.addMeasure(part2));
+    }
+
+    // Start a second system on measure 1, with different staff distances for each part
+    std::unique_ptr<Print> print1(new Print);
+    print1->newSystem = true;
+    SystemLayout systemLayout;
+    systemLayout.systemDistance = presentOptional(120.0f);
+    print1->systemLayout = presentOptional(systemLayout);
+    print1->staffDistances[2] = 90;
+    measures1[1]->addNode(std::move(print1));
+
+    std::unique_ptr<Print> print2(new Print);
+    print2->newSystem = true;
+    print2->staffDistances[2] = 70;
+    measures2[1]->addNode(std::move(print2));
+
+    auto score = builder.build();
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Page);
+    BOOST_REQUIRE_EQUAL(scoreProperties.systemCount(), 2);
+
+    PageMetrics first(*score, scoreProperties, 0, 0);
+    BOOST_CHECK_EQUAL(first.systemDistance(), 80);
+    BOOST_CHECK_EQUAL(first.staffDistance(), 65);
+
+    PageMetrics second1(*score, scoreProperties, 1, 0);
+    BOOST_CHECK_EQUAL(second1.systemDistance(), 120);
+    BOOST_CHECK_EQUAL(second1.staffDistance(), 90);
+
+    PageMetrics second2(*score, scoreProperties, 1, 1);
+    BOOST_CHECK_EQUAL(second2.systemDistance(), 80);
+    BOOST_CHECK_EQUAL(second2.staffDistance(), 70);
+}
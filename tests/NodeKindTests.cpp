@@ -0,0 +1,50 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/dom/NodeVisitor.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace mxml::dom;
+
+BOOST_AUTO_TEST_CASE(nodeKinds) {
+    Note note;
+    Chord chord;
+    Wedge wedge;
+    Print print;
+
+    BOOST_CHECK(note.kind() == Node::Kind::Note);
+    BOOST_CHECK(nodeCast<Note>(&note) == &note);
+    BOOST_CHECK(nodeCast<TimedNode>(&note) == &note);
+    BOOST_CHECK(nodeCast<Chord>(&note) == nullptr);
+    BOOST_CHECK(nodeCast<TimedNode>(&chord) == &chord);
+    BOOST_CHECK(nodeCast<DirectionType>(&chord) == nullptr);
+    BOOST_CHECK(nodeCast<DirectionType>(&wedge) == &wedge);
+    BOOST_CHECK(nodeCast<TimedNode>(&wedge) == nullptr);
+    BOOST_CHECK(nodeCast<Print>(&print) == &print);
+    BOOST_CHECK(nodeCast<Note>(static_cast<const Node*>(nullptr)) == nullptr);
+
+    Key key;
+    Key copy(key);
+    BOOST_CHECK(copy.kind() == Node::Kind::Key);
+}
+
+BOOST_AUTO_TEST_CASE(nodeVisit) {
+    struct Visitor {
+        std::string visited;
+
+        void operator()(const Note&) { visited += "note "; }
+        void operator()(const TimedNode&) { visited += "timed "; }
+        void operator()(const DirectionType&) { visited += "direction-type "; }
+        void operator()(const Node&) { visited += "node "; }
+    };
+
+    Visitor visitor;
+    visit(Note(), visitor);
+    visit(Backup(), visitor);
+    visit(Dynamics(), visitor);
+    visit(Barline(), visitor);
+    BOOST_CHECK_EQUAL(visitor.visited, "note timed direction-type node ");
+}
@@ -52,3 +52,64 @@ BOOST_AUTO_TEST_CASE(midiNumberE4Flat) {
     Note note = createNote(4, Pitch::Step::E, -1);
     BOOST_CHECK_EQUAL(note.midiNumber(), 63);
 }
+
+BOOST_AUTO_TEST_CASE(compactNoteDefaults) {
+    Note note;
+    BOOST_CHECK(note.pitch == nullptr);
+    BOOST_CHECK(!note.pitch);
+    BOOST_CHECK(note.rest == nullptr);
+    BOOST_CHECK(note.notations == nullptr);
+    BOOST_CHECK(note.beams().empty());
+    BOOST_CHECK(note.lyrics().empty());
+    BOOST_CHECK(!note.dynamics().isPresent());
+    BOOST_CHECK_EQUAL(note.voice(), "");
+    BOOST_CHECK_EQUAL(note.midiNumber(), 0);
+
+    // The pitch is copied into the note
+    std::unique_ptr<Pitch> pitch(new Pitch(Pitch::Step::G, 1, 3));
+    pitch->setParent(&note);
+    note.pitch = std::move(pitch);
+    BOOST_REQUIRE(note.pitch);
+    BOOST_CHECK(note.pitch.get() != nullptr);
+    BOOST_CHECK(note.pitch->parent() == &note);
+    BOOST_CHECK_EQUAL(note.alter(), 1);
+    BOOST_CHECK_EQUAL(note.midiNumber(), 56);
+
+    note.pitch.reset();
+    BOOST_CHECK(note.pitch == nullptr);
+    BOOST_CHECK(note.pitch.get() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(compactNoteVoiceInterning) {
+    VoiceTable voices;
+    Note first;
+    Note second;
+    first.setVoice(std::string("1"), voices);
+    second.setVoice(std::string("1"), voices);
+    BOOST_CHECK_EQUAL(first.voice(), "1");
+    BOOST_CHECK(&first.voice() == &second.voice());
+    BOOST_CHECK_EQUAL(voices.size(), 1);
+
+    second.setVoice("2", voices);
+    BOOST_CHECK_EQUAL(second.voice(), "2");
+    BOOST_CHECK_EQUAL(first.voice(), "1");
+
+    // Without a table the note keeps its own copy
+    Note third;
+    third.setVoice("1");
+    BOOST_CHECK_EQUAL(third.voice(), "1");
+    BOOST_CHECK(&third.voice() != &first.voice());
+    BOOST_CHECK_EQUAL(voices.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(compactNoteBeams) {
+    Note note;
+    for (int number = 1; number <= 10; number += 1)
+        note.addBeam(Beam(number, number == 1 ? Beam::Type::Begin : Beam::Type::ForwardHook));
+
+    BOOST_REQUIRE_EQUAL(note.beams().size(), BeamList::kMaxBeams);
+    BOOST_CHECK(note.beams().front().type() == Beam::Type::Begin);
+    BOOST_CHECK_EQUAL(note.beams().front().number(), 1);
+    BOOST_CHECK(note.beams().back().type() == Beam::Type::ForwardHook);
+    BOOST_CHECK_EQUAL(note.beams().back().number(), 8);
+}
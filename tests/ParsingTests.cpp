@@ -5,8 +5,18 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include <lxml/lxml.h>
+#include <mxml/parsing/GenericNodeHandler.h>
+#include <mxml/parsing/NoteHandler.h>
+#include <mxml/parsing/ParserContext.h>
+#include <mxml/parsing/PrintHandler.h>
 #include <mxml/parsing/ScoreHandler.h>
+#include <mxml/parsing/StringView.h>
+#include <mxml/parsing/TypeFactories.h>
+#include <mxml/dom/InvalidDataError.h>
+#include <mxml/dom/Print.h>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
 #include <boost/test/unit_test.hpp>
 
 
@@ -94,4 +104,273 @@ BOOST_AUTO_TEST_CASE(parseMusicXML) {
     BOOST_CHECK(note.stem() == dom::Stem::Down);
     BOOST_CHECK_EQUAL(note.staff(), 1);
     BOOST_CHECK(note.dot);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(stringViewConversions) {
+    // Views into a buffer are not null-terminated
+    const char buffer[] = "quarter-12 -3.5 sharp-sharp";
+    StringView type(buffer, 7);
+    StringView integer(buffer + 7, 3);
+    StringView number(buffer + 10, 5);
+    StringView accidental(buffer + 16, 11);
+
+    BOOST_CHECK(type == "quarter");
+    BOOST_CHECK(NoteHandler::typeFromString(type) == dom::Note::Type::Quarter);
+    BOOST_CHECK_EQUAL(parseInteger(integer), -12);
+    BOOST_CHECK_CLOSE(parseDouble(number), -3.5, 0.0001);
+    BOOST_CHECK_EQUAL(Factory::tenthsValue(number), -3.5f);
+    BOOST_CHECK_EQUAL(NoteHandler::accidentalTypeFromString(accidental).alter, 2);
+    BOOST_CHECK_EQUAL(NoteHandler::accidentalTypeFromString(accidental.substr(0, 5)).alter, 1);
+    BOOST_CHECK_THROW(NoteHandler::typeFromString(StringView(buffer, 6)), dom::InvalidDataError);
+
+    BOOST_CHECK(StringView(" \n up\t").trimmed() == "up");
+    BOOST_CHECK(NoteHandler::stemFromString(StringView(" \n up\t").trimmed()) == dom::Stem::Up);
+    BOOST_CHECK_EQUAL(parseInteger(" 42 "), 42);
+    BOOST_CHECK_EQUAL(parseInteger(""), 0);
+
+    // Out of range values are clamped instead of wrapping around
+    BOOST_CHECK_EQUAL(parseInteger("2147483647"), std::numeric_limits<int>::max());
+    BOOST_CHECK_EQUAL(parseInteger("-2147483648"), std::numeric_limits<int>::min());
+    BOOST_CHECK_EQUAL(parseInteger("2147483648"), std::numeric_limits<int>::max());
+    BOOST_CHECK_EQUAL(parseInteger("-99999999999999999999999"), std::numeric_limits<int>::min());
+    BOOST_CHECK_EQUAL(parseInteger("4294967297"), std::numeric_limits<int>::max());
+}
+
+namespace {
+
+const char kProfileMusicXML[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<score-partwise>\n"
+    "  <identification>\n"
+    "    <creator type=\"composer\">Composer</creator>\n"
+    "  </identification>\n"
+    "  <credit page=\"1\">\n"
+    "    <credit-words>Title</credit-words>\n"
+    "  </credit>\n"
+    "  <part-list>\n"
+    "    <score-part id=\"P1\">\n"
+    "      <part-name>Voice</part-name>\n"
+    "    </score-part>\n"
+    "  </part-list>\n"
+    "  <part id=\"P1\">\n"
+    "    <measure number=\"1\">\n"
+    "      <print new-system=\"yes\"/>\n"
+    "      <attributes>\n"
+    "        <divisions>1</divisions>\n"
+    "        <time>\n"
+    "          <beats>1</beats>\n"
+    "          <beat-type>4</beat-type>\n"
+    "        </time>\n"
+    "      </attributes>\n"
+    "      <note>\n"
+    "        <pitch><step>C</step><octave>4</octave></pitch>\n"
+    "        <duration>1</duration>\n"
+    "        <type>quarter</type>\n"
+    "        <lyric number=\"1\"><syllabic>single</syllabic><text>la</text></lyric>\n"
+    "      </note>\n"
+    "    </measure>\n"
+    "    <measure number=\"2\">\n"
+    "      <note>\n"
+    "        <pitch><step>D</step><octave>4</octave></pitch>\n"
+    "        <duration>1</duration>\n"
+    "        <type>quarter</type>\n"
+    "      </note>\n"
+    "    </measure>\n"
+    "    <measure number=\"3\">\n"
+    "      <note>\n"
+    "        <pitch><step>E</step><octave>4</octave></pitch>\n"
+    "        <duration>1</duration>\n"
+    "        <type>quarter</type>\n"
+    "      </note>\n"
+    "    </measure>\n"
+    "  </part>\n"
+    "</score-partwise>\n";
+
+std::unique_ptr<dom::Score> parseWithProfile(const ParseProfile& profile) {
+    ScoreHandler handler(profile);
+    std::istringstream is(kProfileMusicXML);
+    lxml::parse(is, "profile.xml", handler);
+    return handler.result();
+}
+
+const dom::Note& firstNote(const dom::Measure& measure) {
+    for (auto& node : measure.nodes()) {
+        if (auto chord = dynamic_cast<const dom::Chord*>(node.get()))
+            return *chord->notes().front();
+    }
+    throw std::runtime_error("No notes in measure");
+}
+
+bool hasPrint(const dom::Measure& measure) {
+    for (auto& node : measure.nodes()) {
+        if (dynamic_cast<const dom::Print*>(node.get()))
+            return true;
+    }
+    return false;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(parseProfileFull) {
+    auto score = parseWithProfile(ParseProfile::full());
+    BOOST_CHECK(score->identification());
+    BOOST_CHECK_EQUAL(score->credits().size(), 1);
+    BOOST_REQUIRE_EQUAL(score->parts().size(), 1);
+
+    auto& part = *score->parts().front();
+    BOOST_REQUIRE_EQUAL(part.measures().size(), 3);
+    BOOST_CHECK(hasPrint(*part.measures().front()));
+    BOOST_CHECK_EQUAL(firstNote(*part.measures().front()).lyrics().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(parseProfileMetadata) {
+    auto score = parseWithProfile(ParseProfile::metadata());
+    BOOST_CHECK(score->identification());
+    BOOST_CHECK_EQUAL(score->credits().size(), 1);
+    BOOST_CHECK_EQUAL(score->parts().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(parseProfilePlayback) {
+    auto score = parseWithProfile(ParseProfile::playback());
+    BOOST_CHECK_EQUAL(score->credits().size(), 0);
+    BOOST_REQUIRE_EQUAL(score->parts().size(), 1);
+
+    auto& part = *score->parts().front();
+    BOOST_REQUIRE_EQUAL(part.measures().size(), 3);
+    BOOST_CHECK(!hasPrint(*part.measures().front()));
+
+    auto& note = firstNote(*part.measures().front());
+    BOOST_CHECK_EQUAL(note.lyrics().size(), 0);
+    BOOST_CHECK(note.pitch);
+    BOOST_CHECK_EQUAL(note.duration(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(parseProfileMeasureLimit) {
+    auto score = parseWithProfile(ParseProfile::thumbnail(2));
+    BOOST_REQUIRE_EQUAL(score->parts().size(), 1);
+
+    auto& part = *score->parts().front();
+    BOOST_REQUIRE_EQUAL(part.measures().size(), 2);
+    BOOST_CHECK_EQUAL(part.measures().back()->number(), "2");
+    BOOST_CHECK(firstNote(*part.measures().back()).pitch->step() == dom::Pitch::Step::D);
+}
+
+BOOST_AUTO_TEST_CASE(genericNodeTree) {
+    const char xml[] =
+        "<staff-details number=\"2\" print-object=\"no\">\n"
+        "  <staff-lines> 5 </staff-lines>\n"
+        "  <staff-tuning line=\"1\"><tuning-step>E</tuning-step></staff-tuning>\n"
+        "  <staff-tuning line=\"2\"><tuning-step>A</tuning-step></staff-tuning>\n"
+        "</staff-details>\n";
+
+    GenericNodeHandler handler;
+    for (int pass = 0; pass < 2; pass += 1) {
+        std::istringstream is(xml);
+        lxml::parse(is, "staff-details", handler);
+
+        auto node = handler.result();
+        BOOST_REQUIRE(node);
+        BOOST_CHECK(node->name() == "staff-details");
+        BOOST_CHECK(node->parent() == nullptr);
+        BOOST_CHECK(node->attribute("number").value() == "2");
+        BOOST_CHECK(!PrintObjectFactory::buildFromGenericNode(*node));
+        BOOST_CHECK(!node->hasAttribute("line"));
+        BOOST_CHECK(!node->hasAttribute("unknown"));
+        BOOST_CHECK_EQUAL(node->childCount(), 3);
+
+        auto lines = node->child("staff-lines");
+        BOOST_REQUIRE(lines);
+        BOOST_CHECK(lines->text() == "5");
+        BOOST_CHECK(lines->parent() == node);
+
+        auto tuning = node->child("staff-tuning");
+        BOOST_REQUIRE(tuning);
+        BOOST_CHECK(tuning->attribute("line").value() == "1");
+        BOOST_REQUIRE(tuning->nextSibling());
+        BOOST_CHECK(tuning->nextSibling()->child("tuning-step")->text() == "A");
+        BOOST_CHECK(tuning->nextSibling()->nextSibling() == nullptr);
+
+        // The tree is reused between elements
+        BOOST_CHECK_EQUAL(handler.tree().size(), 6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(printPartNameDisplay) {
+    const char xml[] =
+        "<print>\n"
+        "  <measure-layout><measure-distance>120</measure-distance></measure-layout>\n"
+        "  <part-name-display>\n"
+        "    <display-text justify=\"center\" default-x=\"-10\">Flute</display-text>\n"
+        "  </part-name-display>\n"
+        "</print>\n";
+
+    PrintHandler handler;
+    std::istringstream is(xml);
+    lxml::parse(is, "print", handler);
+
+    auto print = handler.result();
+    BOOST_REQUIRE(print);
+    BOOST_CHECK(print->measureDistance.isPresent());
+    BOOST_CHECK_EQUAL(print->measureDistance.value(), 120);
+    BOOST_REQUIRE(print->partNameDisplay.isPresent());
+
+    auto& display = print->partNameDisplay.value();
+    BOOST_CHECK_EQUAL(display.string, "Flute");
+    BOOST_CHECK(display.justify == dom::Justify::Center);
+    BOOST_CHECK(display.position.defaultX.isPresent());
+    BOOST_CHECK_EQUAL(display.position.defaultX.value(), -10);
+}
+
+BOOST_AUTO_TEST_CASE(parserContextReuse) {
+    ParserContext context;
+    for (int pass = 0; pass < 3; pass += 1) {
+        auto score = context.parse(StringView(kProfileMusicXML), "profile.xml");
+        BOOST_REQUIRE(score);
+        BOOST_REQUIRE_EQUAL(score->parts().size(), 1);
+        BOOST_CHECK_EQUAL(score->parts().front()->measures().size(), 3);
+        BOOST_CHECK(hasPrint(*score->parts().front()->measures().front()));
+    }
+    BOOST_CHECK_EQUAL(context.documentCount(), 3);
+
+    auto score = context.parseFile("moonlight.xml");
+    BOOST_REQUIRE(score);
+    BOOST_CHECK_EQUAL(score->parts().size(), 1);
+    BOOST_CHECK_EQUAL(context.documentCount(), 4);
+
+    context.setProfile(ParseProfile::thumbnail(1));
+    score = context.parse(StringView(kProfileMusicXML), "profile.xml");
+    BOOST_CHECK_EQUAL(score->parts().front()->measures().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(parsedVoicesPerScore) {
+    ParserContext context;
+    auto first = context.parseFile("moonlight.xml");
+    auto second = context.parseFile("moonlight.xml");
+    BOOST_CHECK_EQUAL(first->voices().size(), 8);
+
+    // Notes in the same voice share their score's copy of the name, scores don't share names
+    auto& measure = *first->parts().front()->measures().front();
+    auto& note = firstNote(measure);
+    BOOST_CHECK_EQUAL(note.voice(), "1");
+    BOOST_CHECK(&note.voice() == &first->voices().intern("1"));
+    BOOST_CHECK(&firstNote(*second->parts().front()->measures().front()).voice() != &note.voice());
+
+    first.reset();
+    BOOST_CHECK_EQUAL(firstNote(*second->parts().front()->measures().front()).voice(), "1");
+}
+
+BOOST_AUTO_TEST_CASE(parserContextRecovers) {
+    std::string invalid = kProfileMusicXML;
+    invalid.replace(invalid.find("<step>D</step>"), 14, "<step>X</step>");
+
+    ParserContext context(ParseProfile::playback());
+    BOOST_CHECK_THROW(context.parse(StringView(invalid), "invalid.xml"), dom::InvalidDataError);
+    BOOST_CHECK_EQUAL(context.documentCount(), 0);
+
+    context.reset();
+    BOOST_CHECK_EQUAL(context.profile().prints, false);
+    auto score = context.parse(StringView(kProfileMusicXML), "profile.xml");
+    BOOST_REQUIRE(score);
+    BOOST_CHECK_EQUAL(score->parts().front()->measures().size(), 3);
+    BOOST_CHECK_EQUAL(context.documentCount(), 1);
+}
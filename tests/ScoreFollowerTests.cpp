@@ -0,0 +1,134 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <lxml/lxml.h>
+#include <mxml/parsing/ScoreHandler.h>
+#include <mxml/EventFactory.h>
+#include <mxml/ScoreFollower.h>
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <fstream>
+#include <random>
+
+using namespace mxml;
+using namespace mxml::parsing;
+
+static const char* kMoonlightFileName = "moonlight.xml";
+static const double kFrameDuration = 0.01;
+
+namespace {
+
+struct Frame {
+    double pitch;
+    std::size_t state;
+};
+
+/**
+ Generate a top-pitch stream for the given follower, played `stretch` times slower than written, with octave errors and
+ dropouts.
+ */
+std::vector<Frame> synthesizeFrames(const ScoreFollower& follower, double stretch, double errorRate) {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::normal_distribution<double> jitter(0, 0.1);
+
+    std::vector<Frame> frames;
+    for (std::size_t state = 0; state < follower.stateCount(); state += 1) {
+        auto& event = follower.event(state);
+        double duration = event.wallTimeDuration();
+        if (state + 1 < follower.stateCount())
+            duration = follower.event(state + 1).wallTime() - event.wallTime();
+
+        const auto count = static_cast<std::size_t>(std::round(stretch * duration / kFrameDuration));
+        const auto pitch = follower.topPitch(state);
+        for (std::size_t i = 0; i < count; i += 1) {
+            Frame frame{pitch, state};
+            if (pitch >= 0) {
+                const auto r = uniform(generator);
+                if (r < errorRate / 2)
+                    frame.pitch = ScoreFollower::kNoPitch;
+                else if (r < errorRate)
+                    frame.pitch = pitch + 12;
+                else
+                    frame.pitch = pitch + jitter(generator);
+            }
+            frames.push_back(frame);
+        }
+    }
+    return frames;
+}
+
+void checkFollowing(ScoreFollower& tracker, const std::vector<Frame>& frames) {
+    std::size_t tracked = 0;
+    for (auto& frame : frames) {
+        const auto position = tracker.update(frame.pitch);
+        const auto difference = position > frame.state ? position - frame.state : frame.state - position;
+        if (difference <= 2)
+            tracked += 1;
+    }
+
+    BOOST_CHECK_GT(tracked, frames.size() * 9 / 10);
+    BOOST_CHECK_GE(tracker.position() + 2, tracker.stateCount() - 1);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(scoreFollowerMoonlight) {
+    ScoreHandler handler;
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+    EventFactory factory(score, scoreProperties);
+    auto events = factory.build();
+
+    ScoreFollower follower(*events, kFrameDuration);
+    BOOST_REQUIRE_GT(follower.stateCount(), 10);
+    BOOST_CHECK_EQUAL(follower.position(), 0);
+
+    auto frames = synthesizeFrames(follower, 1.0, 0.0);
+    checkFollowing(follower, frames);
+}
+
+BOOST_AUTO_TEST_CASE(scoreFollowerNoisy) {
+    ScoreHandler handler;
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+    EventFactory factory(score, scoreProperties);
+    auto events = factory.build();
+
+    ScoreFollower follower(*events, kFrameDuration);
+    auto frames = synthesizeFrames(follower, 1.3, 0.2);
+    checkFollowing(follower, frames);
+
+    // Following again after a reset gives the same result
+    follower.reset();
+    BOOST_CHECK_EQUAL(follower.position(), 0);
+    checkFollowing(follower, frames);
+}
+
+BOOST_AUTO_TEST_CASE(scoreFollowerStateForEvent) {
+    ScoreHandler handler;
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+    EventFactory factory(score, scoreProperties);
+    auto events = factory.build();
+
+    ScoreFollower follower(*events, kFrameDuration);
+    for (std::size_t state = 0; state < follower.stateCount(); state += 1) {
+        auto& event = follower.event(state);
+        const auto eventIndex = static_cast<std::size_t>(&event - events->events().data());
+        BOOST_CHECK_EQUAL(follower.stateForEvent(eventIndex), state);
+    }
+}
@@ -0,0 +1,205 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <lxml/lxml.h>
+#include <mxml/parsing/ScoreHandler.h>
+#include <mxml/parsing/ScoreProbe.h>
+#include <mxml/dom/Attributes.h>
+#include <mxml/dom/InvalidDataError.h>
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace mxml;
+using namespace mxml::parsing;
+
+namespace {
+
+const dom::Attributes* firstAttributes(const dom::Score& score) {
+    auto& measure = score.parts().front()->measures().front();
+    for (auto& node : measure->nodes()) {
+        if (auto attributes = dynamic_cast<const dom::Attributes*>(node.get()))
+            return attributes;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(scoreProbeMatchesFullParse) {
+    const char* fileNames[] = {"moonlight.xml", "events.xml", "events_repeat.xml", "events_complex_1.xml", "loops.xml"};
+    for (auto fileName : fileNames) {
+        BOOST_TEST_MESSAGE(fileName);
+
+        std::ifstream probeStream(fileName);
+        const auto summary = ScoreProbe::probe(probeStream);
+
+        ScoreHandler handler;
+        std::ifstream is(fileName);
+        lxml::parse(is, fileName, handler);
+        const auto& score = *handler.result();
+
+        BOOST_REQUIRE_EQUAL(summary.parts.size(), score.parts().size());
+        std::size_t measureCount = 0;
+        for (std::size_t i = 0; i < summary.parts.size(); i += 1) {
+            BOOST_CHECK_EQUAL(summary.parts[i].id, score.parts()[i]->id());
+            BOOST_CHECK_EQUAL(summary.parts[i].measureCount, score.parts()[i]->measures().size());
+            measureCount = std::max(measureCount, score.parts()[i]->measures().size());
+        }
+        BOOST_CHECK_EQUAL(summary.measureCount, measureCount);
+
+        auto attributes = firstAttributes(score);
+        BOOST_REQUIRE(attributes);
+        BOOST_CHECK_EQUAL(summary.divisions, attributes->divisions().value());
+        BOOST_CHECK_EQUAL(summary.hasKey, attributes->key(1) != nullptr);
+        if (summary.hasKey) {
+            BOOST_CHECK_EQUAL(summary.fifths, attributes->key(1)->fifths());
+            BOOST_CHECK(summary.mode == attributes->key(1)->mode());
+        }
+        BOOST_CHECK_EQUAL(summary.hasTime, attributes->time() != nullptr);
+        if (summary.hasTime) {
+            BOOST_CHECK_EQUAL(summary.beats, attributes->time()->beats());
+            BOOST_CHECK_EQUAL(summary.beatType, attributes->time()->beatType());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(scoreProbeMetadata) {
+    const char musicXML[] =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<!DOCTYPE score-partwise PUBLIC \"-//Recordare//DTD MusicXML 3.0 Partwise//EN\" \"http://www.musicxml.org/dtds/partwise.dtd\">\n"
+        "<score-partwise version=\"3.0\">\n"
+        "  <work><work-title>Sonata &amp; Fugue</work-title></work>\n"
+        "  <movement-title>Allegro</movement-title>\n"
+        "  <!-- <part id=\"P9\"><measure/></part> -->\n"
+        "  <identification>\n"
+        "    <creator type='lyricist'>Someone</creator>\n"
+        "    <creator type=\"composer\">J. S. Bach</creator>\n"
+        "  </identification>\n"
+        "  <part-list>\n"
+        "    <score-part id=\"P1\"><part-name>Violin</part-name></score-part>\n"
+        "    <score-part id=\"P2\"><part-name>Cello</part-name></score-part>\n"
+        "  </part-list>\n"
+        "  <part id=\"P1\">\n"
+        "    <measure number=\"1\">\n"
+        "      <attributes>\n"
+        "        <divisions>4</divisions>\n"
+        "        <key><fifths>-3</fifths><mode>minor</mode></key>\n"
+        "        <time><beats>6</beats><beat-type>8</beat-type></time>\n"
+        "      </attributes>\n"
+        "    </measure>\n"
+        "    <measure number=\"2\"><attributes><divisions>8</divisions></attributes></measure>\n"
+        "    <measure number=\"3\"/>\n"
+        "  </part>\n"
+        "  <part id=\"P2\">\n"
+        "    <measure number=\"1\"><![CDATA[<measure>]]></measure>\n"
+        "  </part>\n"
+        "</score-partwise>\n";
+
+    const auto summary = ScoreProbe::probe(StringView(musicXML));
+    BOOST_CHECK_EQUAL(summary.workTitle, "Sonata & Fugue");
+    BOOST_CHECK_EQUAL(summary.movementTitle, "Allegro");
+    BOOST_CHECK_EQUAL(summary.composer, "J. S. Bach");
+
+    BOOST_REQUIRE_EQUAL(summary.parts.size(), 2);
+    BOOST_CHECK_EQUAL(summary.parts[0].id, "P1");
+    BOOST_CHECK_EQUAL(summary.parts[0].name, "Violin");
+    BOOST_CHECK_EQUAL(summary.parts[0].measureCount, 3);
+    BOOST_CHECK_EQUAL(summary.parts[1].id, "P2");
+    BOOST_CHECK_EQUAL(summary.parts[1].name, "Cello");
+    BOOST_CHECK_EQUAL(summary.parts[1].measureCount, 1);
+    BOOST_CHECK_EQUAL(summary.measureCount, 3);
+
+    BOOST_CHECK_EQUAL(summary.divisions, 4);
+    BOOST_CHECK(summary.hasKey);
+    BOOST_CHECK_EQUAL(summary.fifths, -3);
+    BOOST_CHECK(summary.mode == dom::Key::Mode::Minor);
+    BOOST_CHECK(summary.hasTime);
+    BOOST_CHECK_EQUAL(summary.beats, 6);
+    BOOST_CHECK_EQUAL(summary.beatType, 8);
+}
+
+BOOST_AUTO_TEST_CASE(scoreProbeTimewise) {
+    const char musicXML[] =
+        "<score-timewise>\n"
+        "  <part-list><score-part id=\"P1\"/><score-part id=\"P2\"/></part-list>\n"
+        "  <measure number=\"1\">\n"
+        "    <part id=\"P1\"><attributes><divisions>2</divisions></attributes></part>\n"
+        "    <part id=\"P2\"/>\n"
+        "  </measure>\n"
+        "  <measure number=\"2\"><part id=\"P1\"/></measure>\n"
+        "</score-timewise>\n";
+
+    const auto summary = ScoreProbe::probe(StringView(musicXML));
+    BOOST_REQUIRE_EQUAL(summary.parts.size(), 2);
+    BOOST_CHECK_EQUAL(summary.parts[0].measureCount, 2);
+    BOOST_CHECK_EQUAL(summary.parts[1].measureCount, 1);
+    BOOST_CHECK_EQUAL(summary.measureCount, 2);
+    BOOST_CHECK_EQUAL(summary.divisions, 2);
+    BOOST_CHECK(!summary.hasKey);
+    BOOST_CHECK(!summary.hasTime);
+}
+
+BOOST_AUTO_TEST_CASE(scoreProbeNotAScore) {
+    BOOST_CHECK_THROW(ScoreProbe::probe(StringView("<html><body/></html>")), dom::InvalidDataError);
+    BOOST_CHECK_THROW(ScoreProbe::probe(StringView("")), dom::InvalidDataError);
+}
+
+BOOST_AUTO_TEST_CASE(scoreProbeEncodings) {
+    const std::string musicXML =
+        "<?xml version=\"1.0\"?>\n"
+        "<score-partwise><movement-title>Pr\xC3\xA9lude \xF0\x9D\x84\x9E</movement-title>\n"
+        "  <part-list><score-part id=\"P1\"/></part-list>\n"
+        "  <part id=\"P1\"><measure/><measure/></part>\n"
+        "</score-partwise>\n";
+    const std::string expectedTitle = "Pr\xC3\xA9lude \xF0\x9D\x84\x9E";
+
+    // UTF-8 with a byte order mark
+    const auto bomSummary = ScoreProbe::probe(StringView("\xEF\xBB\xBF" + musicXML));
+    BOOST_CHECK_EQUAL(bomSummary.movementTitle, expectedTitle);
+    BOOST_CHECK_EQUAL(bomSummary.measureCount, 2);
+
+    // UTF-16 in both byte orders, with and without a byte order mark
+    std::u16string utf16 = u"<?xml version=\"1.0\" encoding=\"UTF-16\"?>\n"
+        u"<score-partwise><movement-title>Prélude \U0001D11E</movement-title>\n"
+        u"  <part-list><score-part id=\"P1\"/></part-list>\n"
+        u"  <part id=\"P1\"><measure/><measure/></part>\n"
+        u"</score-partwise>\n";
+    for (bool bigEndian : {false, true}) {
+        for (bool bom : {false, true}) {
+            std::string document;
+            if (bom)
+                document = bigEndian ? "\xFE\xFF" : "\xFF\xFE";
+            for (auto unit : utf16) {
+                const char high = static_cast<char>(unit >> 8);
+                const char low = static_cast<char>(unit & 0xFF);
+                document.push_back(bigEndian ? high : low);
+                document.push_back(bigEndian ? low : high);
+            }
+
+            const auto summary = ScoreProbe::probe(StringView(document));
+            BOOST_CHECK_EQUAL(summary.movementTitle, expectedTitle);
+            BOOST_REQUIRE_EQUAL(summary.parts.size(), 1);
+            BOOST_CHECK_EQUAL(summary.parts[0].measureCount, 2);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(scoreProbeSkipsCommentText) {
+    const char musicXML[] =
+        "<score-partwise>\n"
+        "  <work><work-title><!-- draft title -->Sonata</work-title></work>\n"
+        "  <movement-title><?editor note?> Allegro</movement-title>\n"
+        "  <part-list><score-part id=\"P1\"><part-name><!--a--><!--b-->Flute</part-name></score-part></part-list>\n"
+        "  <part id=\"P1\"><measure/></part>\n"
+        "</score-partwise>\n";
+
+    const auto summary = ScoreProbe::probe(StringView(musicXML));
+    BOOST_CHECK_EQUAL(summary.workTitle, "Sonata");
+    BOOST_CHECK_EQUAL(summary.movementTitle, "Allegro");
+    BOOST_REQUIRE_EQUAL(summary.parts.size(), 1);
+    BOOST_CHECK_EQUAL(summary.parts[0].name, "Flute");
+}
@@ -265,3 +265,101 @@ BOOST_AUTO_TEST_CASE(clefSignaturesOnlyFirstStaff) {
     BOOST_CHECK(proeprties.clef(0, 1, 1, 0)->sign() == dom::Clef::Sign::F);
     BOOST_CHECK(proeprties.clef(0, 1, 2, 0)->sign() == dom::Clef::Sign::F);
 }
+
+BOOST_AUTO_TEST_CASE(noteIndex) {
+    ScoreBuilder builder;
+    auto part1 = builder.addPart();
+    auto part2 = builder.addPart();
+
+    auto measure = builder.addMeasure(part1);
+    auto chord = builder.addChord(measure);
+    auto note1 = builder.addNote(chord, dom::Note::Type::Quarter, 0, 2);
+    auto note2 = builder.addNote(chord, dom::Note::Type::Quarter, 0, 2);
+    note2->setVoice("2");
+    builder.addMeasure(part1);
+    auto note3 = builder.addNote(builder.addMeasure(part1), dom::Note::Type::Half, 4, 3);
+    note3->setStaff(2);
+    auto note4 = builder.addNote(builder.addMeasure(part2));
+
+    auto score = builder.build();
+    ScoreProperties properties(*score, ScoreProperties::LayoutType::Scroll);
+    auto& index = properties.noteIndex();
+
+    BOOST_REQUIRE_EQUAL(index.size(), 4);
+    BOOST_CHECK_EQUAL(index.notes()[0], note1);
+    BOOST_CHECK_EQUAL(index.notes()[1], note2);
+    BOOST_CHECK_EQUAL(index.notes()[2], note3);
+    BOOST_CHECK_EQUAL(index.notes()[3], note4);
+    BOOST_CHECK_EQUAL(index.partIndices()[2], 0);
+    BOOST_CHECK_EQUAL(index.measureIndices()[2], 2);
+    BOOST_CHECK_EQUAL(index.partIndices()[3], 1);
+    BOOST_CHECK_EQUAL(index.measureIndices()[3], 0);
+    BOOST_CHECK_EQUAL(index.staves()[2], 2);
+    BOOST_CHECK_EQUAL(*index.voices()[1], "2");
+    BOOST_CHECK(index.voices()[0] != index.voices()[1]);
+    BOOST_CHECK_EQUAL(index.starts()[2], 4);
+    BOOST_CHECK_EQUAL(index.durations()[2], 3);
+
+    BOOST_REQUIRE_EQUAL(index.chordCount(), 3);
+    BOOST_CHECK_EQUAL(index.chords()[0], chord);
+    BOOST_CHECK_EQUAL(index.chordFirstNotes()[1], 2);
+    BOOST_CHECK_EQUAL(index.chordNoteCounts()[0], 2);
+    BOOST_CHECK_EQUAL(index.chordIndices()[1], 0);
+    BOOST_CHECK_EQUAL(index.chordIndices()[3], 2);
+}
+
+BOOST_AUTO_TEST_CASE(tieIndex) {
+    ScoreBuilder builder;
+    auto part1 = builder.addPart();
+    auto part2 = builder.addPart();
+
+    auto note1 = builder.addNote(builder.addMeasure(part1));
+    builder.setPitch(note1, dom::Pitch::Step::C, 4);
+    builder.addTie(note1, dom::kStart);
+    builder.addSlur(note1, dom::kStart);
+
+    auto note2 = builder.addNote(builder.addMeasure(part1));
+    builder.setPitch(note2, dom::Pitch::Step::C, 4);
+    builder.addTie(note2, dom::kStop);
+    builder.addTie(note2, dom::kStart);
+    builder.addSlur(note2, dom::kContinue);
+
+    auto note3 = builder.addNote(builder.addMeasure(part1));
+    builder.setPitch(note3, dom::Pitch::Step::C, 4);
+    builder.addTie(note3, dom::kStop);
+    builder.addSlur(note3, dom::kStop);
+
+    // Ties don't pair across parts
+    auto note4 = builder.addNote(builder.addMeasure(part2));
+    builder.setPitch(note4, dom::Pitch::Step::C, 4);
+    builder.addTie(note4, dom::kStop);
+
+    auto score = builder.build();
+    ScoreProperties properties(*score, ScoreProperties::LayoutType::Scroll);
+    auto& index = properties.tieIndex();
+
+    BOOST_REQUIRE_EQUAL(index.size(), 8);
+    BOOST_CHECK_EQUAL(index.notes()[4], note2);
+    BOOST_CHECK(index.kinds()[4] == TieIndex::Kind::Slur);
+    BOOST_CHECK(index.stops()[4] && index.starts()[4]);
+
+    BOOST_CHECK_EQUAL(index.partners()[0], TieIndex::kNone);
+    BOOST_CHECK_EQUAL(index.partners()[2], 0);
+    BOOST_CHECK_EQUAL(index.partners()[4], 1);
+    BOOST_CHECK_EQUAL(index.partners()[5], 3);
+    BOOST_CHECK_EQUAL(index.partners()[6], 4);
+    BOOST_CHECK_EQUAL(index.partners()[7], TieIndex::kNone);
+
+    BOOST_CHECK_EQUAL(index.nexts()[0], 2);
+    BOOST_CHECK_EQUAL(index.nexts()[1], 4);
+    BOOST_CHECK_EQUAL(index.nexts()[3], 5);
+    BOOST_CHECK_EQUAL(index.nexts()[4], 6);
+    BOOST_CHECK_EQUAL(index.nexts()[5], TieIndex::kNone);
+
+    BOOST_CHECK_EQUAL(index.range(0, 1, 3).first, 2);
+    BOOST_CHECK_EQUAL(index.range(0, 1, 3).second, 7);
+    BOOST_CHECK_EQUAL(index.range(0, 3, 4).first, 7);
+    BOOST_CHECK_EQUAL(index.range(0, 3, 4).second, 7);
+    BOOST_CHECK_EQUAL(index.range(1, 0, 1).first, 7);
+    BOOST_CHECK_EQUAL(index.range(1, 0, 1).second, 8);
+}
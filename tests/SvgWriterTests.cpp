@@ -0,0 +1,100 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <mxml/geometry/PageScoreGeometry.h>
+#include <mxml/geometry/ScrollScoreGeometry.h>
+#include <mxml/parsing/ParserContext.h>
+#include <mxml/SvgWriter.h>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+using namespace mxml;
+
+namespace {
+
+std::string readFile(const std::string& fileName) {
+    std::ifstream stream(fileName);
+    std::stringstream contents;
+    contents << stream.rdbuf();
+    return contents.str();
+}
+
+/// Groups every digit, so that numbers formatted through the stream would be easy to spot
+class GroupingPunctuation : public std::numpunct<char> {
+protected:
+    char do_thousands_sep() const {
+        return '\'';
+    }
+    std::string do_grouping() const {
+        return "\1";
+    }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(svgPageGolden) {
+    parsing::ParserContext context;
+    auto score = context.parseFile("repeats.xml");
+    PageScoreGeometry geometry(*score, 1024);
+
+    std::ostringstream stream;
+    SvgWriter writer(stream);
+    writer.writePage(geometry, 0);
+
+    BOOST_CHECK_EQUAL(stream.str(), readFile("repeats.page0.svg"));
+}
+
+BOOST_AUTO_TEST_CASE(svgPageWithBeamsAndTiesGolden) {
+    parsing::ParserContext context;
+    auto score = context.parseFile("moonlight.xml");
+    PageScoreGeometry geometry(*score, 1024);
+
+    std::ostringstream stream;
+    SvgWriter writer(stream);
+    writer.writePage(geometry, 0);
+
+    BOOST_CHECK_EQUAL(stream.str(), readFile("moonlight.page0.svg"));
+}
+
+BOOST_AUTO_TEST_CASE(svgScrollRangeGolden) {
+    parsing::ParserContext context;
+    auto score = context.parseFile("events_complex_2.xml");
+    ScrollScoreGeometry geometry(*score);
+
+    std::ostringstream stream;
+    SvgWriter writer(stream);
+    writer.writeRange(geometry, 0, 600);
+
+    BOOST_CHECK_EQUAL(stream.str(), readFile("events_complex_2.range0-600.svg"));
+}
+
+BOOST_AUTO_TEST_CASE(svgIgnoresLocale) {
+    parsing::ParserContext context;
+    auto score = context.parseFile("repeats.xml");
+    PageScoreGeometry geometry(*score, 1024);
+
+    std::ostringstream stream;
+    stream.imbue(std::locale(std::locale::classic(), new GroupingPunctuation()));
+    SvgWriter writer(stream);
+    writer.writePage(geometry, 0);
+
+    BOOST_CHECK_EQUAL(stream.str(), readFile("repeats.page0.svg"));
+}
+
+BOOST_AUTO_TEST_CASE(svgDeterministic) {
+    parsing::ParserContext context;
+    auto score = context.parseFile("events_complex_2.xml");
+
+    std::ostringstream first;
+    std::ostringstream second;
+    SvgWriter(first).writeRange(ScrollScoreGeometry(*score, true, 1), 0, 10000);
+    SvgWriter(second).writeRange(ScrollScoreGeometry(*score, true, 4), 0, 10000);
+    BOOST_CHECK_EQUAL(first.str(), second.str());
+    BOOST_CHECK(first.str().find("&#xE0A2;") != std::string::npos);
+}
@@ -0,0 +1,112 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <lxml/lxml.h>
+#include <mxml/parsing/ScoreHandler.h>
+#include <mxml/EventFactory.h>
+#include <mxml/ScoreBuilder.h>
+#include <mxml/TempoMap.h>
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace mxml;
+using namespace mxml::parsing;
+
+static const char* kMoonlightFileName = "moonlight.xml";
+static const char* kEventsRepeatFileName = "events_repeat.xml";
+
+BOOST_AUTO_TEST_CASE(tempoMapDefaultTempo) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+    auto measure = builder.addMeasure(part);
+    auto attributes = builder.addAttributes(measure);
+    attributes->setDivisions(dom::presentOptional(2));
+    auto time = builder.setTime(attributes);
+    time->setBeats(4);
+    time->setBeatType(4);
+    builder.addMeasure(part);
+
+    auto score = builder.build();
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Scroll);
+    TempoMap tempoMap(scoreProperties);
+
+    // 60 beats per minute, 2 divisions per beat
+    BOOST_CHECK_EQUAL(tempoMap.measures().size(), 2);
+    BOOST_CHECK_CLOSE(tempoMap.wallTime(8), 4.0, 0.0001);
+    BOOST_CHECK_CLOSE(tempoMap.absoluteTime(3.0), 6.0, 0.0001);
+
+    auto location = tempoMap.measureLocation(11);
+    BOOST_CHECK_EQUAL(location.measureIndex, 1);
+    BOOST_CHECK_EQUAL(location.division, 3);
+    BOOST_CHECK_EQUAL(tempoMap.absoluteTime(location), 11);
+}
+
+BOOST_AUTO_TEST_CASE(tempoMapMoonlight) {
+    ScoreHandler handler;
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+
+    EventFactory factory(score, scoreProperties);
+    auto events = factory.build();
+    auto& tempoMap = *events->tempoMap();
+
+    // The score has tempo changes, make sure they are in the map
+    BOOST_CHECK_GT(tempoMap.segments().size(), 1);
+
+    std::vector<dom::time_t> absoluteTimes;
+    for (auto& event : *events) {
+        BOOST_CHECK_CLOSE(tempoMap.wallTime(event.absoluteTime()), event.wallTime(), 0.0001);
+        BOOST_CHECK_CLOSE(tempoMap.absoluteTime(event.wallTime()), event.absoluteTime(), 0.0001);
+        BOOST_CHECK(tempoMap.measureLocation(event.absoluteTime()) == event.measureLocation());
+        absoluteTimes.push_back(event.absoluteTime());
+    }
+
+    std::vector<double> wallTimes(absoluteTimes.size());
+    tempoMap.wallTimes(absoluteTimes.begin(), absoluteTimes.end(), wallTimes.begin());
+
+    std::vector<double> roundTrip(wallTimes.size());
+    tempoMap.absoluteTimes(wallTimes.begin(), wallTimes.end(), roundTrip.begin());
+
+    std::vector<MeasureLocation> locations(absoluteTimes.size());
+    tempoMap.measureLocations(absoluteTimes.begin(), absoluteTimes.end(), locations.begin());
+
+    for (std::size_t i = 0; i < absoluteTimes.size(); i += 1) {
+        auto& event = events->events()[i];
+        BOOST_CHECK_CLOSE(wallTimes[i], event.wallTime(), 0.0001);
+        BOOST_CHECK_CLOSE(roundTrip[i], event.absoluteTime(), 0.0001);
+        BOOST_CHECK(locations[i] == event.measureLocation());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tempoMapRepeat) {
+    ScoreHandler handler;
+    std::ifstream is(kEventsRepeatFileName);
+    lxml::parse(is, kEventsRepeatFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+
+    EventFactory factory(score, scoreProperties);
+    auto events = factory.build();
+    auto& tempoMap = *events->tempoMap();
+
+    // Repeated measures are played twice, at different absolute times
+    BOOST_CHECK_EQUAL(tempoMap.occurrenceCount(0), 1);
+    BOOST_REQUIRE_EQUAL(tempoMap.occurrenceCount(1), 2);
+
+    MeasureLocation location;
+    location.measureIndex = 1;
+    auto first = tempoMap.absoluteTime(location, 0);
+    auto second = tempoMap.absoluteTime(location, 1);
+    BOOST_CHECK_LT(first, second);
+    BOOST_CHECK(tempoMap.measureLocation(first) == location);
+    BOOST_CHECK(tempoMap.measureLocation(second) == location);
+    BOOST_CHECK_THROW(tempoMap.absoluteTime(location, 2), std::out_of_range);
+}